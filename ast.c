@@ -0,0 +1,309 @@
+/**
+ * @file ast.c
+ * @brief Abstract syntax tree built by the parser's semantic actions.
+ *
+ * In AST mode the LL(1) driver expands productions from astRules[], which
+ * holds the semantic actions of grammer.txt in place. Matched tokens that
+ * carry information are pushed onto the semantic stack as leaves. When the
+ * driver pops an action, it folds the values its production pushed into one
+ * node. Punctuation, keywords and the eps, expPrime and more_ids chains of
+ * the concrete tree never become nodes.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ast.h"
+#include "grammarDef.h"
+
+#define AST_INITIAL_NODES 256   ///< Initial node capacity of an AST
+#define AST_INITIAL_VALUES 64   ///< Initial capacity of the children, tokens and semantic stack
+#define AST_MAX_INDENT 32       ///< Deeper nodes are indented this far and labelled with their depth
+
+/**
+ * @brief Creates an empty AST.
+ *
+ * @return Ast* The AST, released with destroyAst().
+ */
+Ast *createAst(void);
+
+/**
+ * @brief Destroys an AST with all of its nodes, child lists and tokens.
+ *
+ * @param ast The AST.
+ */
+void destroyAst(Ast *ast);
+
+/**
+ * @brief Tells whether a matched terminal becomes a leaf of the AST.
+ *
+ * Identifiers, numbers, type names and operators are kept; punctuation and
+ * keywords are implied by the kind of the node their production builds.
+ *
+ * @param terminal Grammar index of the terminal.
+ * @return true if the terminal is kept.
+ */
+bool astKeepsToken(int terminal);
+
+/**
+ * @brief Pushes a leaf for a matched input token onto the semantic stack.
+ *
+ * @param ast The AST being built.
+ * @param terminal Grammar index of the token's terminal.
+ * @param lexeme The token's lexeme.
+ * @param lineNo The token's line number.
+ */
+void astPushLeaf(Ast *ast, int terminal, LexemeId lexeme, int lineNo);
+
+/**
+ * @brief Runs a semantic action of astRules[].
+ *
+ * The values above mark, pushed by the action's production, are replaced
+ * by the node the action builds (see AST_NODE, AST_OPTIONAL, AST_FOLD).
+ *
+ * @param ast The AST being built.
+ * @param action AST_ACTION(kind, mode).
+ * @param mark Height of the semantic stack when the production was expanded.
+ */
+void astAction(Ast *ast, int action, uint32_t mark);
+
+/**
+ * @brief Returns the memory used by the nodes, child lists and tokens of an AST.
+ *
+ * @param ast The AST.
+ * @return size_t Bytes in use (not counting spare capacity).
+ */
+size_t astBytes(const Ast *ast);
+
+/**
+ * @brief Prints an AST as an indented outline, one node per line.
+ *
+ * Nodes deeper than AST_MAX_INDENT levels carry their depth in brackets.
+ *
+ * @param ast The AST.
+ * @param outfile Path of the output file; it is overwritten.
+ */
+void printAst(const Ast *ast, const char *outfile);
+
+static void *growArray(void *array, uint32_t *capacity, uint32_t needed, size_t size)
+{
+    if (needed <= *capacity)
+        return array;
+    uint32_t grown = *capacity * 2;
+    while (grown < needed)
+        grown *= 2;
+    array = realloc(array, (size_t)grown * size);
+    if (!array)
+    {
+        fprintf(stderr, "Error: Memory allocation failed for the AST.\n");
+        exit(EXIT_FAILURE);
+    }
+    *capacity = grown;
+    return array;
+}
+
+Ast *createAst(void)
+{
+    Ast *ast = (Ast *)calloc(1, sizeof(Ast));
+    if (!ast)
+    {
+        fprintf(stderr, "Error: Memory allocation failed for the AST.\n");
+        exit(EXIT_FAILURE);
+    }
+    ast->nodeCapacity = AST_INITIAL_NODES;
+    ast->childCapacity = AST_INITIAL_VALUES;
+    ast->tokenCapacity = AST_INITIAL_VALUES;
+    ast->valueCapacity = AST_INITIAL_VALUES;
+    ast->nodes = (AstNode *)malloc(ast->nodeCapacity * sizeof(AstNode));
+    ast->children = (uint32_t *)malloc(ast->childCapacity * sizeof(uint32_t));
+    ast->tokens = (TreeToken *)malloc(ast->tokenCapacity * sizeof(TreeToken));
+    ast->values = (uint32_t *)malloc(ast->valueCapacity * sizeof(uint32_t));
+    if (!ast->nodes || !ast->children || !ast->tokens || !ast->values)
+    {
+        fprintf(stderr, "Error: Memory allocation failed for the AST.\n");
+        exit(EXIT_FAILURE);
+    }
+    return ast;
+}
+
+void destroyAst(Ast *ast)
+{
+    if (!ast)
+        return;
+    free(ast->nodes);
+    free(ast->children);
+    free(ast->tokens);
+    free(ast->values);
+    free(ast);
+}
+
+bool astKeepsToken(int terminal)
+{
+    switch (terminal)
+    {
+    case SYM_TK_ID:
+    case SYM_TK_FIELDID:
+    case SYM_TK_FUNID:
+    case SYM_TK_RUID:
+    case SYM_TK_NUM:
+    case SYM_TK_RNUM:
+    case SYM_TK_INT:
+    case SYM_TK_REAL:
+    case SYM_TK_PLUS:
+    case SYM_TK_MINUS:
+    case SYM_TK_MUL:
+    case SYM_TK_DIV:
+    case SYM_TK_LT:
+    case SYM_TK_LE:
+    case SYM_TK_EQ:
+    case SYM_TK_GT:
+    case SYM_TK_GE:
+    case SYM_TK_NE:
+    case SYM_TK_AND:
+    case SYM_TK_OR:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static uint32_t addAstNode(Ast *ast, int kind, int symbol, uint32_t token)
+{
+    ast->nodes = (AstNode *)growArray(ast->nodes, &ast->nodeCapacity, ast->nodeCount + 1, sizeof(AstNode));
+    AstNode *node = &ast->nodes[ast->nodeCount];
+    node->kind = (uint8_t)kind;
+    node->symbol = (uint8_t)symbol;
+    node->numChildren = 0;
+    node->firstChild = 0;
+    node->token = token;
+    return ast->nodeCount++;
+}
+
+static void setAstChildren(Ast *ast, uint32_t node, const uint32_t *children, uint32_t count)
+{
+    ast->children = (uint32_t *)growArray(ast->children, &ast->childCapacity, ast->childCount + count, sizeof(uint32_t));
+    memcpy(ast->children + ast->childCount, children, count * sizeof(uint32_t));
+    ast->nodes[node].firstChild = ast->childCount;
+    ast->nodes[node].numChildren = (uint16_t)count;
+    ast->childCount += count;
+}
+
+static void pushAstValue(Ast *ast, uint32_t node)
+{
+    ast->values = (uint32_t *)growArray(ast->values, &ast->valueCapacity, ast->valueCount + 1, sizeof(uint32_t));
+    ast->values[ast->valueCount++] = node;
+}
+
+void astPushLeaf(Ast *ast, int terminal, LexemeId lexeme, int lineNo)
+{
+    ast->tokens = (TreeToken *)growArray(ast->tokens, &ast->tokenCapacity, ast->tokenCount + 1, sizeof(TreeToken));
+    ast->tokens[ast->tokenCount].lexeme = lexeme;
+    ast->tokens[ast->tokenCount].lineNo = lineNo;
+    pushAstValue(ast, addAstNode(ast, AST_Leaf, terminal, ast->tokenCount++));
+}
+
+void astAction(Ast *ast, int action, uint32_t mark)
+{
+    int kind = (action - AST_ACTION_BASE) / 4;
+    int mode = (action - AST_ACTION_BASE) % 4;
+    // Error recovery may have dropped values; never reach below the mark
+    if (mark > ast->valueCount)
+        mark = ast->valueCount;
+    uint32_t count = ast->valueCount - mark;
+
+    if (mode == AST_OPTIONAL && count == 1)
+        return;
+    if (mode == AST_FOLD)
+    {
+        if (count == 0)
+            return;
+        // operand op operand op operand: each operator leaf becomes the node
+        // over the result so far and the next operand
+        uint32_t left = ast->values[mark];
+        for (uint32_t i = mark + 1; i + 1 < ast->valueCount; i += 2)
+        {
+            uint32_t op = ast->values[i];
+            uint32_t pair[2] = {left, ast->values[i + 1]};
+            ast->nodes[op].kind = (uint8_t)kind;
+            setAstChildren(ast, op, pair, 2);
+            left = op;
+        }
+        ast->valueCount = mark;
+        pushAstValue(ast, left);
+        return;
+    }
+
+    uint32_t node = addAstNode(ast, kind, 0, AST_NO_TOKEN);
+    setAstChildren(ast, node, ast->values + mark, count);
+    ast->valueCount = mark;
+    pushAstValue(ast, node);
+}
+
+size_t astBytes(const Ast *ast)
+{
+    return ast->nodeCount * sizeof(AstNode) + ast->childCount * sizeof(uint32_t) +
+           ast->tokenCount * sizeof(TreeToken);
+}
+
+static void printAstNode(const Ast *ast, uint32_t n, int depth, FILE *out)
+{
+    const AstNode *node = &ast->nodes[n];
+    // A long operator chain nests as deep as it is long; keep lines linear in size
+    if (depth > AST_MAX_INDENT)
+        fprintf(out, "%*s[%d] ", 2 * AST_MAX_INDENT, "", depth);
+    else
+        fprintf(out, "%*s", 2 * depth, "");
+    fprintf(out, "%s", node->kind == AST_Leaf ? grammarTerms[node->symbol] : astKindNames[node->kind]);
+    if (node->kind != AST_Leaf && node->symbol != 0)
+        fprintf(out, " %s", grammarTerms[node->symbol]);
+    if (node->token != AST_NO_TOKEN)
+    {
+        const TreeToken *token = &ast->tokens[node->token];
+        fprintf(out, " %s (line %d)", lexemeText(token->lexeme), token->lineNo);
+    }
+    fputc('\n', out);
+}
+
+void printAst(const Ast *ast, const char *outfile)
+{
+    FILE *out = fopen(outfile, "w");
+    if (out == NULL)
+    {
+        perror(outfile);
+        exit(EXIT_FAILURE);
+    }
+
+    // Explicit stack of (node, depth) pairs, children pushed right to left
+    uint32_t capacity = 256, depth = 0;
+    uint32_t *stack = (uint32_t *)malloc(capacity * 2 * sizeof(uint32_t));
+    if (!stack)
+    {
+        fprintf(stderr, "Error: Memory allocation failed for the AST.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (uint32_t v = ast->valueCount; v-- > 0;)
+    {
+        if (depth == capacity)
+            stack = (uint32_t *)growArray(stack, &capacity, capacity + 1, 2 * sizeof(uint32_t));
+        stack[2 * depth] = ast->values[v];
+        stack[2 * depth + 1] = 0;
+        depth++;
+    }
+    while (depth > 0)
+    {
+        depth--;
+        uint32_t n = stack[2 * depth], level = stack[2 * depth + 1];
+        const AstNode *node = &ast->nodes[n];
+        printAstNode(ast, n, (int)level, out);
+
+        stack = (uint32_t *)growArray(stack, &capacity, depth + node->numChildren, 2 * sizeof(uint32_t));
+        for (int i = node->numChildren - 1; i >= 0; i--)
+        {
+            stack[2 * depth] = ast->children[node->firstChild + i];
+            stack[2 * depth + 1] = level + 1;
+            depth++;
+        }
+    }
+    free(stack);
+    fclose(out);
+}
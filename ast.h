@@ -0,0 +1,58 @@
+#ifndef COMPILER_AST_H
+#define COMPILER_AST_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "lexer.h"
+#include "tree.h"
+
+#define AST_NO_TOKEN UINT32_MAX  // token of a node that stands for no single input token
+
+/*
+ * One abstract-syntax node, 12 bytes. The kind is an enum AstKind value
+ * from grammarDef.h, named by the @actions in grammer.txt; AST_Leaf nodes
+ * are the input tokens that carry information (identifiers, numbers, type
+ * names and operators). Operator nodes (BinOp, RelOp, BoolOp) keep their
+ * operator token. The children of a node are one run of Ast.children.
+ */
+typedef struct {
+    uint8_t kind;          // enum AstKind
+    uint8_t symbol;        // Terminal of a leaf or operator node, 0 otherwise
+    uint16_t numChildren;
+    uint32_t firstChild;   // Index of the first child in Ast.children
+    uint32_t token;        // Index into Ast.tokens, AST_NO_TOKEN if none
+} AstNode;
+
+_Static_assert(sizeof(AstNode) == 12, "AstNode is expected to stay 12 bytes");
+
+/*
+ * Storage of one AST. While the parser runs, values is the semantic stack:
+ * the nodes built so far that no action has claimed yet. Once the parse is
+ * over it holds the top-level nodes, normally just the Program node.
+ */
+typedef struct Ast {
+    AstNode *nodes;
+    uint32_t nodeCount;
+    uint32_t nodeCapacity;
+    uint32_t *children;     // Child lists, one contiguous run per node
+    uint32_t childCount;
+    uint32_t childCapacity;
+    TreeToken *tokens;
+    uint32_t tokenCount;
+    uint32_t tokenCapacity;
+    uint32_t *values;       // Semantic stack
+    uint32_t valueCount;
+    uint32_t valueCapacity;
+} Ast;
+
+Ast *createAst(void);
+void destroyAst(Ast *ast);
+
+bool astKeepsToken(int terminal);
+void astPushLeaf(Ast *ast, int terminal, LexemeId lexeme, int lineNo);
+void astAction(Ast *ast, int action, uint32_t mark);
+size_t astBytes(const Ast *ast);
+void printAst(const Ast *ast, const char *outfile);
+
+#endif /* COMPILER_AST_H */
@@ -0,0 +1,591 @@
+/**
+ * @file document.c
+ * @brief Incremental reparsing of a source file held in memory.
+ *
+ * An edit replaces a byte range of the source. The lexer restarts at the end
+ * of the last token the edit cannot have changed and runs only until one of
+ * its tokens starts where an old token did, past the edit: from there on the
+ * old tokens are still right, only moved. The changed tokens are then
+ * reparsed under the innermost statement, declaration, type definition or
+ * function that covers them (reparseSubtree() checks that the new parse ends
+ * exactly where the old one did) and the new subtree is spliced into the
+ * tree in place of the old one. Anything else, including every edit of a
+ * document with errors, reparses the whole document, so the tree is always
+ * the one a full parse of the current text would build. As in a full parse,
+ * lexical errors are skipped: a document with lexical errors but correct
+ * syntax is not valid, yet its tree is complete (syntaxCorrect).
+ *
+ * Nothing after the edit is visited: the text and the tokens are gap buffers
+ * whose gaps move to the edit, and the tokens after the token gap count their
+ * offsets and lines back from the end of the text.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "document.h"
+#include "parser.h"
+#include "parserDef.h"
+#include "stack.h"
+
+#define RELEX_LOOKBEHIND 3      ///< Characters the lexer may read past the end of a token before retracting
+#define DOC_INITIAL_TOKENS 256  ///< Initial token capacity of a document
+#define DOC_TEXT_GAP 4096       ///< Free bytes kept in the text gap when it is grown
+
+/**
+ * @brief Reads a source file into a new document and parses it.
+ *
+ * Diagnostics of the parse go to the parser messages (see setParserMessages()).
+ *
+ * @param path The source file.
+ * @return Document* The document, released with closeDocument().
+ */
+Document *openDocument(const char *path);
+
+/**
+ * @brief Frees a document with its source, tokens and parse tree.
+ *
+ * @param doc The document.
+ */
+void closeDocument(Document *doc);
+
+/**
+ * @brief Replaces the bytes [start, end) of a document's source and updates its parse tree.
+ *
+ * @param doc The document.
+ * @param start First byte replaced.
+ * @param end One past the last byte replaced.
+ * @param text The replacement.
+ * @param length Length of the replacement.
+ * @param edit Filled with what the edit cost.
+ * @return int 1 if the document is free of errors after the edit, 0 if it is not,
+ *         -1 if the range lies outside the source (nothing is changed).
+ */
+int editDocument(Document *doc, uint32_t start, uint32_t end, const char *text, uint32_t length, DocumentEdit *edit);
+
+/**
+ * @brief Returns the source of a document as one contiguous run of doc->length bytes.
+ *
+ * @param doc The document.
+ * @return const char* The source, valid until the next edit (not NUL-terminated).
+ */
+const char *documentText(Document *doc);
+
+/**
+ * @brief Returns the parse tree of a document, with every token line absolute.
+ *
+ * @param doc The document.
+ * @return ParseTree* The tree, valid until the next edit.
+ */
+ParseTree *documentTree(Document *doc);
+
+
+static void *growDocArray(void *array, uint32_t capacity, size_t size)
+{
+    array = realloc(array, (size_t)capacity * size);
+    if (!array)
+    {
+        fprintf(stderr, "Error: Memory allocation failed for the document.\n");
+        exit(EXIT_FAILURE);
+    }
+    return array;
+}
+
+// Moves the text gap to logical offset pos
+static void moveTextGap(Document *doc, uint32_t pos)
+{
+    if (pos < doc->textGap)
+    {
+        uint32_t n = doc->textGap - pos;
+        memmove(doc->text + doc->textGapEnd - n, doc->text + pos, n);
+        doc->textGap -= n;
+        doc->textGapEnd -= n;
+    }
+    else if (pos > doc->textGap)
+    {
+        uint32_t n = pos - doc->textGap;
+        memmove(doc->text + doc->textGap, doc->text + doc->textGapEnd, n);
+        doc->textGap += n;
+        doc->textGapEnd += n;
+    }
+}
+
+// Makes the text gap at least size bytes long
+static void reserveText(Document *doc, uint32_t size)
+{
+    if (doc->textGapEnd - doc->textGap >= size)
+        return;
+    uint32_t tail = doc->textCapacity - doc->textGapEnd;
+    uint32_t capacity = doc->length + size + doc->length / 8 + DOC_TEXT_GAP;
+    doc->text = (char *)growDocArray(doc->text, capacity, 1);
+    memmove(doc->text + capacity - tail, doc->text + doc->textGapEnd, tail);
+    doc->textGapEnd = capacity - tail;
+    doc->textCapacity = capacity;
+}
+
+static uint32_t countLines(const char *text, uint32_t length)
+{
+    uint32_t lines = 0;
+    for (const char *p = text; (p = memchr(p, '\n', text + length - p)) != NULL; p++)
+        lines++;
+    return lines;
+}
+
+// Replaces the bytes [start, end) of the source, leaving the gap after the replacement
+static void spliceText(Document *doc, uint32_t start, uint32_t end, const char *text, uint32_t length)
+{
+    moveTextGap(doc, start);
+    uint32_t removed = end - start;
+    doc->lines -= countLines(doc->text + doc->textGapEnd, removed);
+    doc->textGapEnd += removed;
+    reserveText(doc, length);
+    memcpy(doc->text + doc->textGap, text, length);
+    doc->textGap += length;
+    doc->lines += countLines(text, length);
+    doc->length = doc->length - removed + length;
+}
+
+const char *documentText(Document *doc)
+{
+    moveTextGap(doc, doc->length);
+    return doc->text;
+}
+
+// Lexer over the source from byte from on, which starts a token on line lineNo
+static Lexer *openTextLexer(Document *doc, uint32_t from, int lineNo)
+{
+    if (from >= doc->length)
+        return NULL;
+    moveTextGap(doc, from);
+    FILE *fp = fmemopen(doc->text + doc->textGapEnd, doc->length - from, "r");
+    if (!fp)
+    {
+        perror("fmemopen");
+        exit(EXIT_FAILURE);
+    }
+    Lexer *L = createLexer(fp);
+    L->ownsSource = 1;
+    L->lineNo = lineNo;
+    return L;
+}
+
+static inline uint32_t tokenSlot(const Document *doc, uint32_t i)
+{
+    return i < doc->tokenGap ? i : i + (doc->tokenGapEnd - doc->tokenGap);
+}
+
+static inline uint32_t slotToken(const Document *doc, uint32_t slot)
+{
+    return slot < doc->tokenGap ? slot : slot - (doc->tokenGapEnd - doc->tokenGap);
+}
+
+static inline uint32_t tokenOffset(const Document *doc, uint32_t i)
+{
+    uint32_t slot = tokenSlot(doc, i);
+    return slot < doc->tokenGap ? doc->tokenStart[slot] : doc->tokenStart[slot] + doc->length;
+}
+
+static inline uint32_t tokenEnd(const Document *doc, uint32_t i)
+{
+    return tokenOffset(doc, i) + doc->tokenLength[tokenSlot(doc, i)];
+}
+
+static inline int tokenLineNo(const Document *doc, uint32_t i)
+{
+    uint32_t slot = tokenSlot(doc, i);
+    int lineNo = doc->tree->tokens[slot].lineNo;
+    return slot < doc->tokenGap ? lineNo : lineNo + (int)doc->lines;
+}
+
+// Moves a token to another slot, counting its offset and line from the front (sign 1) or the end (-1)
+static void moveToken(Document *doc, uint32_t from, uint32_t to, int sign)
+{
+    ParseTree *tree = doc->tree;
+    doc->tokenStart[to] = doc->tokenStart[from] + (uint32_t)sign * doc->length;
+    doc->tokenLength[to] = doc->tokenLength[from];
+    doc->terminal[to] = doc->terminal[from];
+    doc->tokenNode[to] = doc->tokenNode[from];
+    tree->tokens[to].lexeme = tree->tokens[from].lexeme;
+    tree->tokens[to].lineNo = tree->tokens[from].lineNo + sign * (int)doc->lines;
+    if (doc->tokenNode[to] != TREE_NO_NODE)
+        tree->nodes[doc->tokenNode[to]].token = to;
+}
+
+// Moves the token gap in front of token i
+static void moveTokenGap(Document *doc, uint32_t i)
+{
+    while (doc->tokenGap > i)
+        moveToken(doc, --doc->tokenGap, --doc->tokenGapEnd, -1);
+    while (doc->tokenGap < i)
+        moveToken(doc, doc->tokenGapEnd++, doc->tokenGap++, 1);
+}
+
+// Grows the token arrays of the document and its tree to capacity slots; the tokens after the gap move to the end
+static void growTokens(Document *doc, uint32_t capacity)
+{
+    ParseTree *tree = doc->tree;
+    uint32_t tail = doc->tokenCapacity - doc->tokenGapEnd;
+    uint32_t from = doc->tokenGapEnd, to = capacity - tail;
+    doc->tokenStart = (uint32_t *)growDocArray(doc->tokenStart, capacity, sizeof(uint32_t));
+    doc->tokenLength = (uint32_t *)growDocArray(doc->tokenLength, capacity, sizeof(uint32_t));
+    doc->terminal = (uint8_t *)growDocArray(doc->terminal, capacity, sizeof(uint8_t));
+    doc->tokenNode = (uint32_t *)growDocArray(doc->tokenNode, capacity, sizeof(uint32_t));
+    tree->tokens = (TreeToken *)growDocArray(tree->tokens, capacity, sizeof(TreeToken));
+    memmove(doc->tokenStart + to, doc->tokenStart + from, tail * sizeof(uint32_t));
+    memmove(doc->tokenLength + to, doc->tokenLength + from, tail * sizeof(uint32_t));
+    memmove(doc->terminal + to, doc->terminal + from, tail * sizeof(uint8_t));
+    memmove(doc->tokenNode + to, doc->tokenNode + from, tail * sizeof(uint32_t));
+    memmove(tree->tokens + to, tree->tokens + from, tail * sizeof(TreeToken));
+    for (uint32_t slot = to; slot < capacity && to != from; slot++)
+        if (doc->tokenNode[slot] != TREE_NO_NODE)
+            tree->nodes[doc->tokenNode[slot]].token = slot;
+    doc->tokenGapEnd = to;
+    doc->tokenCapacity = tree->tokenCapacity = capacity;
+}
+
+ParseTree *documentTree(Document *doc)
+{
+    // An invalid document keeps the tokens as its last full parse stored them
+    if (doc->valid)
+    {
+        moveTokenGap(doc, doc->tokenCount);
+        doc->tree->tokenCount = doc->tokenCount;
+    }
+    return doc->tree;
+}
+
+// Points every token at the terminal node that matched it, for the nodes under root
+static uint32_t mapSubtree(Document *doc, uint32_t root)
+{
+    const ParseTree *tree = doc->tree;
+    Stack s;
+    createStack(&s, 64);
+    pushStack(&s, root);
+    uint32_t count = 0, n;
+    while (topStack(&s, &n))
+    {
+        popStack(&s);
+        count++;
+        const TreeNode *node = &tree->nodes[n];
+        if (node->token != TREE_NO_TOKEN)
+            doc->tokenNode[node->token] = n;
+        for (int i = 0; i < node->numChildren; i++)
+            pushStack(&s, node->firstChild + i);
+    }
+    deleteStack(&s);
+    return count;
+}
+
+// Number of nodes under root, root included
+static uint32_t subtreeSize(const ParseTree *tree, uint32_t root)
+{
+    Stack s;
+    createStack(&s, 64);
+    pushStack(&s, root);
+    uint32_t count = 0, n;
+    while (topStack(&s, &n))
+    {
+        popStack(&s);
+        count++;
+        for (int i = 0; i < tree->nodes[n].numChildren; i++)
+            pushStack(&s, tree->nodes[n].firstChild + i);
+    }
+    deleteStack(&s);
+    return count;
+}
+
+// Slot of the first (or last) token matched under root, UINT32_MAX if it matched none
+static uint32_t subtreeToken(const ParseTree *tree, uint32_t root, bool last)
+{
+    Stack s;
+    createStack(&s, 64);
+    pushStack(&s, root);
+    uint32_t token = UINT32_MAX, n;
+    while (token == UINT32_MAX && topStack(&s, &n))
+    {
+        popStack(&s);
+        const TreeNode *node = &tree->nodes[n];
+        token = node->token != TREE_NO_TOKEN ? node->token : UINT32_MAX;
+        // Push so that the child to visit next (leftmost, or rightmost for last) is on top
+        for (int i = 0; i < node->numChildren; i++)
+            pushStack(&s, node->firstChild + (last ? i : node->numChildren - 1 - i));
+    }
+    deleteStack(&s);
+    return token;
+}
+
+// Lexes and parses the whole source again; the token gap ends up after the last token
+static void parseDocument(Document *doc)
+{
+    destroyParseTree(doc->tree);
+    doc->tree = createParseTree();
+    doc->tokenCount = doc->tokenGap = 0;
+    doc->tokenGapEnd = doc->tokenCapacity;
+    doc->valid = true;
+    doc->syntaxCorrect = true;
+
+    TokenStream *tokens = createTokenStream(DOC_INITIAL_TOKENS);
+    Lexer *L = openTextLexer(doc, 0, 1);
+    Token t;
+    while (L && readToken(L, &t))
+    {
+        pushToken(tokens, &t);
+        if (t.cat != NORMAL)
+            doc->valid = false;
+        else if (t.type != TK_COMMENT)
+        {
+            uint32_t i = doc->tokenCount++;
+            if (i == doc->tokenCapacity)
+            {
+                doc->tokenStart = (uint32_t *)growDocArray(doc->tokenStart, 2 * i, sizeof(uint32_t));
+                doc->tokenLength = (uint32_t *)growDocArray(doc->tokenLength, 2 * i, sizeof(uint32_t));
+                doc->terminal = (uint8_t *)growDocArray(doc->terminal, 2 * i, sizeof(uint8_t));
+                doc->tokenCapacity = 2 * i;
+            }
+            doc->tokenStart[i] = (uint32_t)t.start;
+            doc->tokenLength[i] = (uint32_t)t.length;
+            doc->terminal[i] = (uint8_t)tokenTerminal[t.type];
+        }
+    }
+    destroyLexer(L);
+    if (!parseTokenStream(tokens, doc->tree))
+        doc->valid = doc->syntaxCorrect = false;
+    destroyTokenStream(tokens);
+
+    // A clean parse matched every token, in order; the parser ignores tokens after the program's end
+    ParseTree *tree = doc->tree;
+    if (tree->tokenCount != doc->tokenCount)
+        doc->valid = false;
+    uint32_t capacity = doc->tokenCapacity > tree->tokenCapacity ? doc->tokenCapacity : tree->tokenCapacity;
+    doc->tokenGap = doc->tokenGapEnd = doc->tokenCapacity;
+    growTokens(doc, capacity);
+    doc->tokenGap = doc->tokenCount;
+    for (uint32_t i = 0; i < doc->tokenCount; i++)
+        doc->tokenNode[i] = TREE_NO_NODE;
+    doc->liveNodes = tree->nodeCount;
+    if (doc->valid)
+        mapSubtree(doc, 0);
+}
+
+Document *openDocument(const char *path)
+{
+    FILE *fp = fopen(path, "rb");
+    if (!fp)
+    {
+        perror(path);
+        exit(EXIT_FAILURE);
+    }
+    Document *doc = (Document *)calloc(1, sizeof(Document));
+    if (!doc)
+    {
+        fprintf(stderr, "Error: Memory allocation failed for the document.\n");
+        exit(EXIT_FAILURE);
+    }
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    if (size < 0 || size > (long)UINT32_MAX / 2)
+    {
+        fprintf(stderr, "%s: cannot be edited in memory\n", path);
+        exit(EXIT_FAILURE);
+    }
+    doc->textCapacity = (uint32_t)size + DOC_TEXT_GAP;
+    doc->text = (char *)growDocArray(NULL, doc->textCapacity, 1);
+    doc->length = doc->textGap = (uint32_t)fread(doc->text, 1, (size_t)size, fp);
+    doc->textGapEnd = doc->textCapacity;
+    doc->lines = countLines(doc->text, doc->length);
+    fclose(fp);
+
+    doc->tokenCapacity = DOC_INITIAL_TOKENS;
+    doc->tokenStart = (uint32_t *)growDocArray(NULL, doc->tokenCapacity, sizeof(uint32_t));
+    doc->tokenLength = (uint32_t *)growDocArray(NULL, doc->tokenCapacity, sizeof(uint32_t));
+    doc->terminal = (uint8_t *)growDocArray(NULL, doc->tokenCapacity, sizeof(uint8_t));
+    doc->tokenNode = (uint32_t *)growDocArray(NULL, doc->tokenCapacity, sizeof(uint32_t));
+    doc->tree = createParseTree();
+    parseDocument(doc);
+    return doc;
+}
+
+void closeDocument(Document *doc)
+{
+    if (!doc)
+        return;
+    destroyParseTree(doc->tree);
+    free(doc->text);
+    free(doc->tokenStart);
+    free(doc->tokenLength);
+    free(doc->terminal);
+    free(doc->tokenNode);
+    free(doc);
+}
+
+// Replaces the tokens [a, j) that follow the token gap by the relexed window
+static void spliceTokens(Document *doc, uint32_t a, uint32_t j, const TokenStream *window)
+{
+    ParseTree *tree = doc->tree;
+    uint32_t m = (uint32_t)window->size;
+    doc->tokenGapEnd += j - a;
+    if (doc->tokenGapEnd - doc->tokenGap < m)
+        growTokens(doc, 2 * doc->tokenCapacity + m);
+
+    Token t;
+    for (uint32_t i = 0; i < m; i++)
+    {
+        uint32_t slot = doc->tokenGap++;
+        tokenAt(window, i, &t);
+        doc->tokenStart[slot] = (uint32_t)t.start;
+        doc->tokenLength[slot] = (uint32_t)t.length;
+        doc->terminal[slot] = (uint8_t)tokenTerminal[t.type];
+        doc->tokenNode[slot] = TREE_NO_NODE;
+        tree->tokens[slot].lexeme = t.lexeme;
+        tree->tokens[slot].lineNo = t.lineNo;
+    }
+    doc->tokenCount = doc->tokenCount - (j - a) + m;
+}
+
+static bool isReparseRoot(int symbol)
+{
+    return symbol == SYM_stmt || symbol == SYM_declaration || symbol == SYM_typeDefinition ||
+           symbol == SYM_function || symbol == SYM_mainFunction;
+}
+
+int editDocument(Document *doc, uint32_t start, uint32_t end, const char *text, uint32_t length, DocumentEdit *edit)
+{
+    memset(edit, 0, sizeof(*edit));
+    edit->symbol = -1;
+    if (start > end || end > doc->length)
+        return -1;
+    if (!doc->valid)
+    {
+        spliceText(doc, start, end, text, length);
+        parseDocument(doc);
+        edit->full = true;
+        return doc->valid;
+    }
+
+    // Tokens from a on may read the edited bytes; lexing restarts where token a - 1 ended
+    uint32_t lo = 0, hi = doc->tokenCount;
+    while (lo < hi)
+    {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (tokenEnd(doc, mid) + RELEX_LOOKBEHIND > start)
+            hi = mid;
+        else
+            lo = mid + 1;
+    }
+    uint32_t a = lo;
+    uint32_t from = a > 0 ? tokenEnd(doc, a - 1) : 0;
+    int lineNo = a > 0 ? tokenLineNo(doc, a - 1) : 1;
+
+    // With the gap in front of token a, the tokens from a on move with the end of the text
+    moveTokenGap(doc, a);
+    spliceText(doc, start, end, text, length);
+
+    // Relex until a token starts where an old one now does, past the edit; old tokens [a, j) are replaced
+    TokenStream *window = createTokenStream(16);
+    Lexer *L = openTextLexer(doc, from, lineNo);
+    uint32_t j = a;
+    bool resynced = false, lexError = false;
+    Token t;
+    while (L && readToken(L, &t))
+    {
+        t.start += from;
+        if (t.cat != NORMAL)
+        {
+            lexError = true;
+            break;
+        }
+        if (t.type == TK_COMMENT)
+            continue;
+        if (t.start >= (long)start + length)
+        {
+            while (j < doc->tokenCount && tokenOffset(doc, j) < t.start)
+                j++;
+            if (j < doc->tokenCount && tokenOffset(doc, j) == t.start)
+            {
+                resynced = true;
+                break;
+            }
+        }
+        pushToken(window, &t);
+    }
+    destroyLexer(L);
+    if (!resynced)
+        j = doc->tokenCount;
+    edit->relexed = (uint32_t)window->size;
+    edit->replaced = j - a;
+
+    // Same terminal at a: every parse decision taken on it still holds, so subtrees starting at a may be reparsed
+    uint32_t m = (uint32_t)window->size;
+    bool sameFirst = m > 0 && j > a && doc->terminal[tokenSlot(doc, a)] == tokenTerminal[window->type[0]];
+    uint32_t anchor = sameFirst ? a : a - 1;
+
+    // Innermost candidates first, with their token spans before the edit
+    enum { MAX_CANDIDATES = 64 };
+    uint32_t candidate[MAX_CANDIDATES], firstToken[MAX_CANDIDATES], endToken[MAX_CANDIDATES];
+    int candidates = 0;
+    bool unchanged = m == 0 && j == a;
+    if (!lexError && !unchanged && (sameFirst || a > 0))
+    {
+        const ParseTree *tree = doc->tree;
+        for (uint32_t n = doc->tokenNode[tokenSlot(doc, anchor)]; n != TREE_NO_NODE && candidates < MAX_CANDIDATES; n = tree->nodes[n].parent)
+        {
+            int symbol = tree->nodes[n].symbolID;
+            if (!isReparseRoot(symbol))
+                continue;
+            uint32_t last = slotToken(doc, subtreeToken(tree, n, true));
+            if (last + 1 >= j)
+            {
+                candidate[candidates] = n;
+                firstToken[candidates] = slotToken(doc, subtreeToken(tree, n, false));
+                endToken[candidates] = last + 1;
+                candidates++;
+            }
+            // Functions are not nested; nothing above one can be reparsed alone
+            if (symbol == SYM_function || symbol == SYM_mainFunction)
+                break;
+        }
+    }
+
+    if (lexError)
+    {
+        destroyTokenStream(window);
+        parseDocument(doc);
+        edit->full = true;
+        return doc->valid;
+    }
+    spliceTokens(doc, a, j, window);
+    destroyTokenStream(window);
+    if (unchanged)
+        return 1;
+
+    int64_t shift = (int64_t)m - (j - a);
+    ParseTree *tree = doc->tree;
+    for (int c = 0; c < candidates; c++)
+    {
+        // The candidate's tokens, in front of the gap, sit in slots equal to their indices
+        uint32_t node = candidate[c], before = tree->nodeCount;
+        uint32_t tokenEndNew = (uint32_t)(endToken[c] + shift);
+        moveTokenGap(doc, tokenEndNew);
+        int follow = tokenEndNew < doc->tokenCount ? doc->terminal[tokenSlot(doc, tokenEndNew)] : 0;
+        uint32_t oldSize = subtreeSize(tree, node);
+        if (!reparseSubtree(tree, node, doc->terminal, firstToken[c], tokenEndNew, follow))
+            continue;
+        uint32_t newSize = mapSubtree(doc, node);
+        edit->symbol = tree->nodes[node].symbolID;
+        edit->nodes = tree->nodeCount - before;
+        doc->liveNodes = doc->liveNodes - oldSize + newSize;
+
+        // Replaced subtrees pile up at the front of the node array; drop them once they outnumber the live nodes
+        if (tree->nodeCount > 2 * doc->liveNodes)
+        {
+            doc->liveNodes = compactParseTree(tree);
+            mapSubtree(doc, 0);
+        }
+        return 1;
+    }
+
+    parseDocument(doc);
+    edit->full = true;
+    return doc->valid;
+}
@@ -0,0 +1,57 @@
+#ifndef COMPILER_DOCUMENT_H
+#define COMPILER_DOCUMENT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "lexer.h"
+#include "tree.h"
+
+/*
+ * A source file kept in memory together with its tokens and parse tree, so
+ * that an edit relexes and reparses only the part of the file it changes.
+ *
+ * The text and the tokens are gap buffers: an edit moves the gap to where it
+ * happens, so its cost depends on the distance to the previous edit, not on
+ * the size of the file. Token slots are shared with tree->tokens and are what
+ * terminal nodes refer to. The offset and line of a token after the gap are
+ * kept relative to the end of the text, which is why an edit never has to
+ * visit the tokens that follow it. Comments and lexical errors are not tokens
+ * of a document.
+ */
+typedef struct {
+    char *text;             // Source: text[0, textGap) then text[textGapEnd, textCapacity)
+    uint32_t length;        // Source length
+    uint32_t lines;         // Newlines in the source
+    uint32_t textGap;
+    uint32_t textGapEnd;
+    uint32_t textCapacity;
+    ParseTree *tree;
+    uint32_t *tokenStart;   // Source offset of the token in each slot
+    uint32_t *tokenLength;  // Lexeme length of the token in each slot
+    uint8_t *terminal;      // Grammar terminal of the token in each slot
+    uint32_t *tokenNode;    // Terminal node that matched the token in each slot
+    uint32_t tokenCount;
+    uint32_t tokenGap;      // Slots [tokenGap, tokenGapEnd) hold no token
+    uint32_t tokenGapEnd;
+    uint32_t tokenCapacity;
+    uint32_t liveNodes;     // Nodes reachable from the root; the others were replaced
+    bool valid;             // Free of lexical and syntax errors; edits of an invalid document reparse it whole
+    bool syntaxCorrect;     // Free of syntax errors, lexical errors skipped: the tree is what a full parse prints
+} Document;
+
+/* What one edit cost */
+typedef struct {
+    uint32_t relexed;       // Tokens lexed again
+    uint32_t replaced;      // Old tokens they replaced
+    int symbol;             // Root symbol of the reparsed subtree, -1 if nothing was reparsed
+    uint32_t nodes;         // Nodes built by the reparse
+    bool full;              // The whole document was parsed again
+} DocumentEdit;
+
+Document *openDocument(const char *path);
+void closeDocument(Document *doc);
+int editDocument(Document *doc, uint32_t start, uint32_t end, const char *text, uint32_t length, DocumentEdit *edit);
+const char *documentText(Document *doc);
+ParseTree *documentTree(Document *doc);
+
+#endif /* COMPILER_DOCUMENT_H */
@@ -9,9 +9,42 @@
  * - Printing tokens from the input file.
  * - Parsing the input file.
  * - Measuring the time taken for lexing and parsing.
+ * - Building the abstract syntax tree of the input file.
  * 
  * 
  * The program will prompt the user to enter a command to perform the desired task.
+ * With --stream as third argument, parsing pulls tokens from the lexer on demand
+ * instead of lexing the whole input first, and the parse tree is printed and
+ * freed as it is built, so memory stays flat; the AST command still keeps its
+ * whole tree. Timing (command 4) runs the parse
+ * --repeat N times, 1 by default, and reports the wall and CPU time of every
+ * phase as min / median / max over the runs; it always lexes before parsing.
+ *
+ * With --batch it runs one action over many files without prompting:
+ *   stage1exe --batch <clean|tokens|parse|time|ast> [--stream] [--jobs N] [--repeat N]
+ *             [--out-dir DIR] [--manifest FILE] [input files...]
+ * Each input gets its own outputs, DIR/<name>.clean.txt, DIR/<name>.tokens.txt,
+ * DIR/<name>.tree.txt or DIR/<name>.ast.txt plus the parse log DIR/<name>.log; DIR is
+ * created if it does not exist. A manifest lists
+ * one input per line, optionally followed by its output path (the parse log
+ * then goes to <output>.log); blank lines and lines starting with # are skipped.
+ * --jobs N lexes and parses N files at a time on worker threads that share the
+ * read-only grammar and parse table; each file's messages are printed as one block.
+ * The time action reports the phases of every file over --repeat N runs.
+ *
+ * With --edit it replays an edit script against one file, as an editor would:
+ *   stage1exe --edit <input_file> <output_file> <edit_script>
+ * Each script line "<start> <end> <text>" replaces the bytes [start, end) of the
+ * current text by text, in which \n, \t and \\ are escapes. Every edit relexes
+ * and reparses only what it changed (see document.c); the parse tree after the
+ * last edit is written to output_file when it is syntactically correct, lexical
+ * errors skipped, as a full parse would.
+ *
+ * With --serve it becomes a compile server on a Unix domain socket:
+ *   stage1exe --serve <socket_path> [--jobs N]
+ * Clients send sources and get back their diagnostics and, on request, the
+ * token listing or parse tree (protocol in server.h); N connections are
+ * served at a time. tools/compileclient is a client for scripts and builds.
  * 
  * @param argc The number of command-line arguments.
  * @param argv The array of command-line arguments.
@@ -21,22 +54,541 @@
 #include "lexer.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
+#include <pthread.h>
+#include <sys/stat.h>
 #include "parser.h"
+#include "document.h"
+#include "server.h"
 
+#define BATCH_PATH_MAX 4096
+
+typedef enum
+{
+    BATCH_CLEAN,
+    BATCH_TOKENS,
+    BATCH_PARSE,
+    BATCH_TIME,
+    BATCH_AST
+} BatchAction;
+
+static const char *batchActionNames[] = {"clean", "tokens", "parse", "time", "ast"};
+static const char *batchSuffix[] = {".clean.txt", ".tokens.txt", ".tree.txt", ".tree.txt", ".ast.txt"};
+
+/**
+ * @brief Builds DIR/<name><suffix> from an input path, <name> being its file name without extension.
+ */
+static void batchOutputPath(char *dst, const char *outDir, const char *input, const char *suffix)
+{
+    const char *name = strrchr(input, '/');
+    name = name ? name + 1 : input;
+    const char *dot = strrchr(name, '.');
+    int len = dot && dot != name ? (int)(dot - name) : (int)strlen(name);
+    snprintf(dst, BATCH_PATH_MAX, "%s/%.*s%s", outDir, len, name, suffix);
+}
+
+/* One input of a batch and its output path (NULL to derive it from the input) */
+typedef struct
+{
+    char *input;
+    char *output;
+} BatchJob;
+
+/* Work shared by the batch workers; next and failed are guarded by lock */
+typedef struct
+{
+    BatchJob *jobs;
+    int count;
+    int next;
+    int failed;
+    BatchAction action;
+    const char *outDir;
+    bool streaming;
+    int repeat;
+    pthread_mutex_t lock;
+} BatchQueue;
+
+static int compareSeconds(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Times the phases of parsing one file over several runs and prints min / median / max.
+ *
+ * Only the first run's parser messages are shown; the later runs write the
+ * same outputs again.
+ *
+ * @param tableFiles Also write and time the FIRST/FOLLOW and parse table files.
+ * @param msg Where the messages and the report go.
+ * @return bool true if the code is syntactically correct.
+ */
+static bool timeFile(char *testfile, char *outfile, const char *logPath, bool tableFiles, int repeat, FILE *msg)
+{
+    static const char *phaseNames[PHASE_COUNT] = {"table files", "lexing", "parsing", "parse log", "tree printing"};
+    PhaseTimes *runs = (PhaseTimes *)malloc(repeat * sizeof(PhaseTimes));
+    double *wall = (double *)malloc(repeat * sizeof(double));
+    double *cpu = (double *)malloc(repeat * sizeof(double));
+    FILE *quiet = fopen("/dev/null", "w");
+    if (!runs || !wall || !cpu || !quiet)
+    {
+        fprintf(stderr, "Could not set up the timing runs\n");
+        exit(EXIT_FAILURE);
+    }
+    bool correct = true;
+    for (int r = 0; r < repeat; r++)
+    {
+        setParserMessages(r == 0 ? msg : quiet);
+        correct = timeParsePhases(testfile, outfile, logPath, tableFiles, &runs[r]);
+    }
+    setParserMessages(msg);
+    fclose(quiet);
+
+    fprintf(msg, "Phase times for %s: %ld bytes, %u tokens, %d run%s (ms)\n", testfile, runs[0].bytes, runs[0].tokens, repeat, repeat == 1 ? "" : "s");
+    fprintf(msg, "  %-20s %10s %10s %10s %10s %10s %10s\n", "phase", "wall min", "median", "max", "cpu min", "median", "max");
+    fprintf(msg, "  %-20s %s\n", "grammar and tables", "built by tools/grammargen, none at run time");
+    double lexWall = 0, parseWall = 0;
+    for (int p = 0; p <= PHASE_COUNT; p++)
+    {
+        if (p == PHASE_TABLE_FILES && !tableFiles)
+            continue;
+        for (int r = 0; r < repeat; r++)
+        {
+            wall[r] = cpu[r] = 0;
+            for (int q = p < PHASE_COUNT ? p : 0; q < (p < PHASE_COUNT ? p + 1 : PHASE_COUNT); q++)
+            {
+                wall[r] += runs[r].wall[q];
+                cpu[r] += runs[r].cpu[q];
+            }
+        }
+        qsort(wall, repeat, sizeof(double), compareSeconds);
+        qsort(cpu, repeat, sizeof(double), compareSeconds);
+        fprintf(msg, "  %-20s %10.3f %10.3f %10.3f %10.3f %10.3f %10.3f\n", p < PHASE_COUNT ? phaseNames[p] : "total",
+                wall[0] * 1e3, wall[repeat / 2] * 1e3, wall[repeat - 1] * 1e3, cpu[0] * 1e3, cpu[repeat / 2] * 1e3, cpu[repeat - 1] * 1e3);
+        if (p == PHASE_LEX)
+            lexWall = wall[repeat / 2];
+        else if (p == PHASE_PARSE)
+            parseWall = wall[repeat / 2];
+    }
+    // Throughput from the median wall times
+    if (lexWall > 0 && parseWall > 0)
+        fprintf(msg, "  lexing %.2f MB/s, %.2f M tokens/s; parsing %.2f MB/s, %.2f M tokens/s\n\n",
+                runs[0].bytes / lexWall / 1e6, runs[0].tokens / lexWall / 1e6, runs[0].bytes / parseWall / 1e6, runs[0].tokens / parseWall / 1e6);
+    else
+        fprintf(msg, "\n");
+    free(runs);
+    free(wall);
+    free(cpu);
+    return correct;
+}
+
+/**
+ * @brief Runs the action on one input.
+ *
+ * @param msg Where the progress and diagnostic messages for this file go.
+ * @return int 0 if the file was processed cleanly, 1 if it could not be read or has errors.
+ */
+static int batchFile(const BatchQueue *Q, const BatchJob *job, FILE *msg)
+{
+    char outPath[BATCH_PATH_MAX], logPath[BATCH_PATH_MAX];
+    if (job->output)
+    {
+        snprintf(outPath, sizeof(outPath), "%s", job->output);
+        snprintf(logPath, sizeof(logPath), "%s.log", job->output);
+    }
+    else
+    {
+        batchOutputPath(outPath, Q->outDir, job->input, batchSuffix[Q->action]);
+        batchOutputPath(logPath, Q->outDir, job->input, ".log");
+    }
+
+    // The lexer exits on a missing file; skip it here so the rest of the batch still runs
+    FILE *probe = fopen(job->input, "r");
+    if (!probe)
+    {
+        perror(job->input);
+        return 1;
+    }
+    fclose(probe);
+
+    fprintf(msg, "==> %s <==\n", job->input);
+    setParserMessages(msg);
+    switch (Q->action)
+    {
+    case BATCH_CLEAN:
+        removeComments(job->input, outPath);
+        fprintf(msg, "[INFO] Comments removed successfully and have been written to %s\n", outPath);
+        return 0;
+    case BATCH_TOKENS:
+    {
+        FILE *out = fopen(outPath, "w");
+        if (!out)
+        {
+            perror(outPath);
+            return 1;
+        }
+        driverToken(job->input, out);
+        fclose(out);
+        fprintf(msg, "[INFO] Tokens have been written to %s\n", outPath);
+        return 0;
+    }
+    case BATCH_PARSE:
+        return parseFile(job->input, outPath, logPath, Q->streaming) ? 0 : 1;
+    case BATCH_TIME:
+        // The table files are written once for the batch; CPU times are per thread, so they hold with --jobs too
+        return timeFile(job->input, outPath, logPath, false, Q->repeat, msg) ? 0 : 1;
+    case BATCH_AST:
+        return astFile(job->input, outPath, logPath, Q->streaming) ? 0 : 1;
+    }
+    return 1;
+}
+
+/**
+ * @brief Worker thread: takes files off the queue until it is empty.
+ *
+ * Messages for a file are collected in memory and printed in one piece, so
+ * the output of files parsed side by side does not interleave.
+ */
+static void *batchWorker(void *arg)
+{
+    BatchQueue *Q = (BatchQueue *)arg;
+    while (1)
+    {
+        pthread_mutex_lock(&Q->lock);
+        int i = Q->next++;
+        pthread_mutex_unlock(&Q->lock);
+        if (i >= Q->count)
+            break;
+
+        char *text = NULL;
+        size_t length = 0;
+        FILE *msg = open_memstream(&text, &length);
+        if (!msg)
+        {
+            fprintf(stderr, "Memory allocation failed in batchWorker\n");
+            exit(EXIT_FAILURE);
+        }
+        int failed = batchFile(Q, &Q->jobs[i], msg);
+        setParserMessages(NULL);
+        fclose(msg);
+
+        pthread_mutex_lock(&Q->lock);
+        fwrite(text, 1, length, stdout);
+        Q->failed += failed;
+        pthread_mutex_unlock(&Q->lock);
+        free(text);
+    }
+
+    releaseParserTrace();
+    releaseLexemePool();
+    return NULL;
+}
+
+/**
+ * @brief Appends the inputs listed in a manifest to the job list.
+ *
+ * @return int 1 on success, 0 if the manifest could not be read.
+ */
+static int readManifest(const char *manifest, BatchJob **jobs, int *count, int *capacity)
+{
+    FILE *fp = fopen(manifest, "r");
+    if (!fp)
+    {
+        perror(manifest);
+        return 0;
+    }
+    char line[2 * BATCH_PATH_MAX];
+    while (fgets(line, sizeof(line), fp))
+    {
+        char input[BATCH_PATH_MAX], output[BATCH_PATH_MAX];
+        int n = sscanf(line, "%4095s %4095s", input, output);
+        if (n < 1 || input[0] == '#')
+            continue;
+        if (*count == *capacity)
+        {
+            *capacity *= 2;
+            *jobs = (BatchJob *)realloc(*jobs, *capacity * sizeof(BatchJob));
+            if (!*jobs)
+            {
+                fprintf(stderr, "Memory allocation failed in readManifest\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+        (*jobs)[*count].input = strdup(input);
+        (*jobs)[*count].output = n == 2 ? strdup(output) : NULL;
+        (*count)++;
+    }
+    fclose(fp);
+    return 1;
+}
+
+/**
+ * @brief Runs one action over every file named on the command line or in a manifest.
+ *
+ * The grammar tables are static (grammarDef.h), so the FIRST/FOLLOW and parse
+ * table files are written once and every file is processed in this process,
+ * by --jobs worker threads when more than one is asked for.
+ *
+ * @return int EXIT_SUCCESS if every file was processed without errors.
+ */
+static int runBatch(int argc, char **argv)
+{
+    if (argc < 1)
+    {
+        fprintf(stderr, "Usage: stage1exe --batch <clean|tokens|parse|time|ast> [--stream] [--jobs N] [--repeat N] [--out-dir DIR] [--manifest FILE] [input files...]\n");
+        return EXIT_FAILURE;
+    }
+
+    BatchQueue Q = {0};
+    int action = -1;
+    for (int i = 0; i <= BATCH_AST; i++)
+    {
+        if (strcmp(argv[0], batchActionNames[i]) == 0)
+            action = i;
+    }
+    if (action < 0)
+    {
+        fprintf(stderr, "Unknown batch action \"%s\", expected clean, tokens, parse, time or ast\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    Q.action = (BatchAction)action;
+    Q.outDir = ".";
+    Q.repeat = 1;
+
+    int workers = 1;
+    const char *manifest = NULL;
+    int firstInput = argc;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--stream") == 0)
+            Q.streaming = true;
+        else if (strcmp(argv[i], "--jobs") == 0 && i + 1 < argc)
+            workers = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--repeat") == 0 && i + 1 < argc)
+            Q.repeat = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--out-dir") == 0 && i + 1 < argc)
+            Q.outDir = argv[++i];
+        else if (strcmp(argv[i], "--manifest") == 0 && i + 1 < argc)
+            manifest = argv[++i];
+        else
+        {
+            firstInput = i;
+            break;
+        }
+    }
+    if (workers < 1)
+        workers = 1;
+    if (Q.repeat < 1)
+        Q.repeat = 1;
+    // removeComments() echoes every file to stdout as it goes, which would interleave
+    if (Q.action == BATCH_CLEAN)
+        workers = 1;
+
+    int capacity = argc - firstInput + 16;
+    Q.jobs = (BatchJob *)malloc(capacity * sizeof(BatchJob));
+    if (!Q.jobs)
+    {
+        fprintf(stderr, "Memory allocation failed in runBatch\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = firstInput; i < argc; i++)
+    {
+        Q.jobs[Q.count].input = strdup(argv[i]);
+        Q.jobs[Q.count].output = NULL;
+        Q.count++;
+    }
+    if (manifest && !readManifest(manifest, &Q.jobs, &Q.count, &capacity))
+        return EXIT_FAILURE;
+    if (Q.count == 0)
+    {
+        fprintf(stderr, "No input files given\n");
+        return EXIT_FAILURE;
+    }
+    // Checked once here rather than failing on every file
+    struct stat st;
+    if (stat(Q.outDir, &st) != 0 && mkdir(Q.outDir, 0755) != 0)
+    {
+        perror(Q.outDir);
+        return EXIT_FAILURE;
+    }
+    if (stat(Q.outDir, &st) == 0 && !S_ISDIR(st.st_mode))
+    {
+        fprintf(stderr, "%s is not a directory\n", Q.outDir);
+        return EXIT_FAILURE;
+    }
+
+    if (Q.action == BATCH_PARSE || Q.action == BATCH_TIME || Q.action == BATCH_AST)
+        printGrammarTables();
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if (workers == 1)
+    {
+        for (int i = 0; i < Q.count; i++)
+            Q.failed += batchFile(&Q, &Q.jobs[i], stdout);
+        setParserMessages(NULL);
+    }
+    else
+    {
+        if (workers > Q.count)
+            workers = Q.count;
+        pthread_mutex_init(&Q.lock, NULL);
+        pthread_t *threads = (pthread_t *)malloc(workers * sizeof(pthread_t));
+        if (!threads)
+        {
+            fprintf(stderr, "Memory allocation failed in runBatch\n");
+            exit(EXIT_FAILURE);
+        }
+        for (int i = 0; i < workers; i++)
+        {
+            if (pthread_create(&threads[i], NULL, batchWorker, &Q) != 0)
+            {
+                fprintf(stderr, "Could not start batch worker %d\n", i);
+                exit(EXIT_FAILURE);
+            }
+        }
+        for (int i = 0; i < workers; i++)
+            pthread_join(threads[i], NULL);
+        free(threads);
+        pthread_mutex_destroy(&Q.lock);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    printf("[INFO] %s: %d files processed by %d worker%s, %d with errors\n", batchActionNames[Q.action], Q.count, workers, workers == 1 ? "" : "s", Q.failed);
+    if (Q.action == BATCH_TIME)
+        printf("Total wall time in seconds for all files: %f\n", (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9);
+
+    for (int i = 0; i < Q.count; i++)
+    {
+        free(Q.jobs[i].input);
+        free(Q.jobs[i].output);
+    }
+    free(Q.jobs);
+    return Q.failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+// Decodes \n, \t and \\ in place and returns the decoded length
+static uint32_t unescapeEdit(char *text)
+{
+    char *out = text;
+    for (char *p = text; *p; p++)
+    {
+        if (*p == '\\' && (p[1] == 'n' || p[1] == 't' || p[1] == '\\'))
+        {
+            p++;
+            *out++ = *p == 'n' ? '\n' : *p == 't' ? '\t' : '\\';
+        }
+        else
+            *out++ = *p;
+    }
+    *out = '\0';
+    return (uint32_t)(out - text);
+}
+
+/**
+ * @brief Applies the edits of a script one by one to an incrementally parsed file.
+ *
+ * @return int EXIT_SUCCESS if the text is syntactically correct after the last edit.
+ */
+static int runEdits(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "Usage: stage1exe --edit <input_file> <output_file> <edit_script>\n");
+        return EXIT_FAILURE;
+    }
+    FILE *script = fopen(argv[2], "r");
+    if (!script)
+    {
+        perror(argv[2]);
+        return EXIT_FAILURE;
+    }
+
+    Document *doc = openDocument(argv[0]);
+    printf("[INFO] %s: %u tokens, %u parse tree nodes\n", argv[0], doc->tokenCount, doc->liveNodes);
+
+    char *line = NULL;
+    size_t size = 0;
+    ssize_t read;
+    int edits = 0;
+    while ((read = getline(&line, &size, script)) != -1)
+    {
+        if (read > 0 && line[read - 1] == '\n')
+            line[--read] = '\0';
+        unsigned start, end;
+        int skip = 0;
+        if (line[0] == '#' || sscanf(line, "%u %u%n", &start, &end, &skip) != 2)
+            continue;
+        char *text = line + skip + (line[skip] == ' ');
+        uint32_t length = unescapeEdit(text);
+
+        struct timespec t0, t1;
+        DocumentEdit edit;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        int result = editDocument(doc, start, end, text, length, &edit);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        double us = (t1.tv_sec - t0.tv_sec) * 1e6 + (t1.tv_nsec - t0.tv_nsec) / 1e3;
+        edits++;
+
+        if (result < 0)
+            printf("[INFO] Edit %d: range %u-%u is outside the %u byte text, skipped\n", edits, start, end, doc->length);
+        else if (edit.full)
+            printf("[INFO] Edit %d: whole text reparsed in %.1f us%s\n", edits, us, result ? "" : ", it has errors");
+        else if (edit.symbol < 0)
+            printf("[INFO] Edit %d: relexed %u tokens for %u, no reparse needed, %.1f us\n", edits, edit.relexed, edit.replaced, us);
+        else
+            printf("[INFO] Edit %d: relexed %u tokens for %u, reparsed <%s> (%u nodes), %.1f us\n", edits, edit.relexed, edit.replaced, grammarTerms[edit.symbol], edit.nodes, us);
+    }
+    free(line);
+    fclose(script);
+
+    // Lexical errors are skipped as in a full parse; only syntax errors withhold the tree
+    bool correct = doc->syntaxCorrect;
+    if (correct)
+    {
+        printParseTree(documentTree(doc), argv[1]);
+        printf("[INFO] Code is syntactically correct so parse tree is generated successfully in %s ...\n", argv[1]);
+    }
+    else
+        printf("[INFO] Code is syntactically incorrect so the parse tree is not printed\n");
+    closeDocument(doc);
+    return correct ? EXIT_SUCCESS : EXIT_FAILURE;
+}
 
 int main(int argc, char **argv)
 {
+    if (argc > 1 && strcmp(argv[1], "--batch") == 0)
+        return runBatch(argc - 2, argv + 2);
+    if (argc > 1 && strcmp(argv[1], "--edit") == 0)
+        return runEdits(argc - 2, argv + 2);
+    if (argc > 2 && strcmp(argv[1], "--serve") == 0)
+        return runServer(argv[2], argc > 4 && strcmp(argv[3], "--jobs") == 0 ? atoi(argv[4]) : 1);
     if (argc < 2)
     {
-        fprintf(stderr, "Usage: %s <input_file> <ouput_file>\n", argv[0]);
+        fprintf(stderr, "Usage: %s <input_file> <ouput_file> [--stream] [--repeat N]\n", argv[0]);
+        fprintf(stderr, "       %s --batch <clean|tokens|parse|time|ast> [--stream] [--jobs N] [--repeat N] [--out-dir DIR] [--manifest FILE] [input files...]\n", argv[0]);
+        fprintf(stderr, "       %s --edit <input_file> <output_file> <edit_script>\n", argv[0]);
+        fprintf(stderr, "       %s --serve <socket_path> [--jobs N]\n", argv[0]);
         return EXIT_FAILURE;
     }
+    bool streaming = false;
+    int repeat = 1;
+    for (int i = 3; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--stream") == 0)
+            streaming = true;
+        else if (strcmp(argv[i], "--repeat") == 0 && i + 1 < argc)
+            repeat = atoi(argv[++i]);
+    }
+    if (repeat < 1)
+        repeat = 1;
 
     while (1)
     {
         int input;
-        printf("Enter 0 to exit, 1 to remove comments, 2 to print tokens, 3 to get parse, 4 to get time\n");
+        printf("Enter 0 to exit, 1 to remove comments, 2 to print tokens, 3 to get parse, 4 to get time, 5 to get AST\n");
         scanf("%d", &input);
 
         switch (input)
@@ -52,28 +604,18 @@ int main(int argc, char **argv)
             break;
         case 2:
             //FOR GETTING THE OUPTUT OF tokens
-            driverToken(argv[1],1);
+            driverToken(argv[1],stdout);
             break;
         case 3:
-            parser_main(argv[1],argv[2]);
+            parser_main(argv[1],argv[2],streaming);
             break;
         case 4:
-        {
-            clock_t start_time, end_time;
-            double total_CPU_time, total_CPU_time_in_seconds;
-            start_time = clock();
-            parser_main(argv[1], argv[2]);
-            end_time = clock();
-
-            total_CPU_time = (double)(end_time - start_time);
-            total_CPU_time_in_seconds = total_CPU_time / CLOCKS_PER_SEC;
-
-            // Print both total_CPU_time and total_CPU_time_in_seconds
-            printf("\nTotal CPU time for Lexer and Parser is: %f\n", total_CPU_time);
-            printf("Total CPU time in seconds for Lexer and Parser: %f\n", total_CPU_time_in_seconds);
-            printf("Clocks per second of processor: %f\n\n", CLOCKS_PER_SEC);
-        }
-        break;
+            timeFile(argv[1], argv[2], "parser_output.txt", true, repeat, stdout);
+            break;
+        case 5:
+            printGrammarTables();
+            astFile(argv[1], argv[2], "parser_output.txt", streaming);
+            break;
 
         default:
             printf("Exit program\n");
@@ -0,0 +1,566 @@
+/* Generated by tools/grammargen from grammer.txt -- do not edit by hand. */
+
+#ifndef GRAMMARDEF_H
+#define GRAMMARDEF_H
+
+#include "parserDef.h"
+
+#define GRAMMAR_SIZE 94
+
+/* Productions: lhs, rhs symbols, -1 */
+static const int grammarRules[GRAMMAR_SIZE][PRODUCTION_WIDTH] = {
+    {57, 58, 59, -1}, /* 1: <program> ===> <otherFunctions> <mainFunction> @Program */
+    {59, 1, 68, 2, -1}, /* 2: <mainFunction> ===> TK_MAIN <stmts> TK_END @Main */
+    {58, 60, 58, -1}, /* 3: <otherFunctions> ===> <function> <otherFunctions> */
+    {58, 110, -1}, /* 4: <otherFunctions> ===> <eps> */
+    {60, 3, 61, 62, 4, 68, 2, -1}, /* 5: <function> ===> TK_FUNID <input_par> <output_par> TK_SEM <stmts> TK_END @Function */
+    {61, 5, 6, 7, 8, 63, 9, -1}, /* 6: <input_par> ===> TK_INPUT TK_PARAMETER TK_LIST TK_SQL <parameter_list> TK_SQR @InputParams */
+    {62, 10, 6, 7, 8, 63, 9, -1}, /* 7: <output_par> ===> TK_OUTPUT TK_PARAMETER TK_LIST TK_SQL <parameter_list> TK_SQR @OutputParams */
+    {62, 110, -1}, /* 8: <output_par> ===> <eps> */
+    {63, 64, 56, 67, -1}, /* 9: <parameter_list> ===> <dataType> TK_ID @Param <remaining_list> */
+    {64, 65, -1}, /* 10: <dataType> ===> <primitiveDataType> */
+    {64, 66, -1}, /* 11: <dataType> ===> <constructedDataType> */
+    {65, 11, -1}, /* 12: <primitiveDataType> ===> TK_INT */
+    {65, 12, -1}, /* 13: <primitiveDataType> ===> TK_REAL */
+    {66, 109, 13, -1}, /* 14: <constructedDataType> ===> <A> TK_RUID @TypeName */
+    {66, 13, -1}, /* 15: <constructedDataType> ===> TK_RUID @TypeName */
+    {67, 14, 63, -1}, /* 16: <remaining_list> ===> TK_COMMA <parameter_list> */
+    {67, 110, -1}, /* 17: <remaining_list> ===> <eps> */
+    {68, 69, 76, 79, 104, -1}, /* 18: <stmts> ===> <typeDefinitions> <declarations> <otherStmts> <returnStmt> @Stmts */
+    {69, 70, 69, -1}, /* 19: <typeDefinitions> ===> <actualOrRedefined> <typeDefinitions> */
+    {69, 110, -1}, /* 20: <typeDefinitions> ===> <eps> */
+    {70, 71, -1}, /* 21: <actualOrRedefined> ===> <typeDefinition> */
+    {70, 108, -1}, /* 22: <actualOrRedefined> ===> <definetypestmt> */
+    {71, 15, 13, 72, 16, -1}, /* 23: <typeDefinition> ===> TK_RECORD TK_RUID <fieldDefinitions> TK_ENDRECORD @RecordDef */
+    {71, 17, 13, 72, 18, -1}, /* 24: <typeDefinition> ===> TK_UNION TK_RUID <fieldDefinitions> TK_ENDUNION @UnionDef */
+    {72, 73, 73, 75, -1}, /* 25: <fieldDefinitions> ===> <fieldDefinition> <fieldDefinition> <moreFields> */
+    {73, 19, 74, 20, 21, 4, -1}, /* 26: <fieldDefinition> ===> TK_TYPE <fieldType> TK_COLON TK_FIELDID TK_SEM @FieldDef */
+    {74, 65, -1}, /* 27: <fieldType> ===> <primitiveDataType> */
+    {74, 66, -1}, /* 28: <fieldType> ===> <constructedDataType> */
+    {75, 73, 75, -1}, /* 29: <moreFields> ===> <fieldDefinition> <moreFields> */
+    {75, 110, -1}, /* 30: <moreFields> ===> <eps> */
+    {76, 77, 76, -1}, /* 31: <declarations> ===> <declaration> <declarations> */
+    {76, 110, -1}, /* 32: <declarations> ===> <eps> */
+    {77, 19, 64, 20, 56, 78, 4, -1}, /* 33: <declaration> ===> TK_TYPE <dataType> TK_COLON TK_ID <global_or_not> TK_SEM @Decl */
+    {78, 20, 22, -1}, /* 34: <global_or_not> ===> TK_COLON TK_GLOBAL @Global */
+    {78, 110, -1}, /* 35: <global_or_not> ===> <eps> */
+    {79, 80, 79, -1}, /* 36: <otherStmts> ===> <stmt> <otherStmts> */
+    {79, 110, -1}, /* 37: <otherStmts> ===> <eps> */
+    {80, 81, -1}, /* 38: <stmt> ===> <assignmentStmt> */
+    {80, 89, -1}, /* 39: <stmt> ===> <iterativeStmt> */
+    {80, 90, -1}, /* 40: <stmt> ===> <conditionalStmt> */
+    {80, 92, -1}, /* 41: <stmt> ===> <ioStmt> */
+    {80, 86, -1}, /* 42: <stmt> ===> <funCallStmt> */
+    {81, 82, 23, 93, 4, -1}, /* 43: <assignmentStmt> ===> <SingleOrRecId> TK_ASSIGNOP <arithmeticExpression> TK_SEM @Assign */
+    {82, 56, 83, -1}, /* 44: <SingleOrRecId> ===> TK_ID <option_single_constructed> @RecordField? */
+    {83, 84, 85, -1}, /* 45: <option_single_constructed> ===> <oneExpansion> <moreExpansions> */
+    {83, 110, -1}, /* 46: <option_single_constructed> ===> <eps> */
+    {85, 84, 85, -1}, /* 47: <moreExpansions> ===> <oneExpansion> <moreExpansions> */
+    {85, 110, -1}, /* 48: <moreExpansions> ===> <eps> */
+    {84, 49, 21, -1}, /* 49: <oneExpansion> ===> TK_DOT TK_FIELDID */
+    {86, 87, 50, 3, 51, 52, 88, 4, -1}, /* 50: <funCallStmt> ===> <outputParameters> TK_CALL TK_FUNID TK_WITH TK_PARAMETERS <inputParameters> TK_SEM @Call */
+    {87, 8, 106, 9, 23, -1}, /* 51: <outputParameters> ===> TK_SQL <idList> TK_SQR TK_ASSIGNOP @OutputArgs */
+    {87, 110, -1}, /* 52: <outputParameters> ===> <eps> */
+    {88, 8, 106, 9, -1}, /* 53: <inputParameters> ===> TK_SQL <idList> TK_SQR @InputArgs */
+    {89, 24, 25, 100, 26, 80, 79, 55, -1}, /* 54: <iterativeStmt> ===> TK_WHILE TK_OP <booleanExpression> TK_CL <stmt> <otherStmts> TK_ENDWHILE @While */
+    {90, 27, 25, 100, 26, 28, 80, 79, 91, -1}, /* 55: <conditionalStmt> ===> TK_IF TK_OP <booleanExpression> TK_CL TK_THEN <stmt> <otherStmts> <elsePart> @If */
+    {91, 29, 80, 79, 30, -1}, /* 56: <elsePart> ===> TK_ELSE <stmt> <otherStmts> TK_ENDIF @Else */
+    {91, 30, -1}, /* 57: <elsePart> ===> TK_ENDIF */
+    {92, 31, 25, 101, 26, 4, -1}, /* 58: <ioStmt> ===> TK_READ TK_OP <var> TK_CL TK_SEM @Read */
+    {92, 32, 25, 101, 26, 4, -1}, /* 59: <ioStmt> ===> TK_WRITE TK_OP <var> TK_CL TK_SEM @Write */
+    {93, 95, 94, -1}, /* 60: <arithmeticExpression> ===> <term> <expPrime> @BinOp^ */
+    {94, 98, 95, 94, -1}, /* 61: <expPrime> ===> <lowPrecedenceOp> <term> <expPrime> */
+    {94, 110, -1}, /* 62: <expPrime> ===> <eps> */
+    {95, 97, 96, -1}, /* 63: <term> ===> <factor> <termPrime> @BinOp^ */
+    {96, 99, 97, 96, -1}, /* 64: <termPrime> ===> <highPrecedenceOp> <factor> <termPrime> */
+    {96, 110, -1}, /* 65: <termPrime> ===> <eps> */
+    {97, 25, 93, 26, -1}, /* 66: <factor> ===> TK_OP <arithmeticExpression> TK_CL */
+    {97, 101, -1}, /* 67: <factor> ===> <var> */
+    {98, 33, -1}, /* 68: <lowPrecedenceOp> ===> TK_PLUS */
+    {98, 34, -1}, /* 69: <lowPrecedenceOp> ===> TK_MINUS */
+    {99, 35, -1}, /* 70: <highPrecedenceOp> ===> TK_MUL */
+    {99, 36, -1}, /* 71: <highPrecedenceOp> ===> TK_DIV */
+    {100, 25, 100, 26, 102, 25, 100, 26, -1}, /* 72: <booleanExpression> ===> TK_OP <booleanExpression> TK_CL <logicalOp> TK_OP <booleanExpression> TK_CL @BoolOp^ */
+    {100, 101, 103, 101, -1}, /* 73: <booleanExpression> ===> <var> <relationalOp> <var> @RelOp^ */
+    {100, 37, 25, 100, 26, -1}, /* 74: <booleanExpression> ===> TK_NOT TK_OP <booleanExpression> TK_CL @Not */
+    {101, 82, -1}, /* 75: <var> ===> <SingleOrRecId> */
+    {101, 53, -1}, /* 76: <var> ===> TK_NUM */
+    {101, 54, -1}, /* 77: <var> ===> TK_RNUM */
+    {102, 38, -1}, /* 78: <logicalOp> ===> TK_AND */
+    {102, 39, -1}, /* 79: <logicalOp> ===> TK_OR */
+    {103, 40, -1}, /* 80: <relationalOp> ===> TK_LT */
+    {103, 41, -1}, /* 81: <relationalOp> ===> TK_LE */
+    {103, 42, -1}, /* 82: <relationalOp> ===> TK_EQ */
+    {103, 43, -1}, /* 83: <relationalOp> ===> TK_GT */
+    {103, 44, -1}, /* 84: <relationalOp> ===> TK_GE */
+    {103, 45, -1}, /* 85: <relationalOp> ===> TK_NE */
+    {104, 46, 105, 4, -1}, /* 86: <returnStmt> ===> TK_RETURN <optionalReturn> TK_SEM @Return */
+    {105, 8, 106, 9, -1}, /* 87: <optionalReturn> ===> TK_SQL <idList> TK_SQR */
+    {105, 110, -1}, /* 88: <optionalReturn> ===> <eps> */
+    {106, 56, 107, -1}, /* 89: <idList> ===> TK_ID <more_ids> */
+    {107, 14, 106, -1}, /* 90: <more_ids> ===> TK_COMMA <idList> */
+    {107, 110, -1}, /* 91: <more_ids> ===> <eps> */
+    {108, 47, 109, 13, 48, 13, -1}, /* 92: <definetypestmt> ===> TK_DEFINETYPE <A> TK_RUID TK_AS TK_RUID @DefineType */
+    {109, 15, -1}, /* 93: <A> ===> TK_RECORD @Record */
+    {109, 17, -1}, /* 94: <A> ===> TK_UNION @Union */
+};
+
+/* AST node kinds, named by the @actions in grammer.txt; AST_Leaf is an input token */
+enum AstKind
+{
+    AST_Leaf,
+    AST_Program,
+    AST_Main,
+    AST_Function,
+    AST_InputParams,
+    AST_OutputParams,
+    AST_Param,
+    AST_TypeName,
+    AST_Stmts,
+    AST_RecordDef,
+    AST_UnionDef,
+    AST_FieldDef,
+    AST_Decl,
+    AST_Global,
+    AST_Assign,
+    AST_RecordField,
+    AST_Call,
+    AST_OutputArgs,
+    AST_InputArgs,
+    AST_While,
+    AST_If,
+    AST_Else,
+    AST_Read,
+    AST_Write,
+    AST_BinOp,
+    AST_BoolOp,
+    AST_RelOp,
+    AST_Not,
+    AST_Return,
+    AST_DefineType,
+    AST_Record,
+    AST_Union,
+    AST_KIND_COUNT
+};
+
+static const char *const astKindNames[AST_KIND_COUNT] = {
+    "Leaf",
+    "Program",
+    "Main",
+    "Function",
+    "InputParams",
+    "OutputParams",
+    "Param",
+    "TypeName",
+    "Stmts",
+    "RecordDef",
+    "UnionDef",
+    "FieldDef",
+    "Decl",
+    "Global",
+    "Assign",
+    "RecordField",
+    "Call",
+    "OutputArgs",
+    "InputArgs",
+    "While",
+    "If",
+    "Else",
+    "Read",
+    "Write",
+    "BinOp",
+    "BoolOp",
+    "RelOp",
+    "Not",
+    "Return",
+    "DefineType",
+    "Record",
+    "Union",
+};
+
+/* Productions as the AST builder expands them: rhs symbols and actions, -1 */
+static const int astRules[GRAMMAR_SIZE][AST_RULE_WIDTH] = {
+    {58, 59, AST_ACTION(AST_Program, AST_NODE), -1}, /* 1 */
+    {1, 68, 2, AST_ACTION(AST_Main, AST_NODE), -1}, /* 2 */
+    {60, 58, -1}, /* 3 */
+    {-1}, /* 4 */
+    {3, 61, 62, 4, 68, 2, AST_ACTION(AST_Function, AST_NODE), -1}, /* 5 */
+    {5, 6, 7, 8, 63, 9, AST_ACTION(AST_InputParams, AST_NODE), -1}, /* 6 */
+    {10, 6, 7, 8, 63, 9, AST_ACTION(AST_OutputParams, AST_NODE), -1}, /* 7 */
+    {-1}, /* 8 */
+    {64, 56, AST_ACTION(AST_Param, AST_NODE), 67, -1}, /* 9 */
+    {65, -1}, /* 10 */
+    {66, -1}, /* 11 */
+    {11, -1}, /* 12 */
+    {12, -1}, /* 13 */
+    {109, 13, AST_ACTION(AST_TypeName, AST_NODE), -1}, /* 14 */
+    {13, AST_ACTION(AST_TypeName, AST_NODE), -1}, /* 15 */
+    {14, 63, -1}, /* 16 */
+    {-1}, /* 17 */
+    {69, 76, 79, 104, AST_ACTION(AST_Stmts, AST_NODE), -1}, /* 18 */
+    {70, 69, -1}, /* 19 */
+    {-1}, /* 20 */
+    {71, -1}, /* 21 */
+    {108, -1}, /* 22 */
+    {15, 13, 72, 16, AST_ACTION(AST_RecordDef, AST_NODE), -1}, /* 23 */
+    {17, 13, 72, 18, AST_ACTION(AST_UnionDef, AST_NODE), -1}, /* 24 */
+    {73, 73, 75, -1}, /* 25 */
+    {19, 74, 20, 21, 4, AST_ACTION(AST_FieldDef, AST_NODE), -1}, /* 26 */
+    {65, -1}, /* 27 */
+    {66, -1}, /* 28 */
+    {73, 75, -1}, /* 29 */
+    {-1}, /* 30 */
+    {77, 76, -1}, /* 31 */
+    {-1}, /* 32 */
+    {19, 64, 20, 56, 78, 4, AST_ACTION(AST_Decl, AST_NODE), -1}, /* 33 */
+    {20, 22, AST_ACTION(AST_Global, AST_NODE), -1}, /* 34 */
+    {-1}, /* 35 */
+    {80, 79, -1}, /* 36 */
+    {-1}, /* 37 */
+    {81, -1}, /* 38 */
+    {89, -1}, /* 39 */
+    {90, -1}, /* 40 */
+    {92, -1}, /* 41 */
+    {86, -1}, /* 42 */
+    {82, 23, 93, 4, AST_ACTION(AST_Assign, AST_NODE), -1}, /* 43 */
+    {56, 83, AST_ACTION(AST_RecordField, AST_OPTIONAL), -1}, /* 44 */
+    {84, 85, -1}, /* 45 */
+    {-1}, /* 46 */
+    {84, 85, -1}, /* 47 */
+    {-1}, /* 48 */
+    {49, 21, -1}, /* 49 */
+    {87, 50, 3, 51, 52, 88, 4, AST_ACTION(AST_Call, AST_NODE), -1}, /* 50 */
+    {8, 106, 9, 23, AST_ACTION(AST_OutputArgs, AST_NODE), -1}, /* 51 */
+    {-1}, /* 52 */
+    {8, 106, 9, AST_ACTION(AST_InputArgs, AST_NODE), -1}, /* 53 */
+    {24, 25, 100, 26, 80, 79, 55, AST_ACTION(AST_While, AST_NODE), -1}, /* 54 */
+    {27, 25, 100, 26, 28, 80, 79, 91, AST_ACTION(AST_If, AST_NODE), -1}, /* 55 */
+    {29, 80, 79, 30, AST_ACTION(AST_Else, AST_NODE), -1}, /* 56 */
+    {30, -1}, /* 57 */
+    {31, 25, 101, 26, 4, AST_ACTION(AST_Read, AST_NODE), -1}, /* 58 */
+    {32, 25, 101, 26, 4, AST_ACTION(AST_Write, AST_NODE), -1}, /* 59 */
+    {95, 94, AST_ACTION(AST_BinOp, AST_FOLD), -1}, /* 60 */
+    {98, 95, 94, -1}, /* 61 */
+    {-1}, /* 62 */
+    {97, 96, AST_ACTION(AST_BinOp, AST_FOLD), -1}, /* 63 */
+    {99, 97, 96, -1}, /* 64 */
+    {-1}, /* 65 */
+    {25, 93, 26, -1}, /* 66 */
+    {101, -1}, /* 67 */
+    {33, -1}, /* 68 */
+    {34, -1}, /* 69 */
+    {35, -1}, /* 70 */
+    {36, -1}, /* 71 */
+    {25, 100, 26, 102, 25, 100, 26, AST_ACTION(AST_BoolOp, AST_FOLD), -1}, /* 72 */
+    {101, 103, 101, AST_ACTION(AST_RelOp, AST_FOLD), -1}, /* 73 */
+    {37, 25, 100, 26, AST_ACTION(AST_Not, AST_NODE), -1}, /* 74 */
+    {82, -1}, /* 75 */
+    {53, -1}, /* 76 */
+    {54, -1}, /* 77 */
+    {38, -1}, /* 78 */
+    {39, -1}, /* 79 */
+    {40, -1}, /* 80 */
+    {41, -1}, /* 81 */
+    {42, -1}, /* 82 */
+    {43, -1}, /* 83 */
+    {44, -1}, /* 84 */
+    {45, -1}, /* 85 */
+    {46, 105, 4, AST_ACTION(AST_Return, AST_NODE), -1}, /* 86 */
+    {8, 106, 9, -1}, /* 87 */
+    {-1}, /* 88 */
+    {56, 107, -1}, /* 89 */
+    {14, 106, -1}, /* 90 */
+    {-1}, /* 91 */
+    {47, 109, 13, 48, 13, AST_ACTION(AST_DefineType, AST_NODE), -1}, /* 92 */
+    {15, AST_ACTION(AST_Record, AST_NODE), -1}, /* 93 */
+    {17, AST_ACTION(AST_Union, AST_NODE), -1}, /* 94 */
+};
+
+/* FIRST set of every symbol */
+static const SymbolSet grammarFirst[TERMS_SIZE] = {
+    {{0x0000000000000001ULL, 0x0000000000000000ULL}}, /* $ */
+    {{0x0000000000000002ULL, 0x0000000000000000ULL}}, /* TK_MAIN */
+    {{0x0000000000000004ULL, 0x0000000000000000ULL}}, /* TK_END */
+    {{0x0000000000000008ULL, 0x0000000000000000ULL}}, /* TK_FUNID */
+    {{0x0000000000000010ULL, 0x0000000000000000ULL}}, /* TK_SEM */
+    {{0x0000000000000020ULL, 0x0000000000000000ULL}}, /* TK_INPUT */
+    {{0x0000000000000040ULL, 0x0000000000000000ULL}}, /* TK_PARAMETER */
+    {{0x0000000000000080ULL, 0x0000000000000000ULL}}, /* TK_LIST */
+    {{0x0000000000000100ULL, 0x0000000000000000ULL}}, /* TK_SQL */
+    {{0x0000000000000200ULL, 0x0000000000000000ULL}}, /* TK_SQR */
+    {{0x0000000000000400ULL, 0x0000000000000000ULL}}, /* TK_OUTPUT */
+    {{0x0000000000000800ULL, 0x0000000000000000ULL}}, /* TK_INT */
+    {{0x0000000000001000ULL, 0x0000000000000000ULL}}, /* TK_REAL */
+    {{0x0000000000002000ULL, 0x0000000000000000ULL}}, /* TK_RUID */
+    {{0x0000000000004000ULL, 0x0000000000000000ULL}}, /* TK_COMMA */
+    {{0x0000000000008000ULL, 0x0000000000000000ULL}}, /* TK_RECORD */
+    {{0x0000000000010000ULL, 0x0000000000000000ULL}}, /* TK_ENDRECORD */
+    {{0x0000000000020000ULL, 0x0000000000000000ULL}}, /* TK_UNION */
+    {{0x0000000000040000ULL, 0x0000000000000000ULL}}, /* TK_ENDUNION */
+    {{0x0000000000080000ULL, 0x0000000000000000ULL}}, /* TK_TYPE */
+    {{0x0000000000100000ULL, 0x0000000000000000ULL}}, /* TK_COLON */
+    {{0x0000000000200000ULL, 0x0000000000000000ULL}}, /* TK_FIELDID */
+    {{0x0000000000400000ULL, 0x0000000000000000ULL}}, /* TK_GLOBAL */
+    {{0x0000000000800000ULL, 0x0000000000000000ULL}}, /* TK_ASSIGNOP */
+    {{0x0000000001000000ULL, 0x0000000000000000ULL}}, /* TK_WHILE */
+    {{0x0000000002000000ULL, 0x0000000000000000ULL}}, /* TK_OP */
+    {{0x0000000004000000ULL, 0x0000000000000000ULL}}, /* TK_CL */
+    {{0x0000000008000000ULL, 0x0000000000000000ULL}}, /* TK_IF */
+    {{0x0000000010000000ULL, 0x0000000000000000ULL}}, /* TK_THEN */
+    {{0x0000000020000000ULL, 0x0000000000000000ULL}}, /* TK_ELSE */
+    {{0x0000000040000000ULL, 0x0000000000000000ULL}}, /* TK_ENDIF */
+    {{0x0000000080000000ULL, 0x0000000000000000ULL}}, /* TK_READ */
+    {{0x0000000100000000ULL, 0x0000000000000000ULL}}, /* TK_WRITE */
+    {{0x0000000200000000ULL, 0x0000000000000000ULL}}, /* TK_PLUS */
+    {{0x0000000400000000ULL, 0x0000000000000000ULL}}, /* TK_MINUS */
+    {{0x0000000800000000ULL, 0x0000000000000000ULL}}, /* TK_MUL */
+    {{0x0000001000000000ULL, 0x0000000000000000ULL}}, /* TK_DIV */
+    {{0x0000002000000000ULL, 0x0000000000000000ULL}}, /* TK_NOT */
+    {{0x0000004000000000ULL, 0x0000000000000000ULL}}, /* TK_AND */
+    {{0x0000008000000000ULL, 0x0000000000000000ULL}}, /* TK_OR */
+    {{0x0000010000000000ULL, 0x0000000000000000ULL}}, /* TK_LT */
+    {{0x0000020000000000ULL, 0x0000000000000000ULL}}, /* TK_LE */
+    {{0x0000040000000000ULL, 0x0000000000000000ULL}}, /* TK_EQ */
+    {{0x0000080000000000ULL, 0x0000000000000000ULL}}, /* TK_GT */
+    {{0x0000100000000000ULL, 0x0000000000000000ULL}}, /* TK_GE */
+    {{0x0000200000000000ULL, 0x0000000000000000ULL}}, /* TK_NE */
+    {{0x0000400000000000ULL, 0x0000000000000000ULL}}, /* TK_RETURN */
+    {{0x0000800000000000ULL, 0x0000000000000000ULL}}, /* TK_DEFINETYPE */
+    {{0x0001000000000000ULL, 0x0000000000000000ULL}}, /* TK_AS */
+    {{0x0002000000000000ULL, 0x0000000000000000ULL}}, /* TK_DOT */
+    {{0x0004000000000000ULL, 0x0000000000000000ULL}}, /* TK_CALL */
+    {{0x0008000000000000ULL, 0x0000000000000000ULL}}, /* TK_WITH */
+    {{0x0010000000000000ULL, 0x0000000000000000ULL}}, /* TK_PARAMETERS */
+    {{0x0020000000000000ULL, 0x0000000000000000ULL}}, /* TK_NUM */
+    {{0x0040000000000000ULL, 0x0000000000000000ULL}}, /* TK_RNUM */
+    {{0x0080000000000000ULL, 0x0000000000000000ULL}}, /* TK_ENDWHILE */
+    {{0x0100000000000000ULL, 0x0000000000000000ULL}}, /* TK_ID */
+    {{0x000000000000000aULL, 0x0000000000000000ULL}}, /* program */
+    {{0x0000000000000008ULL, 0x0000400000000000ULL}}, /* otherFunctions */
+    {{0x0000000000000002ULL, 0x0000000000000000ULL}}, /* mainFunction */
+    {{0x0000000000000008ULL, 0x0000000000000000ULL}}, /* function */
+    {{0x0000000000000020ULL, 0x0000000000000000ULL}}, /* input_par */
+    {{0x0000000000000400ULL, 0x0000400000000000ULL}}, /* output_par */
+    {{0x000000000002b800ULL, 0x0000000000000000ULL}}, /* parameter_list */
+    {{0x000000000002b800ULL, 0x0000000000000000ULL}}, /* dataType */
+    {{0x0000000000001800ULL, 0x0000000000000000ULL}}, /* primitiveDataType */
+    {{0x000000000002a000ULL, 0x0000000000000000ULL}}, /* constructedDataType */
+    {{0x0000000000004000ULL, 0x0000400000000000ULL}}, /* remaining_list */
+    {{0x0104c001890a8100ULL, 0x0000000000000000ULL}}, /* stmts */
+    {{0x0000800000028000ULL, 0x0000400000000000ULL}}, /* typeDefinitions */
+    {{0x0000800000028000ULL, 0x0000000000000000ULL}}, /* actualOrRedefined */
+    {{0x0000000000028000ULL, 0x0000000000000000ULL}}, /* typeDefinition */
+    {{0x0000000000080000ULL, 0x0000000000000000ULL}}, /* fieldDefinitions */
+    {{0x0000000000080000ULL, 0x0000000000000000ULL}}, /* fieldDefinition */
+    {{0x000000000002b800ULL, 0x0000000000000000ULL}}, /* fieldType */
+    {{0x0000000000080000ULL, 0x0000400000000000ULL}}, /* moreFields */
+    {{0x0000000000080000ULL, 0x0000400000000000ULL}}, /* declarations */
+    {{0x0000000000080000ULL, 0x0000000000000000ULL}}, /* declaration */
+    {{0x0000000000100000ULL, 0x0000400000000000ULL}}, /* global_or_not */
+    {{0x0104000189000100ULL, 0x0000400000000000ULL}}, /* otherStmts */
+    {{0x0104000189000100ULL, 0x0000000000000000ULL}}, /* stmt */
+    {{0x0100000000000000ULL, 0x0000000000000000ULL}}, /* assignmentStmt */
+    {{0x0100000000000000ULL, 0x0000000000000000ULL}}, /* SingleOrRecId */
+    {{0x0002000000000000ULL, 0x0000400000000000ULL}}, /* option_single_constructed */
+    {{0x0002000000000000ULL, 0x0000000000000000ULL}}, /* oneExpansion */
+    {{0x0002000000000000ULL, 0x0000400000000000ULL}}, /* moreExpansions */
+    {{0x0004000000000100ULL, 0x0000000000000000ULL}}, /* funCallStmt */
+    {{0x0000000000000100ULL, 0x0000400000000000ULL}}, /* outputParameters */
+    {{0x0000000000000100ULL, 0x0000000000000000ULL}}, /* inputParameters */
+    {{0x0000000001000000ULL, 0x0000000000000000ULL}}, /* iterativeStmt */
+    {{0x0000000008000000ULL, 0x0000000000000000ULL}}, /* conditionalStmt */
+    {{0x0000000060000000ULL, 0x0000000000000000ULL}}, /* elsePart */
+    {{0x0000000180000000ULL, 0x0000000000000000ULL}}, /* ioStmt */
+    {{0x0160000002000000ULL, 0x0000000000000000ULL}}, /* arithmeticExpression */
+    {{0x0000000600000000ULL, 0x0000400000000000ULL}}, /* expPrime */
+    {{0x0160000002000000ULL, 0x0000000000000000ULL}}, /* term */
+    {{0x0000001800000000ULL, 0x0000400000000000ULL}}, /* termPrime */
+    {{0x0160000002000000ULL, 0x0000000000000000ULL}}, /* factor */
+    {{0x0000000600000000ULL, 0x0000000000000000ULL}}, /* lowPrecedenceOp */
+    {{0x0000001800000000ULL, 0x0000000000000000ULL}}, /* highPrecedenceOp */
+    {{0x0160002002000000ULL, 0x0000000000000000ULL}}, /* booleanExpression */
+    {{0x0160000000000000ULL, 0x0000000000000000ULL}}, /* var */
+    {{0x000000c000000000ULL, 0x0000000000000000ULL}}, /* logicalOp */
+    {{0x00003f0000000000ULL, 0x0000000000000000ULL}}, /* relationalOp */
+    {{0x0000400000000000ULL, 0x0000000000000000ULL}}, /* returnStmt */
+    {{0x0000000000000100ULL, 0x0000400000000000ULL}}, /* optionalReturn */
+    {{0x0100000000000000ULL, 0x0000000000000000ULL}}, /* idList */
+    {{0x0000000000004000ULL, 0x0000400000000000ULL}}, /* more_ids */
+    {{0x0000800000000000ULL, 0x0000000000000000ULL}}, /* definetypestmt */
+    {{0x0000000000028000ULL, 0x0000000000000000ULL}}, /* A */
+    {{0x0000000000000000ULL, 0x0000400000000000ULL}}, /* eps */
+};
+
+/* FOLLOW set of every non-terminal, $ is bit 0 */
+static const SymbolSet grammarFollow[TERMS_SIZE] = {
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* $ */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_MAIN */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_END */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_FUNID */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_SEM */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_INPUT */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_PARAMETER */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_LIST */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_SQL */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_SQR */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_OUTPUT */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_INT */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_REAL */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_RUID */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_COMMA */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_RECORD */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_ENDRECORD */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_UNION */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_ENDUNION */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_TYPE */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_COLON */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_FIELDID */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_GLOBAL */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_ASSIGNOP */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_WHILE */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_OP */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_CL */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_IF */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_THEN */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_ELSE */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_ENDIF */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_READ */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_WRITE */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_PLUS */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_MINUS */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_MUL */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_DIV */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_NOT */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_AND */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_OR */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_LT */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_LE */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_EQ */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_GT */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_GE */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_NE */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_RETURN */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_DEFINETYPE */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_AS */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_DOT */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_CALL */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_WITH */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_PARAMETERS */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_NUM */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_RNUM */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_ENDWHILE */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* TK_ID */
+    {{0x0000000000000001ULL, 0x0000000000000000ULL}}, /* program */
+    {{0x0000000000000002ULL, 0x0000000000000000ULL}}, /* otherFunctions */
+    {{0x0000000000000001ULL, 0x0000000000000000ULL}}, /* mainFunction */
+    {{0x000000000000000aULL, 0x0000000000000000ULL}}, /* function */
+    {{0x0000000000000410ULL, 0x0000000000000000ULL}}, /* input_par */
+    {{0x0000000000000010ULL, 0x0000000000000000ULL}}, /* output_par */
+    {{0x0000000000000200ULL, 0x0000000000000000ULL}}, /* parameter_list */
+    {{0x0100000000100000ULL, 0x0000000000000000ULL}}, /* dataType */
+    {{0x0100000000100000ULL, 0x0000000000000000ULL}}, /* primitiveDataType */
+    {{0x0100000000100000ULL, 0x0000000000000000ULL}}, /* constructedDataType */
+    {{0x0000000000000200ULL, 0x0000000000000000ULL}}, /* remaining_list */
+    {{0x0000000000000004ULL, 0x0000000000000000ULL}}, /* stmts */
+    {{0x0104400189080100ULL, 0x0000000000000000ULL}}, /* typeDefinitions */
+    {{0x0104c001890a8100ULL, 0x0000000000000000ULL}}, /* actualOrRedefined */
+    {{0x0104c001890a8100ULL, 0x0000000000000000ULL}}, /* typeDefinition */
+    {{0x0000000000050000ULL, 0x0000000000000000ULL}}, /* fieldDefinitions */
+    {{0x00000000000d0000ULL, 0x0000000000000000ULL}}, /* fieldDefinition */
+    {{0x0000000000100000ULL, 0x0000000000000000ULL}}, /* fieldType */
+    {{0x0000000000050000ULL, 0x0000000000000000ULL}}, /* moreFields */
+    {{0x0104400189000100ULL, 0x0000000000000000ULL}}, /* declarations */
+    {{0x0104400189080100ULL, 0x0000000000000000ULL}}, /* declaration */
+    {{0x0000000000000010ULL, 0x0000000000000000ULL}}, /* global_or_not */
+    {{0x0080400060000000ULL, 0x0000000000000000ULL}}, /* otherStmts */
+    {{0x01844001e9000100ULL, 0x0000000000000000ULL}}, /* stmt */
+    {{0x01844001e9000100ULL, 0x0000000000000000ULL}}, /* assignmentStmt */
+    {{0x00003f1e04800010ULL, 0x0000000000000000ULL}}, /* SingleOrRecId */
+    {{0x00003f1e04800010ULL, 0x0000000000000000ULL}}, /* option_single_constructed */
+    {{0x00023f1e04800010ULL, 0x0000000000000000ULL}}, /* oneExpansion */
+    {{0x00003f1e04800010ULL, 0x0000000000000000ULL}}, /* moreExpansions */
+    {{0x01844001e9000100ULL, 0x0000000000000000ULL}}, /* funCallStmt */
+    {{0x0004000000000000ULL, 0x0000000000000000ULL}}, /* outputParameters */
+    {{0x0000000000000010ULL, 0x0000000000000000ULL}}, /* inputParameters */
+    {{0x01844001e9000100ULL, 0x0000000000000000ULL}}, /* iterativeStmt */
+    {{0x01844001e9000100ULL, 0x0000000000000000ULL}}, /* conditionalStmt */
+    {{0x01844001e9000100ULL, 0x0000000000000000ULL}}, /* elsePart */
+    {{0x01844001e9000100ULL, 0x0000000000000000ULL}}, /* ioStmt */
+    {{0x0000000004000010ULL, 0x0000000000000000ULL}}, /* arithmeticExpression */
+    {{0x0000000004000010ULL, 0x0000000000000000ULL}}, /* expPrime */
+    {{0x0000000604000010ULL, 0x0000000000000000ULL}}, /* term */
+    {{0x0000000604000010ULL, 0x0000000000000000ULL}}, /* termPrime */
+    {{0x0000001e04000010ULL, 0x0000000000000000ULL}}, /* factor */
+    {{0x0160000002000000ULL, 0x0000000000000000ULL}}, /* lowPrecedenceOp */
+    {{0x0160000002000000ULL, 0x0000000000000000ULL}}, /* highPrecedenceOp */
+    {{0x0000000004000000ULL, 0x0000000000000000ULL}}, /* booleanExpression */
+    {{0x00003f1e04000010ULL, 0x0000000000000000ULL}}, /* var */
+    {{0x0000000002000000ULL, 0x0000000000000000ULL}}, /* logicalOp */
+    {{0x0160000000000000ULL, 0x0000000000000000ULL}}, /* relationalOp */
+    {{0x0000000000000004ULL, 0x0000000000000000ULL}}, /* returnStmt */
+    {{0x0000000000000010ULL, 0x0000000000000000ULL}}, /* optionalReturn */
+    {{0x0000000000000200ULL, 0x0000000000000000ULL}}, /* idList */
+    {{0x0000000000000200ULL, 0x0000000000000000ULL}}, /* more_ids */
+    {{0x0104c001890a8100ULL, 0x0000000000000000ULL}}, /* definetypestmt */
+    {{0x0000000000002000ULL, 0x0000000000000000ULL}}, /* A */
+    {{0x0000000000000000ULL, 0x0000000000000000ULL}}, /* eps */
+};
+
+/* [non-terminal][terminal] -> production, -1 (error) or SYNCRO */
+static const struct pTable grammarTable = {{
+    {-2,0,-1,0,-1,-1,-1,-1,-2,-1,-1,-1,-1,-1,-1,-2,-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-2,-2,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-1,-1,-2}, /* program */
+    {-1,3,-1,2,-1,-1,-1,-1,-2,-1,-1,-1,-1,-1,-1,-2,-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-2,-2,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-1,-1,-2}, /* otherFunctions */
+    {-2,1,-1,-2,-1,-1,-1,-1,-2,-1,-1,-1,-1,-1,-1,-2,-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-2,-2,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-1,-1,-2}, /* mainFunction */
+    {-1,-2,-1,4,-1,-1,-1,-1,-2,-1,-1,-1,-1,-1,-1,-2,-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-2,-2,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-1,-1,-2}, /* function */
+    {-1,-2,-1,-2,-2,5,-1,-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-2,-2,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-1,-1,-2}, /* input_par */
+    {-1,-2,-1,-2,7,-1,-1,-1,-2,-1,6,-1,-1,-1,-1,-2,-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-2,-2,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-1,-1,-2}, /* output_par */
+    {-1,-2,-1,-2,-1,-1,-1,-1,-2,-2,-1,8,8,8,-1,8,-1,8,-1,-2,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-2,-2,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-1,-1,-2}, /* parameter_list */
+    {-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-1,9,9,10,-1,10,-1,10,-1,-2,-2,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-2,-2,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-1,-1,-2}, /* dataType */
+    {-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-1,11,12,-1,-1,-2,-1,-2,-1,-2,-2,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-2,-2,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-1,-1,-2}, /* primitiveDataType */
+    {-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-1,-1,-1,14,-1,13,-1,13,-1,-2,-2,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-2,-2,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-1,-1,-2}, /* constructedDataType */
+    {-1,-2,-1,-2,-1,-1,-1,-1,-2,16,-1,-1,-1,-1,15,-2,-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-2,-2,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-1,-1,-2}, /* remaining_list */
+    {-1,-2,-2,-2,-1,-1,-1,-1,17,-1,-1,-1,-1,-1,-1,17,-1,17,-1,17,-1,-1,-1,-1,17,-1,-1,17,-1,-1,-1,17,17,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,17,17,-1,-1,17,-1,-1,-1,-1,-1,17}, /* stmts */
+    {-1,-2,-1,-2,-1,-1,-1,-1,19,-1,-1,-1,-1,-1,-1,18,-1,18,-1,19,-1,-1,-1,-1,19,-1,-1,19,-1,-1,-1,19,19,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,19,18,-1,-1,19,-1,-1,-1,-1,-1,19}, /* typeDefinitions */
+    {-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-1,-1,-1,-1,-1,20,-1,20,-1,-2,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-2,-2,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-2,21,-1,-1,-2,-1,-1,-1,-1,-1,-2}, /* actualOrRedefined */
+    {-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-1,-1,-1,-1,-1,22,-1,23,-1,-2,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-2,-2,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-2,-2,-1,-1,-2,-1,-1,-1,-1,-1,-2}, /* typeDefinition */
+    {-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-1,-1,-1,-1,-1,-2,-2,-2,-2,24,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-2,-2,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-1,-1,-2}, /* fieldDefinitions */
+    {-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-1,-1,-1,-1,-1,-2,-2,-2,-2,25,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-2,-2,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-1,-1,-2}, /* fieldDefinition */
+    {-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-1,26,26,27,-1,27,-1,27,-1,-2,-2,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-2,-2,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-1,-1,-2}, /* fieldType */
+    {-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-1,-1,-1,-1,-1,-2,29,-2,29,28,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-2,-2,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-1,-1,-2}, /* moreFields */
+    {-1,-2,-1,-2,-1,-1,-1,-1,31,-1,-1,-1,-1,-1,-1,-2,-1,-2,-1,30,-1,-1,-1,-1,31,-1,-1,31,-1,-1,-1,31,31,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,31,-2,-1,-1,31,-1,-1,-1,-1,-1,31}, /* declarations */
+    {-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-1,-1,-1,-1,-1,-2,-1,-2,-1,32,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-2,-2,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-2,-2,-1,-1,-2,-1,-1,-1,-1,-1,-2}, /* declaration */
+    {-1,-2,-1,-2,34,-1,-1,-1,-2,-1,-1,-1,-1,-1,-1,-2,-1,-2,-1,-2,33,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-2,-2,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-1,-1,-2}, /* global_or_not */
+    {-1,-2,-1,-2,-1,-1,-1,-1,35,-1,-1,-1,-1,-1,-1,-2,-1,-2,-1,-2,-1,-1,-1,-1,35,-1,-1,35,-1,36,36,35,35,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,36,-2,-1,-1,35,-1,-1,-1,-1,36,35}, /* otherStmts */
+    {-1,-2,-1,-2,-1,-1,-1,-1,41,-1,-1,-1,-1,-1,-1,-2,-1,-2,-1,-2,-1,-1,-1,-1,38,-1,-1,39,-1,-2,-2,40,40,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-2,-2,-1,-1,41,-1,-1,-1,-1,-2,37}, /* stmt */
+    {-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-1,-1,-1,-1,-1,-2,-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-1,-2,-1,-2,-2,-2,-2,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-2,-2,-1,-1,-2,-1,-1,-1,-1,-2,42}, /* assignmentStmt */
+    {-1,-2,-1,-2,-2,-1,-1,-1,-2,-1,-1,-1,-1,-1,-1,-2,-1,-2,-1,-2,-1,-1,-1,-2,-2,-1,-2,-2,-1,-1,-1,-2,-2,-2,-2,-2,-2,-1,-1,-1,-2,-2,-2,-2,-2,-2,-1,-2,-1,-1,-2,-1,-1,-1,-1,-1,43}, /* SingleOrRecId */
+    {-1,-2,-1,-2,45,-1,-1,-1,-2,-1,-1,-1,-1,-1,-1,-2,-1,-2,-1,-2,-1,-1,-1,45,-2,-1,45,-2,-1,-1,-1,-2,-2,45,45,45,45,-1,-1,-1,45,45,45,45,45,45,-1,-2,-1,44,-2,-1,-1,-1,-1,-1,-2}, /* option_single_constructed */
+    {-1,-2,-1,-2,-2,-1,-1,-1,-2,-1,-1,-1,-1,-1,-1,-2,-1,-2,-1,-2,-1,-1,-1,-2,-2,-1,-2,-2,-1,-1,-1,-2,-2,-2,-2,-2,-2,-1,-1,-1,-2,-2,-2,-2,-2,-2,-1,-2,-1,48,-2,-1,-1,-1,-1,-1,-2}, /* oneExpansion */
+    {-1,-2,-1,-2,47,-1,-1,-1,-2,-1,-1,-1,-1,-1,-1,-2,-1,-2,-1,-2,-1,-1,-1,47,-2,-1,47,-2,-1,-1,-1,-2,-2,47,47,47,47,-1,-1,-1,47,47,47,47,47,47,-1,-2,-1,46,-2,-1,-1,-1,-1,-1,-2}, /* moreExpansions */
+    {-1,-2,-1,-2,-1,-1,-1,-1,49,-1,-1,-1,-1,-1,-1,-2,-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-1,-2,-1,-2,-2,-2,-2,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-2,-2,-1,-1,49,-1,-1,-1,-1,-2,-2}, /* funCallStmt */
+    {-1,-2,-1,-2,-1,-1,-1,-1,50,-1,-1,-1,-1,-1,-1,-2,-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-2,-2,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-2,-1,-1,51,-1,-1,-1,-1,-1,-2}, /* outputParameters */
+    {-1,-2,-1,-2,-2,-1,-1,-1,52,-1,-1,-1,-1,-1,-1,-2,-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-2,-2,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-1,-1,-2}, /* inputParameters */
+    {-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-1,-1,-1,-1,-1,-2,-1,-2,-1,-2,-1,-1,-1,-1,53,-1,-1,-2,-1,-2,-2,-2,-2,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-2,-2,-1,-1,-2,-1,-1,-1,-1,-2,-2}, /* iterativeStmt */
+    {-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-1,-1,-1,-1,-1,-2,-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-1,54,-1,-2,-2,-2,-2,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-2,-2,-1,-1,-2,-1,-1,-1,-1,-2,-2}, /* conditionalStmt */
+    {-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-1,-1,-1,-1,-1,-2,-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-1,-2,-1,55,56,-2,-2,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-2,-2,-1,-1,-2,-1,-1,-1,-1,-2,-2}, /* elsePart */
+    {-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-1,-1,-1,-1,-1,-2,-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-1,-2,-1,-2,-2,57,58,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-2,-2,-1,-1,-2,-1,-1,-1,-1,-2,-2}, /* ioStmt */
+    {-1,-2,-1,-2,-2,-1,-1,-1,-2,-1,-1,-1,-1,-1,-1,-2,-1,-2,-1,-2,-1,-1,-1,-1,-2,59,-2,-2,-1,-1,-1,-2,-2,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,59,59,-1,59}, /* arithmeticExpression */
+    {-1,-2,-1,-2,61,-1,-1,-1,-2,-1,-1,-1,-1,-1,-1,-2,-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,61,-2,-1,-1,-1,-2,-2,60,60,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-1,-1,-2}, /* expPrime */
+    {-1,-2,-1,-2,-2,-1,-1,-1,-2,-1,-1,-1,-1,-1,-1,-2,-1,-2,-1,-2,-1,-1,-1,-1,-2,62,-2,-2,-1,-1,-1,-2,-2,-2,-2,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,62,62,-1,62}, /* term */
+    {-1,-2,-1,-2,64,-1,-1,-1,-2,-1,-1,-1,-1,-1,-1,-2,-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,64,-2,-1,-1,-1,-2,-2,64,64,63,63,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-1,-1,-2}, /* termPrime */
+    {-1,-2,-1,-2,-2,-1,-1,-1,-2,-1,-1,-1,-1,-1,-1,-2,-1,-2,-1,-2,-1,-1,-1,-1,-2,65,-2,-2,-1,-1,-1,-2,-2,-2,-2,-2,-2,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,66,66,-1,66}, /* factor */
+    {-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-1,-1,-1,-1,-1,-2,-1,-2,-1,-2,-1,-1,-1,-1,-2,-2,-1,-2,-1,-1,-1,-2,-2,67,68,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-2,-2,-1,-2}, /* lowPrecedenceOp */
+    {-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-1,-1,-1,-1,-1,-2,-1,-2,-1,-2,-1,-1,-1,-1,-2,-2,-1,-2,-1,-1,-1,-2,-2,-1,-1,69,70,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-2,-2,-1,-2}, /* highPrecedenceOp */
+    {-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-1,-1,-1,-1,-1,-2,-1,-2,-1,-2,-1,-1,-1,-1,-2,71,-2,-2,-1,-1,-1,-2,-2,-1,-1,-1,-1,73,-1,-1,-1,-1,-1,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,72,72,-1,72}, /* booleanExpression */
+    {-1,-2,-1,-2,-2,-1,-1,-1,-2,-1,-1,-1,-1,-1,-1,-2,-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-2,-2,-1,-1,-1,-2,-2,-2,-2,-2,-2,-1,-1,-1,-2,-2,-2,-2,-2,-2,-1,-2,-1,-1,-2,-1,-1,75,76,-1,74}, /* var */
+    {-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-1,-1,-1,-1,-1,-2,-1,-2,-1,-2,-1,-1,-1,-1,-2,-2,-1,-2,-1,-1,-1,-2,-2,-1,-1,-1,-1,-1,77,78,-1,-1,-1,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-1,-1,-2}, /* logicalOp */
+    {-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-1,-1,-1,-1,-1,-2,-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-2,-2,-1,-1,-1,-1,-1,-1,-1,79,80,81,82,83,84,-1,-2,-1,-1,-2,-1,-1,-2,-2,-1,-2}, /* relationalOp */
+    {-1,-2,-2,-2,-1,-1,-1,-1,-2,-1,-1,-1,-1,-1,-1,-2,-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-2,-2,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,85,-2,-1,-1,-2,-1,-1,-1,-1,-1,-2}, /* returnStmt */
+    {-1,-2,-1,-2,87,-1,-1,-1,86,-1,-1,-1,-1,-1,-1,-2,-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-2,-2,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-1,-1,-2}, /* optionalReturn */
+    {-1,-2,-1,-2,-1,-1,-1,-1,-2,-2,-1,-1,-1,-1,-1,-2,-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-2,-2,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-1,-1,88}, /* idList */
+    {-1,-2,-1,-2,-1,-1,-1,-1,-2,90,-1,-1,-1,-1,89,-2,-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-2,-2,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-1,-1,-2}, /* more_ids */
+    {-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-1,-1,-1,-1,-1,-2,-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-2,-2,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-2,91,-1,-1,-2,-1,-1,-1,-1,-1,-2}, /* definetypestmt */
+    {-1,-2,-1,-2,-1,-1,-1,-1,-2,-1,-1,-1,-1,-2,-1,92,-1,93,-1,-2,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-2,-2,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-2,-1,-1,-2,-1,-1,-1,-1,-1,-2}, /* A */
+}};
+
+#endif /* GRAMMARDEF_H */
@@ -0,0 +1,319 @@
+/**
+ * @file intern.c
+ * @brief String interning pool for lexemes.
+ *
+ * Every distinct lexeme is stored once in an arena and identified by a 32-bit
+ * handle. Tokens and parse-tree nodes carry the handle instead of a private
+ * character buffer, so identical identifiers share storage and can be compared
+ * by handle.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "intern.h"
+
+#define ARENA_BLOCK_SIZE 65536 ///< Default size of one arena block
+
+/**
+ * @brief One block of the string arena; blocks are never moved or resized.
+ */
+struct ArenaBlock
+{
+    ArenaBlock *next;
+    size_t used;
+    size_t size;
+    char data[];
+};
+
+static _Thread_local InternPool *defaultPool = NULL; ///< Pool behind lexemePool(), one per thread
+
+/**
+ * @brief Creates an empty intern pool.
+ *
+ * @param expectedStrings Number of distinct strings to size the hash set for.
+ * @return InternPool* Pointer to the created pool.
+ */
+InternPool *createInternPool(int expectedStrings);
+
+/**
+ * @brief Destroys a pool, its arena and every string handed out by it.
+ *
+ * @param P The pool to destroy.
+ */
+void destroyInternPool(InternPool *P);
+
+/**
+ * @brief Returns the handle of a string, adding it to the pool if needed.
+ *
+ * @param P The pool.
+ * @param s The characters (need not be NUL-terminated).
+ * @param len Number of characters.
+ * @return LexemeId The handle; LEXEME_EMPTY for the empty string.
+ */
+LexemeId internString(InternPool *P, const char *s, int len);
+
+/**
+ * @brief Returns the NUL-terminated text of a handle.
+ *
+ * @param P The pool that issued the handle.
+ * @param id The handle.
+ * @return const char* The string, valid until the pool is destroyed.
+ */
+const char *internedString(const InternPool *P, LexemeId id);
+
+/**
+ * @brief Returns the length of an interned string.
+ *
+ * @param P The pool that issued the handle.
+ * @param id The handle.
+ * @return int The length in characters.
+ */
+int internedLength(const InternPool *P, LexemeId id);
+
+/**
+ * @brief Returns the numeric value cached for an interned string.
+ *
+ * The lexer caches the value of number lexemes once, so the parse tree
+ * printer needs no atoi()/atof() per node.
+ *
+ * @param P The pool that issued the handle.
+ * @param id The handle.
+ * @return double The cached value, or NAN if none was set.
+ */
+double internedValue(const InternPool *P, LexemeId id);
+
+/**
+ * @brief Caches the numeric value of an interned string.
+ *
+ * @param P The pool that issued the handle.
+ * @param id The handle.
+ * @param value The value.
+ */
+void setInternedValue(InternPool *P, LexemeId id, double value);
+
+/**
+ * @brief Returns the calling thread's lexeme pool, creating it on first use.
+ *
+ * Every thread lexes and parses its own files, so handles never cross threads
+ * and the pool needs no locking.
+ *
+ * @return InternPool* The pool of this thread.
+ */
+InternPool *lexemePool(void);
+
+/**
+ * @brief Shorthand for internedString(lexemePool(), id).
+ *
+ * @param id The handle.
+ * @return const char* The string.
+ */
+const char *lexemeText(LexemeId id);
+
+/**
+ * @brief Destroys the calling thread's lexeme pool; the next lexemePool() starts a new one.
+ */
+void releaseLexemePool(void);
+
+static uint32_t hashBytes(const char *s, int len)
+{
+    uint32_t h = 2166136261u; // FNV-1a
+    for (int i = 0; i < len; i++)
+    {
+        h ^= (unsigned char)s[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static char *arenaAlloc(InternPool *P, size_t n)
+{
+    ArenaBlock *b = P->blocks;
+    if (!b || b->size - b->used < n)
+    {
+        size_t size = n > ARENA_BLOCK_SIZE ? n : ARENA_BLOCK_SIZE;
+        b = (ArenaBlock *)malloc(sizeof(ArenaBlock) + size);
+        if (!b)
+        {
+            fprintf(stderr, "Memory allocation failed in arenaAlloc\n");
+            exit(EXIT_FAILURE);
+        }
+        b->next = P->blocks;
+        b->used = 0;
+        b->size = size;
+        P->blocks = b;
+    }
+    char *p = b->data + b->used;
+    b->used += n;
+    return p;
+}
+
+static void growSlots(InternPool *P)
+{
+    uint32_t newCount = P->slotCount * 2;
+    uint32_t *slots = (uint32_t *)calloc(newCount, sizeof(uint32_t));
+    if (!slots)
+    {
+        fprintf(stderr, "Memory allocation failed in growSlots\n");
+        exit(EXIT_FAILURE);
+    }
+    for (uint32_t id = 1; id < P->count; id++)
+    {
+        uint32_t i = P->hash[id] & (newCount - 1);
+        while (slots[i] != 0)
+            i = (i + 1) & (newCount - 1);
+        slots[i] = id;
+    }
+    free(P->slots);
+    P->slots = slots;
+    P->slotCount = newCount;
+}
+
+static void growEntries(InternPool *P)
+{
+    uint32_t capacity = P->capacity * 2;
+    const char **text = (const char **)realloc(P->text, capacity * sizeof(const char *));
+    uint32_t *length = (uint32_t *)realloc(P->length, capacity * sizeof(uint32_t));
+    uint32_t *hash = (uint32_t *)realloc(P->hash, capacity * sizeof(uint32_t));
+    double *value = (double *)realloc(P->value, capacity * sizeof(double));
+    if (!text || !length || !hash || !value)
+    {
+        fprintf(stderr, "Memory allocation failed in growEntries\n");
+        exit(EXIT_FAILURE);
+    }
+    P->text = text;
+    P->length = length;
+    P->hash = hash;
+    P->value = value;
+    P->capacity = capacity;
+}
+
+InternPool *createInternPool(int expectedStrings)
+{
+    InternPool *P = (InternPool *)calloc(1, sizeof(InternPool));
+    if (!P)
+    {
+        fprintf(stderr, "Memory allocation failed in createInternPool\n");
+        exit(EXIT_FAILURE);
+    }
+
+    P->slotCount = 64;
+    while (P->slotCount < (uint32_t)expectedStrings * 2)
+        P->slotCount <<= 1;
+    P->capacity = P->slotCount / 2;
+
+    P->slots = (uint32_t *)calloc(P->slotCount, sizeof(uint32_t));
+    P->text = (const char **)malloc(P->capacity * sizeof(const char *));
+    P->length = (uint32_t *)malloc(P->capacity * sizeof(uint32_t));
+    P->hash = (uint32_t *)malloc(P->capacity * sizeof(uint32_t));
+    P->value = (double *)malloc(P->capacity * sizeof(double));
+    if (!P->slots || !P->text || !P->length || !P->hash || !P->value)
+    {
+        fprintf(stderr, "Memory allocation failed in createInternPool\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // Handle 0 is the empty string and never enters the hash set
+    P->text[LEXEME_EMPTY] = "";
+    P->length[LEXEME_EMPTY] = 0;
+    P->hash[LEXEME_EMPTY] = 0;
+    P->value[LEXEME_EMPTY] = NAN;
+    P->count = 1;
+    return P;
+}
+
+void destroyInternPool(InternPool *P)
+{
+    if (!P)
+        return;
+    ArenaBlock *b = P->blocks;
+    while (b)
+    {
+        ArenaBlock *next = b->next;
+        free(b);
+        b = next;
+    }
+    free(P->slots);
+    free(P->text);
+    free(P->length);
+    free(P->hash);
+    free(P->value);
+    if (P == defaultPool)
+        defaultPool = NULL;
+    free(P);
+}
+
+LexemeId internString(InternPool *P, const char *s, int len)
+{
+    if (len <= 0)
+        return LEXEME_EMPTY;
+
+    uint32_t h = hashBytes(s, len);
+    uint32_t i = h & (P->slotCount - 1);
+    while (P->slots[i] != 0)
+    {
+        uint32_t id = P->slots[i];
+        if (P->hash[id] == h && P->length[id] == (uint32_t)len && memcmp(P->text[id], s, len) == 0)
+            return id;
+        i = (i + 1) & (P->slotCount - 1);
+    }
+
+    if (P->count == P->capacity)
+        growEntries(P);
+
+    char *copy = arenaAlloc(P, (size_t)len + 1);
+    memcpy(copy, s, len);
+    copy[len] = '\0';
+
+    LexemeId id = P->count++;
+    P->text[id] = copy;
+    P->length[id] = (uint32_t)len;
+    P->hash[id] = h;
+    P->value[id] = NAN;
+    P->slots[i] = id;
+
+    // Keep the load factor at or below one half
+    if (P->count * 2 > P->slotCount)
+        growSlots(P);
+    return id;
+}
+
+const char *internedString(const InternPool *P, LexemeId id)
+{
+    return P->text[id];
+}
+
+int internedLength(const InternPool *P, LexemeId id)
+{
+    return (int)P->length[id];
+}
+
+double internedValue(const InternPool *P, LexemeId id)
+{
+    return P->value[id];
+}
+
+void setInternedValue(InternPool *P, LexemeId id, double value)
+{
+    P->value[id] = value;
+}
+
+InternPool *lexemePool(void)
+{
+    if (!defaultPool)
+        defaultPool = createInternPool(1024);
+    return defaultPool;
+}
+
+const char *lexemeText(LexemeId id)
+{
+    return lexemePool()->text[id];
+}
+
+void releaseLexemePool(void)
+{
+    if (defaultPool)
+        destroyInternPool(defaultPool);
+    defaultPool = NULL;
+}
@@ -0,0 +1,49 @@
+#ifndef INTERN_H
+#define INTERN_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*-------------------
+   Lexeme Handles
+  -------------------*/
+/* 32-bit handle to an interned string; equal strings share one handle */
+typedef uint32_t LexemeId;
+
+#define LEXEME_EMPTY 0 // Handle of "", also used for "not interned yet"
+
+/*-------------------
+   Intern Pool Structure
+  -------------------*/
+typedef struct ArenaBlock ArenaBlock;
+
+typedef struct
+{
+  ArenaBlock *blocks;  // Arena blocks holding the NUL-terminated strings
+  const char **text;   // Handle -> string
+  uint32_t *length;    // Handle -> string length
+  uint32_t *hash;      // Handle -> cached hash
+  double *value;       // Handle -> numeric value, NAN until the lexer caches one
+  uint32_t count;      // Number of handles issued (including LEXEME_EMPTY)
+  uint32_t capacity;   // Allocated entries in text/length/hash
+  uint32_t *slots;     // Open addressing hash set of handles, 0 = free
+  uint32_t slotCount;  // Size of slots (power of two)
+} InternPool;
+
+/*-------------------
+   Function Prototypes
+  -------------------*/
+InternPool *createInternPool(int expectedStrings);
+void destroyInternPool(InternPool *P);
+LexemeId internString(InternPool *P, const char *s, int len);
+const char *internedString(const InternPool *P, LexemeId id);
+int internedLength(const InternPool *P, LexemeId id);
+double internedValue(const InternPool *P, LexemeId id);
+void setInternedValue(InternPool *P, LexemeId id, double value);
+
+/* Per-thread pool shared by the lexer and the parse tree */
+InternPool *lexemePool(void);
+const char *lexemeText(LexemeId id);
+void releaseLexemePool(void);
+
+#endif /* INTERN_H */
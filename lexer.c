@@ -16,12 +16,16 @@
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <math.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include "lexer.h"
+#include "lexerDef.h"
 
 #define FUNMAX 30 ///< Maximum length for function identifiers
 #define VARMAX 20 ///< Maximum length for variable identifiers
-
-int cnt = 0; ///< Global counter for tokens
+#define LEX_RELEASE_CHUNK (1L << 22) ///< Mapped input a lexer drops at a time
 
 /**
  * @brief Creates a twin buffer for reading from a source file.
@@ -32,6 +36,32 @@ int cnt = 0; ///< Global counter for tokens
  */
 twinBuffer *createTwinBuffer(FILE *source, int bufSize);
 
+/**
+ * @brief Maps a regular source file into memory as a single read-only buffer.
+ * 
+ * The whole file becomes buffer 0 and is followed by a zero guard byte that
+ * acts as the EOF sentinel, so the scanner never refills or switches buffers
+ * and retraction is plain index arithmetic.
+ * 
+ * Token offsets are 32-bit, so a file larger than LEX_MAX_SOURCE is an error
+ * and the program exits.
+ *
+ * @param source The source file; must be a non-empty regular file.
+ * @return twinBuffer* The mapped buffer, or NULL if the file cannot be mapped.
+ */
+twinBuffer *createMappedBuffer(FILE *source);
+
+/**
+ * @brief Opens the best input buffer for a source file.
+ * 
+ * Regular files are memory-mapped; pipes, terminals and empty files fall back
+ * to the twin buffer.
+ * 
+ * @param source The source file to read from.
+ * @return twinBuffer* The created buffer, or NULL on failure.
+ */
+twinBuffer *openSourceBuffer(FILE *source);
+
 /**
  * @brief Destroys a twin buffer and frees associated memory.
  * 
@@ -71,6 +101,14 @@ int getNextCharFromBuffer(twinBuffer *B);
  */
 void retract(twinBuffer *B, int n);
 
+/**
+ * @brief Returns the source offset of the next character to be read.
+ * 
+ * @param B The twin buffer.
+ * @return long Offset from the beginning of the source.
+ */
+long bufferPosition(twinBuffer *B);
+
 /**
  * @brief Looks up a lexeme in the keyword table.
  * 
@@ -79,9 +117,20 @@ void retract(twinBuffer *B, int n);
  */
 TokenType lookupKeyword(const char *lex);
 
+/**
+ * @brief Looks up a lexeme of known length in the keyword perfect hash.
+ * 
+ * @param lex The lexeme (need not be NUL-terminated).
+ * @param len Its length.
+ * @return TokenType The keyword's token type, or TK_ID.
+ */
+TokenType lookupKeywordLen(const char *lex, int len);
+
 /**
  * @brief Gets the next state based on the current character and state.
  * 
+ * The transition is a single lookup in the tables generated from lexer.spec.
+ * 
  * @param c The current character.
  * @param current_state The current state.
  * @return int The next state.
@@ -100,49 +149,188 @@ int getStateDetails(twinBuffer *B, int state);
 /**
  * @brief Performs actions based on the current state and updates the token.
  * 
+ * @param L The lexer, whose line counter advances on newline states.
  * @param token The token to update.
  * @param state The current state.
  */
-void doStateActions(Token *token, int state);
+void doStateActions(Lexer *L, Token *token, int state);
 
 /**
- * @brief Retrieves the next token from the twin buffer.
+ * @brief Retrieves the next token from a lexer's buffer.
  * 
- * @param B The twin buffer.
+ * The scanner walks the DFA iteratively and records the lexeme as a
+ * (start, length) span over the input; the characters are only interned into
+ * token->lexeme by copyLexeme(), or eagerly when a keyword lookup needs them.
+ * 
+ * @param L The lexer.
  * @param token The token to update.
- * @param pos The current position in the lexeme.
  */
-void getNextToken(twinBuffer *B, Token *token, int pos);
+void getNextToken(Lexer *L, Token *token);
+
+/**
+ * @brief Interns the lexeme span of a token into the lexeme pool.
+ * 
+ * Must be called before the next getNextToken() on the same lexer. Does
+ * nothing if the lexeme has already been interned.
+ * 
+ * @param L The lexer the token was read from.
+ * @param token The token whose lexeme is filled in.
+ */
+void copyLexeme(Lexer *L, Token *token);
 
 /**
- * @brief Prints a token to standard output.
+ * @brief Returns a pointer to a token's lexeme inside a mapped source.
+ * 
+ * The lexeme is not NUL-terminated; use token->length. Only mapped buffers
+ * keep the whole source resident, so twin buffers return NULL.
+ * 
+ * @param L The lexer the token was read from.
+ * @param token The token.
+ * @return const char* Start of the lexeme, or NULL when not mapped.
+ */
+const char *lexemeStart(Lexer *L, const Token *token);
+
+/**
+ * @brief Prints a token.
  * 
  * @param t The token to print.
+ * @param out Where to print it, e.g. stdout.
  */
-void printToken(Token *t);
+void printToken(Token *t, FILE *out);
 
 /**
  * @brief Driver function to tokenize a file and optionally print tokens.
  * 
  * @param fn The filename to tokenize.
- * @param printFlag Flag to indicate whether to print tokens.
+ * @param out Where to print the tokens, or NULL to only tokenize.
  */
-void driverToken(char *fn, int printFlag);
+void driverToken(char *fn, FILE *out);
 
 /**
- * @brief Gets the number of tokens processed.
+ * @brief Retrieves an array of tokens from a file.
  * 
- * @return int The number of tokens.
+ * Expands the compact token stream into full Token structs; the parser reads
+ * the stream directly through tokenAt() instead.
+ * 
+ * @param fn The filename to tokenize.
+ * @param count Set to the number of tokens.
+ * @return Token* Pointer to the array of tokens, owned by the caller.
  */
-int getnooftokens();
+Token *getarrayoftokens(char *fn, uint32_t *count);
 
 /**
- * @brief Retrieves an array of tokens from a file.
+ * @brief Creates an empty token stream.
  * 
- * @param fn The filename to tokenize.
- * @return Token* Pointer to the array of tokens.
+ * @param capacity Initial number of token slots (grown on demand).
+ * @return TokenStream* Pointer to the created stream.
+ */
+TokenStream *createTokenStream(uint32_t capacity);
+
+/**
+ * @brief Destroys a token stream and frees its token arrays.
+ * 
+ * @param S The token stream to destroy.
+ */
+void destroyTokenStream(TokenStream *S);
+
+/**
+ * @brief Appends a token to the stream, doubling its capacity when full.
+ * 
+ * @param S The token stream.
+ * @param t The token to append.
+ */
+void pushToken(TokenStream *S, const Token *t);
+
+/**
+ * @brief Returns the source line of the i-th token of a stream.
+ * 
+ * Binary search over the line table, which has one entry per line on which
+ * tokens start.
+ * 
+ * @param S The token stream.
+ * @param i Index of the token.
+ * @return int The line number.
+ */
+int tokenLine(const TokenStream *S, uint32_t i);
+
+/**
+ * @brief Rebuilds the i-th token of a stream as a Token.
+ * 
+ * @param S The token stream.
+ * @param i Index of the token.
+ * @param t Filled with the token's fields.
+ */
+void tokenAt(const TokenStream *S, uint32_t i, Token *t);
+
+/**
+ * @brief Lexes a file exactly once and collects every token into a stream.
+ * 
+ * Whitespace and newlines are dropped; comments and erroneous lexemes are kept
+ * so callers can report them.
+ * Regular files are memory-mapped, anything else goes through the twin buffer.
+ * 
+ * @param fn The filename to tokenize, or "-" for standard input.
+ * @return TokenStream* The lexed tokens and their count.
+ */
+TokenStream *tokenizeFile(char *fn);
+
+/**
+ * @brief Lexes a source held in memory and collects every token into a stream.
+ * 
+ * The tokens are the ones tokenizeFile() returns for a file with these bytes.
+ * 
+ * @param text The source.
+ * @param length Length of the source in bytes.
+ * @return TokenStream* The lexed tokens and their count.
+ */
+TokenStream *tokenizeText(const char *text, size_t length);
+
+/**
+ * @brief Creates a lexer over an open stream.
+ * 
+ * Tokens are lexed on demand as the consumer asks for them, and at most
+ * LEX_LOOKAHEAD of them are held at a time. Whitespace and newlines are
+ * dropped exactly as in tokenizeFile(). The stream stays owned by the caller.
+ * 
+ * @param source The stream to lex; regular files are memory-mapped.
+ * @return Lexer* The lexer, positioned before the first token on line 1.
+ */
+Lexer *createLexer(FILE *source);
+
+/**
+ * @brief Opens a file and creates a lexer that owns it.
+ * 
+ * @param fn The filename to lex, or "-" for standard input.
+ * @return Lexer* The lexer, positioned before the first token.
+ */
+Lexer *openLexer(char *fn);
+
+/**
+ * @brief Destroys a lexer, its buffer and, if it owns it, its stream.
+ * 
+ * @param L The lexer to destroy.
+ */
+void destroyLexer(Lexer *L);
+
+/**
+ * @brief Looks ahead without consuming input.
+ * 
+ * @param L The lexer.
+ * @param k Distance ahead of the next token (0 is the next token); must be
+ *          less than LEX_LOOKAHEAD.
+ * @return const Token* The token, or NULL if the input ends before it. Valid
+ *         until the next readToken().
+ */
+const Token *peekToken(Lexer *L, int k);
+
+/**
+ * @brief Consumes the next token.
+ * 
+ * @param L The lexer.
+ * @param t Filled with the token.
+ * @return int 1 if a token was read, 0 at end of input.
  */
-Token *getarrayoftokens(char *fn);
+int readToken(Lexer *L, Token *t);
 
 /**
  * @brief Removes comments from a source file and writes the result to a clean file.
@@ -167,6 +355,10 @@ twinBuffer *createTwinBuffer(FILE *source, int bufSize)
     B->bufferSize = bufSize;
     B->currentBuffer = 0;
     B->forwardPointer = 0;
+    B->bufferOffset = 0;
+    B->nextLoaded = 0;
+    B->eofPending = 0;
+    B->mappedSize = 0;
 
     // Allocate and initialize the two buffers
     B->buffers = (char **)malloc(2 * sizeof(char *));
@@ -188,7 +380,7 @@ twinBuffer *createTwinBuffer(FILE *source, int bufSize)
     }
 
     // For storing number of chars read into each buffer
-    B->charsInBuffer = (int *)malloc(2 * sizeof(int));
+    B->charsInBuffer = (long *)malloc(2 * sizeof(long));
     if (!B->charsInBuffer)
     {
         free(B->buffers[0]);
@@ -203,7 +395,7 @@ twinBuffer *createTwinBuffer(FILE *source, int bufSize)
     // Pre-load the first buffer so we are ready to read
     size_t bytesRead = fread(B->buffers[0], sizeof(char), B->bufferSize, B->source);
     B->buffers[0][bytesRead] = EOF_SENTINEL;
-    B->charsInBuffer[0] = (int)bytesRead;
+    B->charsInBuffer[0] = (long)bytesRead;
 
     // The second buffer will be loaded lazily (on demand)
     B->buffers[1][0] = EOF_SENTINEL;
@@ -212,11 +404,76 @@ twinBuffer *createTwinBuffer(FILE *source, int bufSize)
     return B;
 }
 
+twinBuffer *createMappedBuffer(FILE *source)
+{
+    struct stat st;
+    if (!source || fstat(fileno(source), &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0)
+        return NULL;
+
+    if ((unsigned long long)st.st_size > LEX_MAX_SOURCE)
+    {
+        fprintf(stderr, "Source of %lld bytes is too large: the lexer reads at most %lu bytes\n", (long long)st.st_size, LEX_MAX_SOURCE);
+        exit(EXIT_FAILURE);
+    }
+
+    size_t size = (size_t)st.st_size;
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t mappedSize = (size + 1 + page - 1) / page * page; // room for the guard sentinel
+
+    // Reserve zero-filled pages, then map the file over the front of them
+    char *base = mmap(NULL, mappedSize, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED)
+        return NULL;
+    if (mmap(base, size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fileno(source), 0) == MAP_FAILED)
+    {
+        munmap(base, mappedSize);
+        return NULL;
+    }
+    madvise(base, size, MADV_SEQUENTIAL);
+
+    twinBuffer *B = (twinBuffer *)calloc(1, sizeof(twinBuffer));
+    char **buffers = (char **)malloc(2 * sizeof(char *));
+    long *charsInBuffer = (long *)malloc(2 * sizeof(long));
+    if (!B || !buffers || !charsInBuffer)
+    {
+        free(B);
+        free(buffers);
+        free(charsInBuffer);
+        munmap(base, mappedSize);
+        return NULL;
+    }
+
+    B->source = source;
+    B->buffers = buffers;
+    B->buffers[0] = base;
+    B->buffers[1] = NULL;
+    B->charsInBuffer = charsInBuffer;
+    B->charsInBuffer[0] = (long)size;
+    B->charsInBuffer[1] = 0;
+    // One past the data, so the guard byte always reads as a partial buffer (EOF)
+    B->bufferSize = (long)size + 1;
+    B->mappedSize = mappedSize;
+    return B;
+}
+
+twinBuffer *openSourceBuffer(FILE *source)
+{
+    twinBuffer *B = createMappedBuffer(source);
+    if (!B)
+        B = createTwinBuffer(source, BUFFER_SIZE);
+    return B;
+}
+
 void destroyTwinBuffer(twinBuffer *B)
 {
     if (!B)
         return;
-    if (B->buffers)
+    if (B->mappedSize)
+    {
+        munmap(B->buffers[0], B->mappedSize);
+        free(B->buffers);
+    }
+    else if (B->buffers)
     {
         free(B->buffers[0]);
         free(B->buffers[1]);
@@ -240,7 +497,7 @@ static int loadBuffer(twinBuffer *B, int whichBuffer)
                              B->source);
 
     B->buffers[whichBuffer][bytesRead] = EOF_SENTINEL;
-    B->charsInBuffer[whichBuffer] = (int)bytesRead;
+    B->charsInBuffer[whichBuffer] = (long)bytesRead;
 
     return (int)bytesRead;
 }
@@ -250,11 +507,21 @@ static void switchBuffer(twinBuffer *B)
         return;
 
     // Flip between 0 and 1
+    B->bufferOffset += B->charsInBuffer[B->currentBuffer];
+    // Pipes have no size up front, so the limit of createMappedBuffer() is checked as they are read
+    if ((unsigned long)B->bufferOffset > LEX_MAX_SOURCE)
+    {
+        fprintf(stderr, "Source is too large: the lexer reads at most %lu bytes\n", LEX_MAX_SOURCE);
+        exit(EXIT_FAILURE);
+    }
     B->currentBuffer = 1 - B->currentBuffer;
     B->forwardPointer = 0;
 
-    // Load the new active buffer
-    loadBuffer(B, B->currentBuffer);
+    // Load the new active buffer, unless a retraction left its data in place
+    if (B->nextLoaded)
+        B->nextLoaded = 0;
+    else
+        loadBuffer(B, B->currentBuffer);
 }
 int getNextCharFromBuffer(twinBuffer *B)
 {
@@ -263,19 +530,25 @@ int getNextCharFromBuffer(twinBuffer *B)
 
     char ch = B->buffers[B->currentBuffer][B->forwardPointer];
 
-    // If sentinel, check if real EOF or switch buffer
-    if (ch == EOF_SENTINEL)
+    // If sentinel at the end of the data, check if real EOF or switch buffer
+    if (ch == EOF_SENTINEL && B->forwardPointer == B->charsInBuffer[B->currentBuffer])
     {
         // Check if partial read => real EOF
         if (B->charsInBuffer[B->currentBuffer] < B->bufferSize)
+        {
+            B->eofPending = 1;
             return EOF;
+        }
 
         // Otherwise, switch buffer
         switchBuffer(B);
         ch = B->buffers[B->currentBuffer][B->forwardPointer];
 
         if (ch == EOF_SENTINEL)
+        {
+            B->eofPending = 1;
             return EOF;
+        }
     }
 
     B->forwardPointer++;
@@ -287,12 +560,21 @@ void retract(twinBuffer *B, int n)
     if (!B)
         return;
 
+    // EOF was never consumed, so pushing it back costs nothing
+    if (B->eofPending && n > 0)
+    {
+        B->eofPending = 0;
+        n--;
+    }
+
     B->forwardPointer -= n;
     if (B->forwardPointer < 0)
     {
-        // Switch back to the other buffer
+        // Switch back to the other buffer; the one we leave stays valid
         B->currentBuffer = 1 - B->currentBuffer;
         B->forwardPointer = B->charsInBuffer[B->currentBuffer] + B->forwardPointer;
+        B->bufferOffset -= B->charsInBuffer[B->currentBuffer];
+        B->nextLoaded = 1;
 
         if (B->forwardPointer < 0)
         {
@@ -302,442 +584,59 @@ void retract(twinBuffer *B, int n)
     }
 }
 
-// We also keep a global line number
-static int lineNo = 1;
-static int current_s = 0;
+long bufferPosition(twinBuffer *B)
+{
+    return B->bufferOffset + B->forwardPointer;
+}
 
 //------------------------------------
 // 4. Keyword/Token Lookup
 //------------------------------------
-typedef struct
+/*
+ * Keywords come from lexer.spec; lexgen finds associated byte values that make
+ * this hash collision-free over them, so a lookup is one probe plus one compare.
+ */
+static inline unsigned keywordHash(const char *lex, int len)
+{
+    return (len + lexKeywordAsso[(unsigned char)lex[0]] + lexKeywordAsso[(unsigned char)lex[len > 1]] +
+            lexKeywordAsso[(unsigned char)lex[len - 1]]) & (LEX_KEYWORD_HASH_SIZE - 1);
+}
+
+TokenType lookupKeywordLen(const char *lex, int len)
 {
-    const char *lexeme;
-    TokenType type;
-} KeywordEntry;
-
-static KeywordEntry keywordTable[] = {
-    {"else", TK_ELSE},
-    {"with", TK_WITH},
-    {"parameters", TK_PARAMETERS},
-    {"output", TK_OUTPUT},
-    {"int", TK_INT},
-    {"read", TK_READ},
-    {"write", TK_WRITE},
-    {"return", TK_RETURN},
-    {"then", TK_THEN},
-    {"real", TK_REAL},
-    {"endwhile", TK_ENDWHILE},
-    {"if", TK_IF},
-    {"type", TK_TYPE},
-    {"_main", TK_MAIN},
-    {"global", TK_GLOBAL},
-    {"endif", TK_ENDIF},
-    {"endunion", TK_ENDUNION},
-    {"definetype", TK_DEFINETYPE},
-    {"as", TK_AS},
-    {"call", TK_CALL},
-    {"record", TK_RECORD},
-    {"endrecord", TK_ENDRECORD},
-    {"parameter", TK_PARAMETER},
-    {"end", TK_END},
-    {"while", TK_WHILE},
-    {"union", TK_UNION},
-    {"list", TK_LIST},
-    {"input", TK_INPUT},
-    {NULL, TK_ID} // Sentinel
-};
+    if (len < 1 || len > LEX_KEYWORD_MAX_LEN)
+        return TK_ID;
+
+    unsigned h = keywordHash(lex, len);
+    if (lexKeywordLength[h] == len && memcmp(lex, lexKeywordText[h], len) == 0)
+        return (TokenType)lexKeywordType[h];
+    return TK_ID; // default
+}
 
 // Look up a lexeme in the keyword table
 TokenType lookupKeyword(const char *lex)
 {
-    for (int i = 0; keywordTable[i].lexeme != NULL; i++)
-    {
-        if (strcmp(lex, keywordTable[i].lexeme) == 0)
-            return keywordTable[i].type;
-    }
-    return TK_ID; // default
+    return lookupKeywordLen(lex, (int)strlen(lex));
 }
 
-// 5000.703?
 int getState(char c, int current_state)
 {
-
-    if (current_state == 0)
-        switch (c)
-        {
-        case '%':
-            return 1;
-        case EOF:
-        case 255: // linux only EOF
-            return 3;
-        case '*':
-            return 4;
-        case '&':
-            return 5;
-        case '~':
-            return 8;
-        case '\n':
-            return 9;
-        case '@':
-            return 10;
-        case '[':
-            return 13;
-        case '-':
-            return 14;
-        case '+':
-            return 15;
-        case '(':
-            return 16;
-        case '=':
-            return 17;
-        case ')':
-            return 19;
-        case ';':
-            return 20;
-        case ':':
-            return 21;
-        case '!':
-            return 22;
-        case '/':
-            return 24;
-        case '.':
-            return 25;
-        case ']':
-            return 26;
-        case '\t':
-        case ' ':
-            return 27;
-        case '0':
-        case '1':
-        case '2':
-        case '3':
-        case '4':
-        case '5':
-        case '6':
-        case '7':
-        case '8':
-        case '9':
-            return 29;
-        case '#':
-            return 40;
-        case '_':
-            return 43;
-        case ',':
-            return 64;
-
-        case 'b':
-        case 'c':
-        case 'd':
-            return 47;
-
-        case 'a':
-        case 'e':
-        case 'f':
-        case 'g':
-        case 'h':
-        case 'i':
-        case 'j':
-        case 'k':
-        case 'l':
-        case 'm':
-        case 'n':
-        case 'o':
-        case 'p':
-        case 'q':
-        case 'r':
-        case 's':
-        case 't':
-        case 'u':
-        case 'v':
-        case 'w':
-        case 'x':
-        case 'y':
-        case 'z':
-            return 48;
-        case '>':
-            return 54;
-        case '<':
-            return 57;
-        default:
-            return TRAP_STATE;
-        }
-    else
-    {
-
-        if (current_state == 1)
-        {
-            if (c == '\n')
-                return 2;
-            else
-                return 1;
-        }
-        if (current_state == 5 && c == '&')
-            return 6;
-        if (current_state == 6 && c == '&')
-            return 7;
-        if (current_state == 10 && c == '@')
-            return 11;
-        if (current_state == 11 && c == '@')
-            return 12;
-        if (current_state == 17 && c == '=')
-            return 18;
-        if (current_state == 22 && c == '=')
-            return 23;
-        if (current_state == 27)
-        {
-            if (c == '\t' || c == ' ')
-            {
-                return 27;
-            }
-            else
-                return 28;
-        }
-        if (current_state == 29)
-        {
-            if (c >= '0' && c <= '9')
-                return 29;
-            else if (c == '.')
-                return 30;
-            else
-                return 39;
-        }
-        if (current_state == 30)
-        {
-            if (c >= '0' && c <= '9')
-                return 31;
-            else
-                return 38;
-        }
-        if (current_state == 31 && c >= '0' && c <= '9')
-            return 32;
-
-        if (current_state == 32)
-        {
-            if (c == 'E' || c == 'e')
-                return 33;
-            else
-                return 37;
-        }
-        if (current_state == 33)
-        {
-            if (c == '+' || c == '-')
-            {
-                return 34;
-            }
-            else if (c >= '0' && c <= '9')
-            {
-                return 35;
-            }
-        }
-
-        if (current_state == 34)
-        {
-            if (c >= '0' && c <= '9')
-            {
-                return 35;
-            }
-        }
-
-        if (current_state == 35)
-        {
-            if (c >= '0' && c <= '9')
-            {
-                return 36;
-            }
-        }
-
-        if (current_state == 40 && c >= 'a' && c <= 'z')
-        {
-            return 41;
-        }
-        if (current_state == 41)
-        {
-            if (c >= 'a' && c <= 'z')
-                return 41;
-            else
-                return 42;
-        }
-
-        if (current_state == 43 && ((c >= 'a' && c <= 'z') || c >= 'A' && c <= 'Z'))
-        {
-            return 44;
-        }
-
-        if (current_state == 44)
-        {
-            if (((c >= 'a' && c <= 'z') || c >= 'A' && c <= 'Z'))
-                return 44;
-            else if (c >= '0' && c <= '9')
-                return 45;
-            else
-                return 46;
-        }
-
-        if (current_state == 45)
-        {
-            if (c >= '0' && c <= '9')
-            {
-                return 45;
-            }
-            else
-            {
-                return 46;
-            }
-        }
-
-        if (current_state == 47)
-        {
-            if (c >= 'a' && c <= 'z')
-            {
-                return 48;
-            }
-            else if (c >= '2' && c <= '7')
-            {
-                return 50;
-            }
-            else
-            {
-                return 53;
-            }
-        }
-        if (current_state == 48)
-        {
-            if (c >= 'a' && c <= 'z')
-            {
-                return 48;
-            }
-            else
-            {
-                return 49;
-            }
-        }
-
-        if (current_state == 50)
-        {
-            if (c >= 'b' && c <= 'd')
-            {
-                return 50;
-            }
-            else if (c >= '2' && c <= '7')
-            {
-                return 51;
-            }
-            else
-                return 52;
-        }
-
-        if (current_state == 51)
-        {
-            if (c >= '2' && c <= '7')
-            {
-                return 51;
-            }
-            else
-                return 52;
-        }
-        if (current_state == 54)
-        {
-            if (c == '=')
-            {
-                return 55;
-            }
-            else
-                return 56;
-        }
-        if (current_state == 57)
-        {
-            if (c == '=')
-            {
-                return 58;
-            }
-            else if (c == '-')
-            {
-                return 59;
-            }
-            else
-                return 63;
-        }
-
-        if (current_state == 59)
-        {
-            if (c == '-')
-            {
-                return 60;
-            }
-            else
-            {
-                return 62;
-            }
-        }
-        if (current_state == 60)
-        {
-            if (c == '-')
-            {
-                return 61;
-            }
-            else
-            {
-                return TRAP_STATE;
-            }
-        }
-        return TRAP_STATE; // trap state TK_ERR
-    }
+    return lexTransition[current_state][lexCharClass[(unsigned char)c]];
 }
 
 int getStateDetails(twinBuffer *B, int state)
 {
-    switch (state)
-    {
-    case 2:
-    case 3:
-    case 4:
-    case 7:
-    case 8:
-    case 9:
-    case 12:
-    case 13:
-    case 14:
-    case 15:
-    case 16:
-    case 18:
-    case 19:
-    case 20:
-    case 21:
-    case 23:
-    case 24:
-    case 25:
-    case 26:
-    case 64:
-    case 36:
-    case 55:
-    case 58:
-    case 61:
-        return FINAL_NO_RETRACT; // non retracting state
-    case 28:
-    case 37:
-    case 39:
-    case 42:
-    case 46:
-    case 49:
-    case 52:
-    case 53:
-    case 56:
-    case 63:
+    int detail = lexStateDetail[state];
+    if (detail == FINAL_RETRACTONCE)
         retract(B, 1);
-        return FINAL_RETRACTONCE; // once retracting state
-    case 38:
-    case 62:
+    else if (detail == FINAL_RETRACTTWICE)
         retract(B, 2);
-        return FINAL_RETRACTTWICE; // twice retracting state
-
-    default:
-        return NON_FINAL; // not final state
-    }
+    return detail;
 }
 
 void token_fun(Token *token)
 {
-    token->type = lookupKeyword(token->lexeme);
+    token->type = lookupKeywordLen(lexemeText(token->lexeme), token->length);
     if (token->type == TK_ID)
     {
         token->type = TK_FIELDID;
@@ -745,337 +644,503 @@ void token_fun(Token *token)
 }
 void id_fun(Token *token)
 {
-    token->type = lookupKeyword(token->lexeme); // checking for _main else
+    token->type = lookupKeywordLen(lexemeText(token->lexeme), token->length); // checking for _main else
     if (token->type == TK_ID)
     {
         token->type = TK_FUNID;
     }
 }
-void doStateActions(Token *token, int state)
+void doStateActions(Lexer *L, Token *token, int state)
 {
-    switch (state)
-    {
-    /* Non‐retracting final states */
-    case 2:
-        lineNo++;
-        token->type = TK_COMMENT;
-        break;
+    if (lexStateFlags[state] & LEX_FLAG_NEWLINE)
+        L->lineNo++;
 
-    case 4:
-        token->type = TK_MUL;
+    switch (lexStateAction[state])
+    {
+    case LEX_TOKEN:
+        token->type = (TokenType)lexStateToken[state];
         break;
-    case 7:
-        token->type = TK_AND;
+    case LEX_FUNID:
+        id_fun(token);
         break;
-    case 8:
-        token->type = TK_NOT;
+    case LEX_FIELDID:
+        token_fun(token);
         break;
-    case 9:
-        lineNo++;
+    case LEX_SKIP:
+        // Whitespace or newline – do not return a token.
         token->cat = CONTINUE;
-        return;
-    case 12:
-        token->type = TK_OR;
-        break;
-    case 13:
-        token->type = TK_SQL;
-        break;
-    case 14:
-        token->type = TK_MINUS;
-        break;
-    case 15:
-        token->type = TK_PLUS;
-        break;
-    case 16:
-        token->type = TK_OP;
-        break;
-    case 18:
-        token->type = TK_EQ;
-        break;
-    case 19:
-        token->type = TK_CL;
-        break;
-    case 20:
-        token->type = TK_SEM;
-        break;
-    case 21:
-        token->type = TK_COLON;
-        break;
-    case 23:
-        token->type = TK_NE;
-        break;
-    case 24:
-        token->type = TK_DIV;
-        break;
-    case 25:
-        token->type = TK_DOT;
-        break;
-    case 26:
-        token->type = TK_SQR;
-        break;
-
-    case 64:
-        token->type = TK_COMMA;
-        break;
-    case 36:
-        token->type = TK_RNUM;
-        break;
-    case 55:
-        token->type = TK_GE;
-        break;
-    case 56:
-        token->type = TK_GT;
-        break;
-    case 58:
-        token->type = TK_LE;
         break;
-    case 61:
-        token->type = TK_ASSIGNOP;
-        break;
-
-    case 37:
-        token->type = TK_RNUM;
-        break;
-    case 38:
-        token->type = TK_NUM;
+    case LEX_EXIT:
+        // EOF token
+        token->cat = EXIT;
         break;
-    case 39:
-        token->type = TK_NUM;
+    default:
+        token->cat = ERROR;
         break;
+    }
+}
 
-    case 42:
-        token->type = TK_RUID;
-        break;
+void copyLexeme(Lexer *L, Token *token)
+{
+    twinBuffer *B = L->B;
+    if (token->lexeme != LEXEME_EMPTY)
+        return;
 
-    case 52:
-        token->type = TK_ID;
-        break;
-    case 53:
-        token->type = TK_FIELDID;
-        break;
+    int length = token->length < BUFFER_SIZE - 1 ? token->length : BUFFER_SIZE - 1;
 
-    case 62:
-        token->type = TK_LT;
-        break;
-    case 63:
-        token->type = TK_LT;
-        break;
+    // A mapped source is resident, so the span is interned in place
+    const char *mapped = lexemeStart(L, token);
+    if (mapped)
+    {
+        token->lexeme = internString(lexemePool(), mapped, length);
+        return;
+    }
 
-    case 46:
-        id_fun(token);
-        break;
-    case 49:
-        token_fun(token);
-        break;
+    char scratch[BUFFER_SIZE];
+    long offset = token->start - B->bufferOffset;
+    int copied = 0;
 
-    case 3:
-        // EOF token
-        token->cat = EXIT;
-        return;
-    case 28:
-        // Whitespace token – do not return a token.
-        token->cat = CONTINUE;
-        return;
-    default:
-        token->cat = ERROR;
-        break;
+    // Part of the lexeme that still sits in the previous buffer
+    if (offset < 0)
+    {
+        int other = 1 - B->currentBuffer;
+        long from = B->charsInBuffer[other] + offset;
+        copied = (int)-offset < length ? (int)-offset : length;
+        memcpy(scratch, B->buffers[other] + from, copied);
+        offset = 0;
     }
+    memcpy(scratch + copied, B->buffers[B->currentBuffer] + offset, length - copied);
+    token->lexeme = internString(lexemePool(), scratch, length);
+}
 
-    return;
+const char *lexemeStart(Lexer *L, const Token *token)
+{
+    twinBuffer *B = L->B;
+    return B->mappedSize ? B->buffers[0] + token->start : NULL;
 }
 
-void getNextToken(twinBuffer *B, Token *token, int pos)
+void getNextToken(Lexer *L, Token *token)
 {
-    char ch = getNextCharFromBuffer(B);
-    int nextState = getState(ch, current_s);
+    twinBuffer *B = L->B;
+    int state = LEX_START_STATE;
+    int pos = 0; // Lexeme length so far
+
+    token->start = bufferPosition(B);
+    token->length = 0;
+    token->lexeme = LEXEME_EMPTY;
 
-    // Very weird logic i dont know why i did this
-    if (nextState == TRAP_STATE)
+    while (1)
     {
-        if (pos >= 1)
-        {
-            retract(B, 1);
-        }
-        else
+        char ch = getNextCharFromBuffer(B);
+        int nextState = lexTransition[state][lexCharClass[(unsigned char)ch]];
+
+        if (nextState == TRAP_STATE)
         {
-            token->lexeme[pos] = ch;
-            token->lexeme[++pos] = '\0';
+            // Keep what was read so far, or the offending character alone
+            if (pos >= 1)
+                retract(B, 1);
+            else
+                pos = 1;
+
+            token->length = pos;
+            token->cat = ERROR;
+            return;
         }
 
-        token->cat = ERROR;
-        return;
-    }
+        int stateDetail = getStateDetails(B, nextState);
+
+        // only extend the lexeme if not in final retract state
+        if (!(lexStateFlags[state] & LEX_FLAG_NOAPPEND) &&
+            stateDetail != FINAL_RETRACTONCE && stateDetail != FINAL_RETRACTTWICE)
+            pos++;
+
+        if (stateDetail == FINAL_RETRACTTWICE)
+            pos--;
+
+        if (stateDetail != NON_FINAL)
+        {
+            token->length = pos;
+            if (lexStateAction[nextState] == LEX_FUNID || lexStateAction[nextState] == LEX_FIELDID)
+                copyLexeme(L, token);
 
-    int stateDetail = getStateDetails(B, nextState);
+            doStateActions(L, token, nextState);
+            if (lexStateAction[nextState] != LEX_SKIP)
+            {
+                if ((token->type == TK_FUNID && pos >= FUNMAX) || (token->type == TK_ID && pos >= VARMAX))
+                    token->cat = LENGTHEXCEEDED;
+            }
+            return;
+        }
 
-    // only add to lexeme if not in final retract state
-    if (!(current_s == 1 && pos >= 1))
-        if (stateDetail != FINAL_RETRACTONCE && stateDetail != FINAL_RETRACTTWICE)
+        // Copy early whatever could be overwritten before the token ends:
+        // comment prefixes and lexemes longer than a lexeme may be (kept truncated)
+        if (token->lexeme == LEXEME_EMPTY &&
+            ((lexStateFlags[nextState] & LEX_FLAG_NOAPPEND) || pos == BUFFER_SIZE - 1))
         {
-            token->lexeme[pos] = ch;
-            token->lexeme[++pos] = '\0';
+            token->length = pos;
+            copyLexeme(L, token);
         }
 
-    if (stateDetail == FINAL_RETRACTTWICE)
-    {
-        token->lexeme[pos - 1] = '\0';
-    }
+        state = nextState;
 
-    if (stateDetail != NON_FINAL)
-    {
-        // printf("NextState %d\n",nextState);
-        doStateActions(token, nextState);
-        if (nextState != 28)
+        // Consume the rest of a self-loop (comment body, blanks, identifier or
+        // digit run) in bulk, within the active buffer. None of these runs
+        // contains a newline, so L->lineNo is unaffected.
+        const LexRun *loop = &lexStateRun[state];
+        if (loop->kind != LEX_RUN_NONE && B->forwardPointer < B->charsInBuffer[B->currentBuffer] &&
+            lexInRun((unsigned char)B->buffers[B->currentBuffer][B->forwardPointer], loop))
         {
-            if ((token->type == TK_FUNID && pos >= FUNMAX) || (token->type == TK_ID && pos >= VARMAX))
+            int append = !(lexStateFlags[state] & LEX_FLAG_NOAPPEND);
+            long avail = B->charsInBuffer[B->currentBuffer] - B->forwardPointer;
+            // Stop where the early copy above would have to happen
+            if (append && token->lexeme == LEXEME_EMPTY && avail > BUFFER_SIZE - 1 - pos)
+                avail = BUFFER_SIZE - 1 - pos;
+
+            long run = lexRunLength(B->buffers[B->currentBuffer] + B->forwardPointer, avail, loop);
+            B->forwardPointer += run;
+            if (append)
             {
-                token->cat = LENGTHEXCEEDED;
-                return;
+                pos += (int)run;
+                if (token->lexeme == LEXEME_EMPTY && pos == BUFFER_SIZE - 1)
+                {
+                    token->length = pos;
+                    copyLexeme(L, token);
+                }
             }
         }
-
-        // printf("Line no:%d sd=%d , type = %s , STATE : %d, l = %s\n", lineNo, stateDetail, getTokenStr(token->type), nextState, token->lexeme);
-        return;
-    }
-
-    else
-    {
-        current_s = nextState;
-        getNextToken(B, token, pos);
     }
 }
 
-void printToken(Token *t)
+void printToken(Token *t, FILE *out)
 {
     if (t->cat == LENGTHEXCEEDED)
     {
         if(t->type == TK_FUNID)
-            printf("Line no. %d\t Error: Function Identifier is longer than the prescribed length of %d characters\n", t->lineNo, FUNMAX);
+            fprintf(out, "Line no. %d\t Error: Function Identifier is longer than the prescribed length of %d characters\n", t->lineNo, FUNMAX);
         else
-            printf("Line no. %d\t Error: Variable Identifier is longer than the prescribed length of %d characters\n", t->lineNo, VARMAX);
+            fprintf(out, "Line no. %d\t Error: Variable Identifier is longer than the prescribed length of %d characters\n", t->lineNo, VARMAX);
     }
     else if (t->cat == ERROR)
     {
-        printf("Line no. %d\t Error: Unknown pattern <%s> \n", t->lineNo, t->lexeme);
+        fprintf(out, "Line no. %d\t Error: Unknown pattern <%s> \n", t->lineNo, lexemeText(t->lexeme));
     }
     else
     {
         const char *tokenName = NULL;
         tokenName = getTokenStr(t->type);
-        printf("Line no. %d\t Lexeme %-10s\t Token %s\n", t->lineNo, t->lexeme, tokenName);
+        fprintf(out, "Line no. %d\t Lexeme %-10s\t Token %s\n", t->lineNo, lexemeText(t->lexeme), tokenName);
     }
 }
 
-void driverToken(char *fn,int printFlag)
+// Resize one of the stream's arrays, exiting on allocation failure
+static void *resizeArray(void *p, uint32_t count, size_t elemSize)
 {
+    void *temp = realloc(p, (size_t)count * elemSize);
+    if (!temp)
+    {
+        fprintf(stderr, "Memory allocation failed in resizeArray\n");
+        exit(EXIT_FAILURE);
+    }
+    return temp;
+}
 
-    FILE *fp = NULL;
-    fp = fopen(fn, "r");
-    if (!fp)
+// Doubles a count of slots, saturating at the largest count a uint32_t index can reach
+static uint32_t grownCapacity(uint32_t capacity)
+{
+    if (capacity == UINT32_MAX)
     {
-        perror("Failed to open file");
+        fprintf(stderr, "Token stream is full: at most %u tokens per source\n", UINT32_MAX);
         exit(EXIT_FAILURE);
     }
+    return capacity > UINT32_MAX / 2 ? UINT32_MAX : capacity * 2;
+}
 
-    lineNo = 1;
-    twinBuffer *B = createTwinBuffer(fp, BUFFER_SIZE);
+static void resizeTokenArrays(TokenStream *S, uint32_t capacity)
+{
+    S->type = (uint8_t *)resizeArray(S->type, capacity, sizeof(uint8_t));
+    S->cat = (uint8_t *)resizeArray(S->cat, capacity, sizeof(uint8_t));
+    S->offset = (uint32_t *)resizeArray(S->offset, capacity, sizeof(uint32_t));
+    S->length = (uint32_t *)resizeArray(S->length, capacity, sizeof(uint32_t));
+    S->lexeme = (LexemeId *)resizeArray(S->lexeme, capacity, sizeof(LexemeId));
+    S->capacity = capacity;
+}
 
-    if (!B)
+TokenStream *createTokenStream(uint32_t capacity)
+{
+    if (capacity == 0)
+        capacity = 64;
+
+    TokenStream *S = (TokenStream *)calloc(1, sizeof(TokenStream));
+    if (!S)
     {
-        fprintf(stderr, "Error: Unable to create twin buffer\n");
-        return;
+        fprintf(stderr, "Memory allocation failed in createTokenStream\n");
+        exit(EXIT_FAILURE);
     }
-    cnt = 0;
-    while (1)
-    {
+    resizeTokenArrays(S, capacity);
+    S->lineCapacity = 64;
+    S->lineFirst = (uint32_t *)resizeArray(NULL, S->lineCapacity, sizeof(uint32_t));
+    S->lineNumber = (uint32_t *)resizeArray(NULL, S->lineCapacity, sizeof(uint32_t));
+    return S;
+}
 
-        Token t;
-        t.lexeme[0] = '\0';
-        t.lineNo = lineNo;
-        t.cat = NORMAL;
-        // printf("%d current count of tokens \n" ,cnt);
+void destroyTokenStream(TokenStream *S)
+{
+    if (!S)
+        return;
+    free(S->type);
+    free(S->cat);
+    free(S->offset);
+    free(S->length);
+    free(S->lexeme);
+    free(S->lineFirst);
+    free(S->lineNumber);
+    free(S);
+}
 
-        getNextToken(B, &t, 0);
+void pushToken(TokenStream *S, const Token *t)
+{
+    if (S->size == S->capacity)
+        resizeTokenArrays(S, grownCapacity(S->capacity));
 
-        current_s = 0;
-        if (t.cat == EXIT)
-        {
-            break;
-        }
-        if (t.cat == CONTINUE)
+    // Start a new line run only when the line number changes
+    if (S->lineRuns == 0 || S->lineNumber[S->lineRuns - 1] != (uint32_t)t->lineNo)
+    {
+        if (S->lineRuns == S->lineCapacity)
         {
-            continue;
+            S->lineCapacity = grownCapacity(S->lineCapacity);
+            S->lineFirst = (uint32_t *)resizeArray(S->lineFirst, S->lineCapacity, sizeof(uint32_t));
+            S->lineNumber = (uint32_t *)resizeArray(S->lineNumber, S->lineCapacity, sizeof(uint32_t));
         }
-        if(printFlag)
-         printToken(&t);
-        cnt++;
+        S->lineFirst[S->lineRuns] = (uint32_t)S->size;
+        S->lineNumber[S->lineRuns] = (uint32_t)t->lineNo;
+        S->lineRuns++;
     }
 
-    destroyTwinBuffer(B);
-    fclose(fp);
+    uint32_t i = S->size++;
+    S->type[i] = (uint8_t)t->type;
+    S->cat[i] = (uint8_t)t->cat;
+    S->offset[i] = (uint32_t)t->start;
+    S->length[i] = (uint32_t)t->length;
+    S->lexeme[i] = t->lexeme;
 }
 
-/**
- * Removes all text starting from '%' until the end of the line.
- * The result is printed to standard output.
- */
+int tokenLine(const TokenStream *S, uint32_t i)
+{
+    uint32_t lo = 0, hi = S->lineRuns - 1;
+    while (lo < hi)
+    {
+        uint32_t mid = lo + (hi - lo + 1) / 2;
+        if (S->lineFirst[mid] <= i)
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+    return (int)S->lineNumber[lo];
+}
 
-int getnooftokens()
+void tokenAt(const TokenStream *S, uint32_t i, Token *t)
 {
-    return cnt;
+    t->type = (TokenType)S->type[i];
+    t->cat = (TokenCategory)S->cat[i];
+    t->lexeme = S->lexeme[i];
+    t->lineNo = tokenLine(S, i);
+    t->start = S->offset[i];
+    t->length = (int)S->length[i];
 }
 
-Token *getarrayoftokens(char *fn)
+TokenStream *tokenizeFile(char *fn)
 {
+    Lexer *L = openLexer(fn);
+    TokenStream *S = createTokenStream(256);
 
-    FILE *fp = NULL;
-    fp = fopen(fn, "r");
+    Token t;
+    while (readToken(L, &t))
+        pushToken(S, &t);
+
+    destroyLexer(L);
+    return S;
+}
+
+TokenStream *tokenizeText(const char *text, size_t length)
+{
+    TokenStream *S = createTokenStream(256);
+    // fmemopen() refuses an empty buffer; an empty source has no tokens anyway
+    if (length == 0)
+        return S;
+
+    FILE *fp = fmemopen((void *)text, length, "r");
     if (!fp)
     {
-        perror("Failed to open file");
+        perror("fmemopen");
         exit(EXIT_FAILURE);
     }
+    Lexer *L = createLexer(fp);
+    L->ownsSource = 1;
 
-    Token *temp;
-    temp = (Token *)malloc(cnt * sizeof(Token));
-    int ind = 0;
-    lineNo = 1;
-    twinBuffer *B = createTwinBuffer(fp, BUFFER_SIZE);
+    Token t;
+    while (readToken(L, &t))
+        pushToken(S, &t);
 
-    if (!B)
+    destroyLexer(L);
+    return S;
+}
+
+Lexer *createLexer(FILE *source)
+{
+    Lexer *L = (Lexer *)calloc(1, sizeof(Lexer));
+    if (!L)
+    {
+        fprintf(stderr, "Memory allocation failed in createLexer\n");
+        exit(EXIT_FAILURE);
+    }
+
+    L->source = source;
+    L->lineNo = 1;
+    L->B = openSourceBuffer(source);
+
+    if (!L->B)
     {
         fprintf(stderr, "Error: Unable to create twin buffer\n");
-        return temp;
+        exit(EXIT_FAILURE);
     }
+    return L;
+}
 
-    while (1)
+Lexer *openLexer(char *fn)
+{
+    // "-" reads the program from standard input
+    FILE *fp = NULL;
+    fp = strcmp(fn, "-") == 0 ? stdin : fopen(fn, "r");
+    if (!fp)
     {
+        perror("Failed to open file");
+        exit(EXIT_FAILURE);
+    }
 
-        Token t;
-        t.lexeme[0] = '\0';
-        t.lineNo = lineNo;
-        t.cat = NORMAL;
+    Lexer *L = createLexer(fp);
+    L->ownsSource = fp != stdin;
+    return L;
+}
 
-        getNextToken(B, &t, 0);
+void destroyLexer(Lexer *L)
+{
+    if (!L)
+        return;
+    destroyTwinBuffer(L->B);
+    if (L->ownsSource)
+        fclose(L->source);
+    free(L);
+}
 
-        current_s = 0;
-        if (t.cat == EXIT)
+// Lex the next kept token into the window; returns 0 at end of input
+static int fillWindow(Lexer *L)
+{
+    if (L->done)
+        return 0;
+
+    while (1)
+    {
+        Token *t = &L->window[(L->head + L->count) % LEX_LOOKAHEAD];
+        t->lexeme = LEXEME_EMPTY;
+        t->lineNo = L->lineNo;
+        t->cat = NORMAL;
+
+        getNextToken(L, t);
+
+        if (t->cat == EXIT)
         {
-            break;
+            L->done = 1;
+            return 0;
         }
-        if (t.cat == CONTINUE)
+        if (t->cat == CONTINUE)
         {
             continue;
         }
-        temp[ind] = t;
-        ind++;
+        copyLexeme(L, t);
 
-        // printToken(&t);
+        // Cache the value of a number lexeme once, for the parse tree printer
+        if (t->cat == NORMAL && (t->type == TK_NUM || t->type == TK_RNUM))
+        {
+            InternPool *P = lexemePool();
+            if (isnan(internedValue(P, t->lexeme)))
+            {
+                const char *text = internedString(P, t->lexeme);
+                setInternedValue(P, t->lexeme, t->type == TK_NUM ? (double)atoi(text) : atof(text));
+            }
+        }
+        L->count++;
+        break;
     }
-    return temp;
 
-    destroyTwinBuffer(B);
-    fclose(fp);
+    // Mapped pages behind the scanner are not needed again (a retract moves
+    // back two characters at most), so drop them to keep memory bounded
+    if (L->B->mappedSize)
+    {
+        long consumed = bufferPosition(L->B) & ~(long)(LEX_RELEASE_CHUNK - 1);
+        if (consumed - L->released >= 2 * LEX_RELEASE_CHUNK)
+        {
+            long keep = consumed - LEX_RELEASE_CHUNK;
+            madvise(L->B->buffers[0] + L->released, keep - L->released, MADV_DONTNEED);
+            L->released = keep;
+        }
+    }
+    return 1;
+}
+
+const Token *peekToken(Lexer *L, int k)
+{
+    while (L->count <= k)
+    {
+        if (!fillWindow(L))
+            return NULL;
+    }
+    return &L->window[(L->head + k) % LEX_LOOKAHEAD];
+}
+
+int readToken(Lexer *L, Token *t)
+{
+    const Token *next = peekToken(L, 0);
+    if (!next)
+        return 0;
+
+    *t = *next;
+    L->head = (L->head + 1) % LEX_LOOKAHEAD;
+    L->count--;
+    L->tokenCount++;
+    return 1;
+}
+
+void driverToken(char *fn, FILE *out)
+{
+    TokenStream *S = tokenizeFile(fn);
+
+    if (out)
+    {
+        Token t;
+        for (uint32_t i = 0; i < S->size; i++)
+        {
+            tokenAt(S, i, &t);
+            printToken(&t, out);
+        }
+    }
+
+    destroyTokenStream(S);
+}
+
+Token *getarrayoftokens(char *fn, uint32_t *count)
+{
+    TokenStream *S = tokenizeFile(fn);
+    Token *tokens = (Token *)malloc((S->size > 0 ? (size_t)S->size : 1) * sizeof(Token));
+    if (!tokens)
+    {
+        fprintf(stderr, "Memory allocation failed in getarrayoftokens\n");
+        exit(EXIT_FAILURE);
+    }
+    for (uint32_t i = 0; i < S->size; i++)
+        tokenAt(S, i, &tokens[i]);
+    *count = S->size;
+    destroyTokenStream(S);
+    return tokens;
 }
 void removeComments(const char *testcaseFile, const char *cleanFile)
 {
@@ -9,147 +9,40 @@
 #include <string.h>
 #include <ctype.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include "intern.h"
+#include "symbols.h"
 
 /* Macros */
 #define TRAP_STATE -1
 #define EOF_SENTINEL '\0'
 #define BUFFER_SIZE 512
+#define LEX_MAX_SOURCE 0xFFFFFFFFul // Token offsets are 32-bit, so a source may hold at most 4 GB - 1
 
 
 /*-------------------
    Token Types
   -------------------*/
-/* Order must match the token order used in lexer.c */
+/* Generated from symbols.h; lexerDef.h refers to tokens by name only */
+#define TOKEN_ENUM(name, ...) name,
 typedef enum
 {
-  TK_MINUS,
-  TK_IF,
-  TK_DIV,
-  TK_CALL,
-  TK_WITH,
-  TK_MAIN,
-  TK_ENDWHILE,
-  TK_TYPE,
-  TK_ELSE,
-  TK_INT,
-  TK_NOT,
-  TK_GT,
-  TK_PARAMETERS,
-  TK_THEN,
-  TK_SEM,
-  TK_RETURN,
-  TK_ID,
-  TK_DEFINETYPE,
-  TK_OP,
-  TK_WHILE,
-  TK_OR,
-  TK_FUNID,
-  TK_COMMA,
-  TK_INPUT,
-  TK_UNION,
-  TK_RECORD,
-  TK_DOT,
-  TK_RUID,
-  TK_WRITE,
-  TK_ENDUNION,
-  TK_FIELDID,
-  TK_LIST,
-  TK_AND,
-  TK_CL,
-  TK_ASSIGNOP,
-  TK_OUTPUT,
-  TK_EQ,
-  TK_ENDIF,
-  TK_GLOBAL,
-  TK_AS,
-  TK_COLON,
-  TK_NE,
-  TK_GE,
-  TK_LE,
-  TK_SQR,
-  TK_END,
-  TK_PLUS,
-  TK_ENDRECORD,
-  TK_READ,
-  TK_LT,
-  TK_SQL,
-  TK_NUM,
-  TK_RNUM,
-  TK_PARAMETER,
-  TK_MUL,
-  TK_REAL,
-  TK_EPS,
-  TK_EOF,
-  TK_COMMENT,
+  TERMINAL_SYMBOLS(TOKEN_ENUM)
+  LEXER_ONLY_SYMBOLS(TOKEN_ENUM)
   TK_ERR
 } TokenType;
+#undef TOKEN_ENUM
 
 static inline char *getTokenStr(TokenType t)
 {
-
+#define TOKEN_NAME(name, ...) #name,
   static char *TokenStr[] = {
-      "TK_MINUS",
-      "TK_IF",
-      "TK_DIV",
-      "TK_CALL",
-      "TK_WITH",
-      "TK_MAIN",
-      "TK_ENDWHILE",
-      "TK_TYPE",
-      "TK_ELSE",
-      "TK_INT",
-      "TK_NOT",
-      "TK_GT",
-      "TK_PARAMETERS",
-      "TK_THEN",
-      "TK_SEM",
-      "TK_RETURN",
-      "TK_ID",
-      "TK_DEFINETYPE",
-      "TK_OP",
-      "TK_WHILE",
-      "TK_OR",
-      "TK_FUNID",
-      "TK_COMMA",
-      "TK_INPUT",
-      "TK_UNION",
-      "TK_RECORD",
-      "TK_DOT",
-      "TK_RUID",
-      "TK_WRITE",
-      "TK_ENDUNION",
-      "TK_FIELDID",
-      "TK_LIST",
-      "TK_AND",
-      "TK_CL",
-      "TK_ASSIGNOP",
-      "TK_OUTPUT",
-      "TK_EQ",
-      "TK_ENDIF",
-      "TK_GLOBAL",
-      "TK_AS",
-      "TK_COLON",
-      "TK_NE",
-      "TK_GE",
-      "TK_LE",
-      "TK_SQR",
-      "TK_END",
-      "TK_PLUS",
-      "TK_ENDRECORD",
-      "TK_READ",
-      "TK_LT",
-      "TK_SQL",
-      "TK_NUM",
-      "TK_RNUM",
-      "TK_PARAMETER",
-      "TK_MUL",
-      "TK_REAL",
-      "TK_EPS",
-      "TK_EOF",
-      "TK_COMMENT",
+      TERMINAL_SYMBOLS(TOKEN_NAME)
+      LEXER_ONLY_SYMBOLS(TOKEN_NAME)
     };
+#undef TOKEN_NAME
 
-  if (t >= TK_MINUS && t <= TK_COMMENT)
+  if (t >= 0 && t < TK_ERR)
   {
     return TokenStr[t];
   }
@@ -169,6 +62,51 @@ typedef enum
   FINAL_RETRACTTWICE = 3,
 } StateDetail;
 
+/*-------------------
+   Accept Actions
+  -------------------*/
+/* What a final state does; the per-state tables live in lexerDef.h */
+typedef enum
+{
+  LEX_NONE,    // Not a final state
+  LEX_TOKEN,   // Emit the token type stored for the state
+  LEX_FUNID,   // Keyword lookup, TK_FUNID otherwise
+  LEX_FIELDID, // Keyword lookup, TK_FIELDID otherwise
+  LEX_SKIP,    // Whitespace or newline, no token
+  LEX_EXIT,    // End of input
+} LexAction;
+
+#define LEX_FLAG_NEWLINE 1  // Reaching the state ends a source line
+#define LEX_FLAG_NOAPPEND 2 // Characters read out of the state are not kept
+
+/*-------------------
+   Self-Loop Runs
+  -------------------*/
+/* Bytes on which a state loops back to itself, described as at most two
+   byte ranges (LEX_RUN_IN) or everything outside two ranges (LEX_RUN_OUT),
+   so that lexRunLength() can consume them in bulk. */
+typedef enum
+{
+  LEX_RUN_NONE, // No self-loop worth scanning in bulk
+  LEX_RUN_IN,   // Loop on bytes in [lo1, hi1] or [lo2, hi2]
+  LEX_RUN_OUT,  // Loop on bytes outside both ranges
+} LexRunKind;
+
+typedef struct
+{
+  unsigned char kind;
+  unsigned char lo1, hi1;
+  unsigned char lo2, hi2;
+} LexRun;
+
+/* Whether byte c continues a run */
+static inline int lexInRun(unsigned char c, const LexRun *run)
+{
+  int in = (unsigned char)(c - run->lo1) <= (unsigned char)(run->hi1 - run->lo1) ||
+           (unsigned char)(c - run->lo2) <= (unsigned char)(run->hi2 - run->lo2);
+  return in != (run->kind == LEX_RUN_OUT);
+}
+
 /*-------------------
    Invalid Token Enum
   -------------------*/
@@ -189,48 +127,117 @@ typedef struct
 {
   TokenType type;
   TokenCategory cat;
-  char lexeme[BUFFER_SIZE]; // Actual lexeme
+  LexemeId lexeme;  // Interned lexeme (filled by copyLexeme)
   int lineNo;       // Line number in source file
+  long start;       // Source offset of the first lexeme character
+  int length;       // Lexeme length in characters
 } Token;
 
+/*-------------------
+   Token Stream Structure
+  -------------------*/
+/* Structure of arrays: about 14 bytes per token plus one line table entry
+   per source line that holds tokens. Use tokenAt() to get a Token back. */
+typedef struct
+{
+  uint8_t *type;        // TokenType of each token
+  uint8_t *cat;         // TokenCategory of each token
+  uint32_t *offset;     // Source offset of each token's first character
+  uint32_t *length;     // Lexeme length of each token
+  LexemeId *lexeme;     // Interned lexeme of each token
+  uint32_t size;        // Number of tokens stored
+  uint32_t capacity;    // Allocated slots in each token array
+  uint32_t *lineFirst;  // Line table: index of the first token of each run
+  uint32_t *lineNumber; // Line table: line number shared by the run
+  uint32_t lineRuns;    // Number of entries in the line table
+  uint32_t lineCapacity; // Allocated entries in the line table
+} TokenStream;
+
 /*-------------------
    Twin Buffer Structure
   -------------------*/
 typedef struct
 {
-  FILE *source;       // Input file pointer
-  char **buffers;     // Array of two character buffers
-  int *charsInBuffer; // Number of valid characters in each buffer
-  int currentBuffer;  // Index of the current buffer (0 or 1)
-  int forwardPointer; // Current read index within the active buffer
-  int bufferSize;     // Size of each buffer
+  FILE *source;        // Input file pointer
+  char **buffers;      // Array of two character buffers
+  long *charsInBuffer; // Number of valid characters in each buffer
+  int currentBuffer;   // Index of the current buffer (0 or 1)
+  long forwardPointer; // Current read index within the active buffer
+  long bufferSize;     // Size of each buffer
+  long bufferOffset;  // Source offset of the active buffer's first character
+  int nextLoaded;     // Other buffer already holds the data after the active one
+  int eofPending;     // Last read returned EOF without advancing
+  size_t mappedSize;  // Bytes mapped when buffer 0 is the whole source, else 0
 } twinBuffer;
 
+/*-------------------
+   Lexer Context Structure
+  -------------------*/
+#define LEX_LOOKAHEAD 4 // Tokens a lexer can hold ahead of its consumer
+
+/* Everything one scan of one source needs; lexers share no state, so any
+   number of them can run at once. */
+typedef struct
+{
+  FILE *source;                // Input file pointer
+  int ownsSource;              // source is closed by destroyLexer()
+  twinBuffer *B;               // Buffer the tokens are lexed from
+  int lineNo;                  // Line the scanner is on
+  uint32_t tokenCount;         // Tokens consumed through readToken()
+  Token window[LEX_LOOKAHEAD]; // Ring of lexed but unconsumed tokens
+  int head;                    // Index of the oldest token in window
+  int count;                   // Number of tokens in window
+  int done;                    // End of input reached
+  long released;               // Mapped bytes already handed back to the kernel
+} Lexer;
+
 /*-------------------
    Function Prototypes
   -------------------*/
 
 /* Twin buffer functions */
 twinBuffer *createTwinBuffer(FILE *source, int bufSize);
+twinBuffer *createMappedBuffer(FILE *source);
+twinBuffer *openSourceBuffer(FILE *source);
 void destroyTwinBuffer(twinBuffer *B);
 int getNextCharFromBuffer(twinBuffer *B);
 void retract(twinBuffer *B, int n);
+long bufferPosition(twinBuffer *B);
 
 /* FSM and lexing functions */
 int getState(char c, int current_state);
 int getStateDetails(twinBuffer *B, int state);
 TokenType lookupKeyword(const char *lex);
+TokenType lookupKeywordLen(const char *lex, int len);
 void token_fun(Token *token);
 void id_fun(Token *token);
-void doStateActions(Token *token, int state);
+void doStateActions(Lexer *L, Token *token, int state);
 // const char *getTokenStr(TokenType t);
-void getNextToken(twinBuffer *B, Token *token, int pos);
-void printToken(Token *t);
-Token* getarrayoftokens(char *fn);
-int getnooftokens();
+void getNextToken(Lexer *L, Token *token);
+void copyLexeme(Lexer *L, Token *token);
+const char *lexemeStart(Lexer *L, const Token *token);
+void printToken(Token *t, FILE *out);
+long lexRunLength(const char *p, long n, const LexRun *run);
+Token* getarrayoftokens(char *fn, uint32_t *count);
+
+/* Token stream functions */
+TokenStream *createTokenStream(uint32_t capacity);
+void destroyTokenStream(TokenStream *S);
+void pushToken(TokenStream *S, const Token *t);
+int tokenLine(const TokenStream *S, uint32_t i);
+void tokenAt(const TokenStream *S, uint32_t i, Token *t);
+TokenStream *tokenizeFile(char *fn);
+TokenStream *tokenizeText(const char *text, size_t length);
+
+/* Lexer context functions */
+Lexer *createLexer(FILE *source);
+Lexer *openLexer(char *fn);
+void destroyLexer(Lexer *L);
+const Token *peekToken(Lexer *L, int k);
+int readToken(Lexer *L, Token *t);
 
 /* Driver function */
-void driverToken(char *fn, int printFlag);
+void driverToken(char *fn, FILE *out);
 
 /* Utility functions */
 void removeComments(const char *testcaseFile, const char *cleanFile);
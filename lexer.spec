@@ -0,0 +1,199 @@
+# lexer.spec
+#
+# Declarative description of the lexer DFA. tools/lexgen reads this file,
+# minimizes the automaton, groups bytes into equivalence classes and writes
+# the transition tables to lexerDef.h (run `make lexerDef.h`).
+#
+# State numbers below are the ones used in the original DFA diagram; the
+# generator renumbers them after minimization, except that state 0 stays
+# the start state.
+#
+# Edges:   <from> <charset> [<charset> ...] -> <to>
+#          A charset is a quoted character ('x', '\n', '\t', ' '), a range
+#          ('a'-'z'), EOF (the byte the lexer sees at end of input) or
+#          "other" (every byte without an explicit edge out of <from>).
+#          Bytes without any edge lead to the trap state (lexical error).
+#
+# Accepts: accept <state> <retract> <action> [newline]
+#          <retract> is how many characters are pushed back (0, 1 or 2).
+#          <action> is a TK_* token type, or one of
+#            @funid    keyword lookup, TK_FUNID otherwise
+#            @fieldid  keyword lookup, TK_FIELDID otherwise
+#            @skip     no token is produced (whitespace, newline)
+#            @exit     end of input
+#          "newline" increments the line counter when the state is reached.
+#
+# noappend <state>: characters consumed while leaving <state> are not added
+#          to the lexeme (comment bodies only keep the leading '%').
+#
+# Keywords: keyword <lexeme> <TK_*>
+#          Identifiers accepted by @funid/@fieldid states are looked up here.
+#          The generator builds a perfect hash over these lexemes.
+
+#---------------- start state ----------------
+0   '%'                 -> 1
+0   EOF                 -> 3
+0   '*'                 -> 4
+0   '&'                 -> 5
+0   '~'                 -> 8
+0   '\n'                -> 9
+0   '@'                 -> 10
+0   '['                 -> 13
+0   '-'                 -> 14
+0   '+'                 -> 15
+0   '('                 -> 16
+0   '='                 -> 17
+0   ')'                 -> 19
+0   ';'                 -> 20
+0   ':'                 -> 21
+0   '!'                 -> 22
+0   '/'                 -> 24
+0   '.'                 -> 25
+0   ']'                 -> 26
+0   '\t' ' '            -> 27
+0   '0'-'9'             -> 29
+0   '#'                 -> 40
+0   '_'                 -> 43
+0   ','                 -> 64
+0   'b'-'d'             -> 47
+0   'a' 'e'-'z'         -> 48
+0   '>'                 -> 54
+0   '<'                 -> 57
+
+#---------------- comments ----------------
+1   '\n' EOF            -> 2
+1   other               -> 1
+noappend 1
+accept 2   0  TK_COMMENT newline
+
+#---------------- end of input ----------------
+accept 3   0  @exit
+
+#---------------- single character tokens ----------------
+accept 4   0  TK_MUL
+accept 8   0  TK_NOT
+accept 13  0  TK_SQL
+accept 14  0  TK_MINUS
+accept 15  0  TK_PLUS
+accept 16  0  TK_OP
+accept 19  0  TK_CL
+accept 20  0  TK_SEM
+accept 21  0  TK_COLON
+accept 24  0  TK_DIV
+accept 25  0  TK_DOT
+accept 26  0  TK_SQR
+accept 64  0  TK_COMMA
+
+#---------------- &&& and @@@ ----------------
+5   '&'                 -> 6
+6   '&'                 -> 7
+accept 7   0  TK_AND
+10  '@'                 -> 11
+11  '@'                 -> 12
+accept 12  0  TK_OR
+
+#---------------- == and != ----------------
+17  '='                 -> 18
+accept 18  0  TK_EQ
+22  '='                 -> 23
+accept 23  0  TK_NE
+
+#---------------- whitespace ----------------
+accept 9   0  @skip newline
+27  '\t' ' '            -> 27
+27  other               -> 28
+accept 28  1  @skip
+
+#---------------- numbers ----------------
+29  '0'-'9'             -> 29
+29  '.'                 -> 30
+29  other               -> 39
+accept 39  1  TK_NUM
+30  '0'-'9'             -> 31
+30  other               -> 38
+accept 38  2  TK_NUM
+31  '0'-'9'             -> 32
+32  'E' 'e'             -> 33
+32  other               -> 37
+accept 37  1  TK_RNUM
+33  '+' '-'             -> 34
+33  '0'-'9'             -> 35
+34  '0'-'9'             -> 35
+35  '0'-'9'             -> 36
+accept 36  0  TK_RNUM
+
+#---------------- record/union identifiers ----------------
+40  'a'-'z'             -> 41
+41  'a'-'z'             -> 41
+41  other               -> 42
+accept 42  1  TK_RUID
+
+#---------------- function identifiers ----------------
+43  'a'-'z' 'A'-'Z'     -> 44
+44  'a'-'z' 'A'-'Z'     -> 44
+44  '0'-'9'             -> 45
+44  other               -> 46
+45  '0'-'9'             -> 45
+45  other               -> 46
+accept 46  1  @funid
+
+#---------------- variable and field identifiers ----------------
+47  'a'-'z'             -> 48
+47  '2'-'7'             -> 50
+47  other               -> 53
+accept 53  1  TK_FIELDID
+48  'a'-'z'             -> 48
+48  other               -> 49
+accept 49  1  @fieldid
+50  'b'-'d'             -> 50
+50  '2'-'7'             -> 51
+50  other               -> 52
+51  '2'-'7'             -> 51
+51  other               -> 52
+accept 52  1  TK_ID
+
+#---------------- relational operators and assignment ----------------
+54  '='                 -> 55
+54  other               -> 56
+accept 55  0  TK_GE
+accept 56  1  TK_GT
+57  '='                 -> 58
+57  '-'                 -> 59
+57  other               -> 63
+accept 58  0  TK_LE
+accept 63  1  TK_LT
+59  '-'                 -> 60
+59  other               -> 62
+accept 62  2  TK_LT
+60  '-'                 -> 61
+accept 61  0  TK_ASSIGNOP
+
+#---------------- keywords ----------------
+keyword else        TK_ELSE
+keyword with        TK_WITH
+keyword parameters  TK_PARAMETERS
+keyword output      TK_OUTPUT
+keyword int         TK_INT
+keyword read        TK_READ
+keyword write       TK_WRITE
+keyword return      TK_RETURN
+keyword then        TK_THEN
+keyword real        TK_REAL
+keyword endwhile    TK_ENDWHILE
+keyword if          TK_IF
+keyword type        TK_TYPE
+keyword _main       TK_MAIN
+keyword global      TK_GLOBAL
+keyword endif       TK_ENDIF
+keyword endunion    TK_ENDUNION
+keyword definetype  TK_DEFINETYPE
+keyword as          TK_AS
+keyword call        TK_CALL
+keyword record      TK_RECORD
+keyword endrecord   TK_ENDRECORD
+keyword parameter   TK_PARAMETER
+keyword end         TK_END
+keyword while       TK_WHILE
+keyword union       TK_UNION
+keyword list        TK_LIST
+keyword input       TK_INPUT
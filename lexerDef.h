@@ -0,0 +1,575 @@
+/* Generated by tools/lexgen from lexer.spec -- do not edit by hand. */
+
+#ifndef LEXERDEF_H
+#define LEXERDEF_H
+
+#include "lexer.h"
+
+#define LEX_START_STATE 0
+#define LEX_NUM_STATES 65
+#define LEX_NUM_CLASSES 33
+
+/* Byte -> character class */
+static const unsigned char lexCharClass[256] = {
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  1,  2,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     1,  3,  0,  4,  0,  5,  6,  0,  7,  8,  9, 10, 11, 12, 13, 14,
+    15, 15, 16, 16, 16, 16, 16, 16, 15, 15, 17, 18, 19, 20, 21,  0,
+    22, 23, 23, 23, 23, 24, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23,
+    23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 25,  0, 26,  0, 27,
+     0, 28, 29, 29, 29, 30, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28,
+    28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28,  0,  0,  0, 31,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 32,
+};
+
+/* [state][class] -> next state, TRAP_STATE on error */
+static const signed char lexTransition[LEX_NUM_STATES][LEX_NUM_CLASSES] = {
+    {-1,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15, 15, 16, 17, 18, 19, 20, 21, -1, -1, 22, 23, 24, 25, 26, 25, 27, 28}, /* spec state 0 */
+    {29,  1, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29}, /* spec state 27 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 9 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 30, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 22 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 31, 31, 31, -1, -1}, /* spec state 40 */
+    { 5,  5, 32,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5, 32}, /* spec state 1 */
+    {-1, -1, -1, -1, -1, -1, 33, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 5 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 16 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 19 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 4 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 15 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 64 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 14 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 25 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 24 */
+    {34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 35, 34, 15, 15, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34, 34}, /* spec state 29 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 21 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 20 */
+    {36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 37, 36, 36, 36, 36, 36, 36, 36, 38, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36, 36}, /* spec state 57 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 39, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 17 */
+    {40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 41, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40, 40}, /* spec state 54 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 42, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 10 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 13 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 26 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 43, 43, -1, -1, -1, 43, 43, 43, -1, -1}, /* spec state 43 */
+    {44, 44, 44, 44, 44, 44, 44, 44, 44, 44, 44, 44, 44, 44, 44, 44, 44, 44, 44, 44, 44, 44, 44, 44, 44, 44, 44, 44, 25, 25, 25, 44, 44}, /* spec state 48 */
+    {45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 46, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 25, 25, 25, 45, 45}, /* spec state 47 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 8 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 3 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 28 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 23 */
+    {47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 47, 31, 31, 31, 47, 47}, /* spec state 41 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 2 */
+    {-1, -1, -1, -1, -1, -1, 48, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 6 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 39 */
+    {49, 49, 49, 49, 49, 49, 49, 49, 49, 49, 49, 49, 49, 49, 49, 50, 50, 49, 49, 49, 49, 49, 49, 49, 49, 49, 49, 49, 49, 49, 49, 49, 49}, /* spec state 30 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 63 */
+    {51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 52, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51}, /* spec state 59 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 58 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 18 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 56 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 55 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 53, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 11 */
+    {54, 54, 54, 54, 54, 54, 54, 54, 54, 54, 54, 54, 54, 54, 54, 55, 55, 54, 54, 54, 54, 54, 54, 43, 43, 54, 54, 54, 43, 43, 43, 54, 54}, /* spec state 44 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 49 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 53 */
+    {56, 56, 56, 56, 56, 56, 56, 56, 56, 56, 56, 56, 56, 56, 56, 56, 57, 56, 56, 56, 56, 56, 56, 56, 56, 56, 56, 56, 56, 46, 56, 56, 56}, /* spec state 50 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 42 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 7 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 38 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 58, 58, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 31 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 62 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 59, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 60 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 12 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 46 */
+    {54, 54, 54, 54, 54, 54, 54, 54, 54, 54, 54, 54, 54, 54, 54, 55, 55, 54, 54, 54, 54, 54, 54, 54, 54, 54, 54, 54, 54, 54, 54, 54, 54}, /* spec state 45 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 52 */
+    {56, 56, 56, 56, 56, 56, 56, 56, 56, 56, 56, 56, 56, 56, 56, 56, 57, 56, 56, 56, 56, 56, 56, 56, 56, 56, 56, 56, 56, 56, 56, 56, 56}, /* spec state 51 */
+    {60, 60, 60, 60, 60, 60, 60, 60, 60, 60, 60, 60, 60, 60, 60, 60, 60, 60, 60, 60, 60, 60, 60, 60, 61, 60, 60, 60, 60, 60, 61, 60, 60}, /* spec state 32 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 61 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 37 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 62, -1, 62, -1, -1, 63, 63, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 33 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 63, 63, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 34 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 64, 64, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 35 */
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, /* spec state 36 */
+};
+
+/* Per-state accept/retract metadata */
+static const unsigned char lexStateDetail[LEX_NUM_STATES] = {
+    NON_FINAL,
+    NON_FINAL,
+    FINAL_NO_RETRACT,
+    NON_FINAL,
+    NON_FINAL,
+    NON_FINAL,
+    NON_FINAL,
+    FINAL_NO_RETRACT,
+    FINAL_NO_RETRACT,
+    FINAL_NO_RETRACT,
+    FINAL_NO_RETRACT,
+    FINAL_NO_RETRACT,
+    FINAL_NO_RETRACT,
+    FINAL_NO_RETRACT,
+    FINAL_NO_RETRACT,
+    NON_FINAL,
+    FINAL_NO_RETRACT,
+    FINAL_NO_RETRACT,
+    NON_FINAL,
+    NON_FINAL,
+    NON_FINAL,
+    NON_FINAL,
+    FINAL_NO_RETRACT,
+    FINAL_NO_RETRACT,
+    NON_FINAL,
+    NON_FINAL,
+    NON_FINAL,
+    FINAL_NO_RETRACT,
+    FINAL_NO_RETRACT,
+    FINAL_RETRACTONCE,
+    FINAL_NO_RETRACT,
+    NON_FINAL,
+    FINAL_NO_RETRACT,
+    NON_FINAL,
+    FINAL_RETRACTONCE,
+    NON_FINAL,
+    FINAL_RETRACTONCE,
+    NON_FINAL,
+    FINAL_NO_RETRACT,
+    FINAL_NO_RETRACT,
+    FINAL_RETRACTONCE,
+    FINAL_NO_RETRACT,
+    NON_FINAL,
+    NON_FINAL,
+    FINAL_RETRACTONCE,
+    FINAL_RETRACTONCE,
+    NON_FINAL,
+    FINAL_RETRACTONCE,
+    FINAL_NO_RETRACT,
+    FINAL_RETRACTTWICE,
+    NON_FINAL,
+    FINAL_RETRACTTWICE,
+    NON_FINAL,
+    FINAL_NO_RETRACT,
+    FINAL_RETRACTONCE,
+    NON_FINAL,
+    FINAL_RETRACTONCE,
+    NON_FINAL,
+    NON_FINAL,
+    FINAL_NO_RETRACT,
+    FINAL_RETRACTONCE,
+    NON_FINAL,
+    NON_FINAL,
+    NON_FINAL,
+    FINAL_NO_RETRACT,
+};
+
+/* Per-state accept action */
+static const unsigned char lexStateAction[LEX_NUM_STATES] = {
+    LEX_NONE,
+    LEX_NONE,
+    LEX_SKIP,
+    LEX_NONE,
+    LEX_NONE,
+    LEX_NONE,
+    LEX_NONE,
+    LEX_TOKEN,
+    LEX_TOKEN,
+    LEX_TOKEN,
+    LEX_TOKEN,
+    LEX_TOKEN,
+    LEX_TOKEN,
+    LEX_TOKEN,
+    LEX_TOKEN,
+    LEX_NONE,
+    LEX_TOKEN,
+    LEX_TOKEN,
+    LEX_NONE,
+    LEX_NONE,
+    LEX_NONE,
+    LEX_NONE,
+    LEX_TOKEN,
+    LEX_TOKEN,
+    LEX_NONE,
+    LEX_NONE,
+    LEX_NONE,
+    LEX_TOKEN,
+    LEX_EXIT,
+    LEX_SKIP,
+    LEX_TOKEN,
+    LEX_NONE,
+    LEX_TOKEN,
+    LEX_NONE,
+    LEX_TOKEN,
+    LEX_NONE,
+    LEX_TOKEN,
+    LEX_NONE,
+    LEX_TOKEN,
+    LEX_TOKEN,
+    LEX_TOKEN,
+    LEX_TOKEN,
+    LEX_NONE,
+    LEX_NONE,
+    LEX_FIELDID,
+    LEX_TOKEN,
+    LEX_NONE,
+    LEX_TOKEN,
+    LEX_TOKEN,
+    LEX_TOKEN,
+    LEX_NONE,
+    LEX_TOKEN,
+    LEX_NONE,
+    LEX_TOKEN,
+    LEX_FUNID,
+    LEX_NONE,
+    LEX_TOKEN,
+    LEX_NONE,
+    LEX_NONE,
+    LEX_TOKEN,
+    LEX_TOKEN,
+    LEX_NONE,
+    LEX_NONE,
+    LEX_NONE,
+    LEX_TOKEN,
+};
+
+/* Token produced by LEX_TOKEN states */
+static const unsigned char lexStateToken[LEX_NUM_STATES] = {
+    TK_ERR,
+    TK_ERR,
+    TK_ERR,
+    TK_ERR,
+    TK_ERR,
+    TK_ERR,
+    TK_ERR,
+    TK_OP,
+    TK_CL,
+    TK_MUL,
+    TK_PLUS,
+    TK_COMMA,
+    TK_MINUS,
+    TK_DOT,
+    TK_DIV,
+    TK_ERR,
+    TK_COLON,
+    TK_SEM,
+    TK_ERR,
+    TK_ERR,
+    TK_ERR,
+    TK_ERR,
+    TK_SQL,
+    TK_SQR,
+    TK_ERR,
+    TK_ERR,
+    TK_ERR,
+    TK_NOT,
+    TK_ERR,
+    TK_ERR,
+    TK_NE,
+    TK_ERR,
+    TK_COMMENT,
+    TK_ERR,
+    TK_NUM,
+    TK_ERR,
+    TK_LT,
+    TK_ERR,
+    TK_LE,
+    TK_EQ,
+    TK_GT,
+    TK_GE,
+    TK_ERR,
+    TK_ERR,
+    TK_ERR,
+    TK_FIELDID,
+    TK_ERR,
+    TK_RUID,
+    TK_AND,
+    TK_NUM,
+    TK_ERR,
+    TK_LT,
+    TK_ERR,
+    TK_OR,
+    TK_ERR,
+    TK_ERR,
+    TK_ID,
+    TK_ERR,
+    TK_ERR,
+    TK_ASSIGNOP,
+    TK_RNUM,
+    TK_ERR,
+    TK_ERR,
+    TK_ERR,
+    TK_RNUM,
+};
+
+/* LEX_FLAG_* bits */
+static const unsigned char lexStateFlags[LEX_NUM_STATES] = {
+    0,
+    0,
+    LEX_FLAG_NEWLINE,
+    0,
+    0,
+    LEX_FLAG_NOAPPEND,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    LEX_FLAG_NEWLINE,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+    0,
+};
+
+/* Self-loop runs, see lexRunLength() in lexrun.c */
+static const LexRun lexStateRun[LEX_NUM_STATES] = {
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_IN,   9,   9,  32,  32}, /* spec state 27 */
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_IN,   0,   9,  11, 254}, /* spec state 1 */
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_IN,  48,  57,  48,  57}, /* spec state 29 */
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_IN,  97, 122,  97, 122}, /* spec state 48 */
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_IN,  97, 122,  97, 122}, /* spec state 41 */
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_IN,  65,  90,  97, 122}, /* spec state 44 */
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_IN,  98, 100,  98, 100}, /* spec state 50 */
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_IN,  48,  57,  48,  57}, /* spec state 45 */
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_IN,  50,  55,  50,  55}, /* spec state 51 */
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+    {LEX_RUN_NONE, 0, 0, 0, 0},
+};
+
+/* Keyword perfect hash, see keywordHash() in lexer.c */
+#define LEX_KEYWORD_COUNT 28
+#define LEX_KEYWORD_HASH_SIZE 32
+#define LEX_KEYWORD_MAX_LEN 10
+
+static const unsigned char lexKeywordAsso[256] = {
+    27, 13, 24,  3, 18,  0,  7,  9, 10, 28,  8, 27, 28,  2, 16, 26,
+     8,  7, 27, 30,  9, 14, 25, 23, 26,  9, 28,  5,  5, 15,  3, 22,
+    15, 28,  3,  3,  5, 11, 26,  9,  5, 21, 19,  8, 12,  6, 25, 29,
+     2,  3, 28, 31,  8, 30,  4, 28, 29, 21, 24, 18, 19, 15, 13, 13,
+    21, 20, 16,  4, 21, 14, 18, 17, 23,  3, 22, 20, 30, 15, 27,  6,
+    26,  4, 10, 30, 15,  1, 31,  6,  4, 20, 23, 27, 16, 15, 30,  7,
+     5, 30, 21, 30, 31,  1,  6, 28, 24, 31,  8, 23, 27,  2, 16, 14,
+     8,  0, 31, 18, 20, 15,  2, 12,  7, 28, 18, 23, 20,  8, 13, 27,
+    22, 26, 12, 10, 10, 24, 14, 28,  2,  1,  0, 10, 12, 16, 15, 12,
+     3, 17, 14, 20, 23,  0,  5,  7, 29,  6, 31, 31, 22, 19, 18,  2,
+     1, 26, 12, 31,  0, 15,  2, 14, 11,  1, 24,  5, 23, 23, 16, 25,
+     3, 13, 19, 27,  8, 11,  1, 14, 31, 10, 24, 10, 16,  6,  5, 19,
+    29,  1, 13, 22, 19, 29, 27,  8, 12, 23,  8, 30,  4,  4, 11, 12,
+     2, 13,  6, 31,  2, 10, 12, 26,  5,  0, 19, 17, 23, 26, 30,  6,
+     4,  8,  8,  6, 26, 26, 15,  3, 28, 27,  6, 16, 12, 14, 25, 30,
+    22,  9, 30, 25, 29, 20,  0,  2,  6,  0, 10, 11,  6,  7, 22, 20,
+};
+
+static const char *const lexKeywordText[LEX_KEYWORD_HASH_SIZE] = {
+    "then",
+    "else",
+    "parameters",
+    "read",
+    "as",
+    "record",
+    "int",
+    "with",
+    "input",
+    "endunion",
+    "while",
+    "definetype",
+    NULL,
+    "if",
+    "parameter",
+    NULL,
+    NULL,
+    "write",
+    "list",
+    "end",
+    "union",
+    "type",
+    "return",
+    "output",
+    "global",
+    "endrecord",
+    "endwhile",
+    "call",
+    "endif",
+    NULL,
+    "_main",
+    "real",
+};
+
+static const unsigned char lexKeywordLength[LEX_KEYWORD_HASH_SIZE] = {
+    4,
+    4,
+    10,
+    4,
+    2,
+    6,
+    3,
+    4,
+    5,
+    8,
+    5,
+    10,
+    0,
+    2,
+    9,
+    0,
+    0,
+    5,
+    4,
+    3,
+    5,
+    4,
+    6,
+    6,
+    6,
+    9,
+    8,
+    4,
+    5,
+    0,
+    5,
+    4,
+};
+
+static const unsigned char lexKeywordType[LEX_KEYWORD_HASH_SIZE] = {
+    TK_THEN,
+    TK_ELSE,
+    TK_PARAMETERS,
+    TK_READ,
+    TK_AS,
+    TK_RECORD,
+    TK_INT,
+    TK_WITH,
+    TK_INPUT,
+    TK_ENDUNION,
+    TK_WHILE,
+    TK_DEFINETYPE,
+    TK_ID,
+    TK_IF,
+    TK_PARAMETER,
+    TK_ID,
+    TK_ID,
+    TK_WRITE,
+    TK_LIST,
+    TK_END,
+    TK_UNION,
+    TK_TYPE,
+    TK_RETURN,
+    TK_OUTPUT,
+    TK_GLOBAL,
+    TK_ENDRECORD,
+    TK_ENDWHILE,
+    TK_CALL,
+    TK_ENDIF,
+    TK_ID,
+    TK_MAIN,
+    TK_REAL,
+};
+
+#endif /* LEXERDEF_H */
@@ -0,0 +1,138 @@
+/**
+ * @file lexrun.c
+ * @brief Bulk scanning of DFA self-loops for the lexer.
+ *
+ * Comment bodies, blank runs, identifiers and digit strings keep the DFA in
+ * one state for many characters. lexgen describes each such self-loop as a
+ * LexRun and getNextToken() hands the rest of the run to lexRunLength(),
+ * which tests 16 (SSE2) or 32 (AVX2) bytes per step instead of stepping the
+ * transition table once per character.
+ *
+ * The kernel is picked once at run time from the CPU features; the
+ * LEXER_SIMD environment variable ("scalar", "sse2" or "avx2") overrides the
+ * choice, which is how the kernels are checked against each other.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "lexer.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define LEXRUN_X86 1
+#endif
+
+typedef long (*RunKernel)(const unsigned char *p, long n, const LexRun *run);
+
+static RunKernel runKernel = NULL; ///< Kernel chosen by selectRunKernel()
+
+/**
+ * @brief Returns the length of the run at the start of a byte range.
+ *
+ * @param p The bytes to scan.
+ * @param n Number of bytes that may be scanned; nothing past p + n is read.
+ * @param run The self-loop of the current state.
+ * @return long Number of leading bytes that keep the DFA in the state.
+ */
+long lexRunLength(const char *p, long n, const LexRun *run);
+
+static long runScalar(const unsigned char *p, long n, const LexRun *run)
+{
+    long i = 0;
+    while (i < n && lexInRun(p[i], run))
+        i++;
+    return i;
+}
+
+#ifdef LEXRUN_X86
+__attribute__((target("sse2")))
+static long runSSE2(const unsigned char *p, long n, const LexRun *run)
+{
+    const __m128i lo1 = _mm_set1_epi8((char)run->lo1);
+    const __m128i w1 = _mm_set1_epi8((char)(run->hi1 - run->lo1));
+    const __m128i lo2 = _mm_set1_epi8((char)run->lo2);
+    const __m128i w2 = _mm_set1_epi8((char)(run->hi2 - run->lo2));
+    const unsigned flip = run->kind == LEX_RUN_IN ? 0xFFFFu : 0u;
+
+    long i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)(p + i));
+        // c - lo <= hi - lo (unsigned) <=> min(c - lo, hi - lo) == c - lo
+        __m128i x1 = _mm_sub_epi8(v, lo1);
+        __m128i x2 = _mm_sub_epi8(v, lo2);
+        __m128i m = _mm_or_si128(_mm_cmpeq_epi8(_mm_min_epu8(x1, w1), x1),
+                                 _mm_cmpeq_epi8(_mm_min_epu8(x2, w2), x2));
+        unsigned stop = ((unsigned)_mm_movemask_epi8(m) ^ flip) & 0xFFFFu;
+        if (stop)
+            return i + __builtin_ctz(stop);
+    }
+    return i + runScalar(p + i, n - i, run);
+}
+
+__attribute__((target("avx2")))
+static long runAVX2(const unsigned char *p, long n, const LexRun *run)
+{
+    const __m256i lo1 = _mm256_set1_epi8((char)run->lo1);
+    const __m256i w1 = _mm256_set1_epi8((char)(run->hi1 - run->lo1));
+    const __m256i lo2 = _mm256_set1_epi8((char)run->lo2);
+    const __m256i w2 = _mm256_set1_epi8((char)(run->hi2 - run->lo2));
+    const unsigned flip = run->kind == LEX_RUN_IN ? 0xFFFFFFFFu : 0u;
+
+    long i = 0;
+    for (; i + 32 <= n; i += 32)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(p + i));
+        __m256i x1 = _mm256_sub_epi8(v, lo1);
+        __m256i x2 = _mm256_sub_epi8(v, lo2);
+        __m256i m = _mm256_or_si256(_mm256_cmpeq_epi8(_mm256_min_epu8(x1, w1), x1),
+                                    _mm256_cmpeq_epi8(_mm256_min_epu8(x2, w2), x2));
+        unsigned stop = (unsigned)_mm256_movemask_epi8(m) ^ flip;
+        if (stop)
+            return i + __builtin_ctz(stop);
+    }
+    return i + runSSE2(p + i, n - i, run);
+}
+#endif
+
+static RunKernel selectRunKernel(void)
+{
+    const char *force = getenv("LEXER_SIMD");
+    if (force && strcmp(force, "scalar") == 0)
+        return runScalar;
+#ifdef LEXRUN_X86
+    __builtin_cpu_init();
+    if (!__builtin_cpu_supports("sse2"))
+        return runScalar;
+    if (force && strcmp(force, "sse2") == 0)
+        return runSSE2;
+    if (__builtin_cpu_supports("avx2"))
+        return runAVX2;
+    return runSSE2;
+#else
+    return runScalar;
+#endif
+}
+
+long lexRunLength(const char *p, long n, const LexRun *run)
+{
+    const unsigned char *u = (const unsigned char *)p;
+
+    // Most identifier and number runs end within a few bytes; only hand
+    // runs that outlast one vector to the wide kernels
+    long head = n < 16 ? n : 16;
+    long i = 0;
+    while (i < head && lexInRun(u[i], run))
+        i++;
+    if (i < head || i == n)
+        return i;
+
+    // Lexers on several threads may race to pick the kernel; they all pick the same one
+    RunKernel kernel = __atomic_load_n(&runKernel, __ATOMIC_RELAXED);
+    if (!kernel)
+    {
+        kernel = selectRunKernel();
+        __atomic_store_n(&runKernel, kernel, __ATOMIC_RELAXED);
+    }
+    return i + kernel(u + i, n - i, run);
+}
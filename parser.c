@@ -5,23 +5,40 @@
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
 #include "parser.h"
+#include "grammarDef.h"
 #include "vectorofvector.h"
 #include "stack.h"
 #include "tree.h"
+#include "trace.h"
+#include "ast.h"
 #include "lexer.h"
-bool issyntaxcorrect = true;
-grammar G;
-First_Follow F;
- parsetable T;
-Stack S;
-int parser_called=0;
-int sz = 0;
-
-
-FILE *logFile = NULL; 
+// Grammar, FIRST/FOLLOW sets and parse table generated from grammer.txt by tools/grammargen
+static const struct grammar grammarData = {grammarRules};
+static const struct First_Follow grammarSets = {grammarFirst, grammarFollow};
+
+grammar G = &grammarData;
+First_Follow F = &grammarSets;
+parsetable T = &grammarTable;
+
+// Per-parse state is thread-local so batch workers (--jobs) can parse files side by side;
+// G, F and T above are read-only and shared
+_Thread_local bool issyntaxcorrect = true;
+_Thread_local uint32_t sz = 0;
+_Thread_local FILE *logFile = NULL; 
+_Thread_local TraceBuffer parserTrace; // Parse actions, rendered to parser_output.txt after the parse
+_Thread_local FILE *parserMessages = NULL; // Diagnostics and progress messages, NULL for stdout
 FILE *tableLogFile = NULL;
 
+static inline FILE *messages(void)
+{
+    return parserMessages ? parserMessages : stdout;
+}
+
 /**
  * @brief Function to print the grammar rules.
  *
@@ -39,21 +56,21 @@ void print_grammar(grammar G)
     {
         for (int j = 0; j < 10; j++)
         {
-            if (accessVectorOfVector(G->Grammar, i, j) == -1)
+            if (G->rules[i][j] == -1)
             {
                 printf("\n");
                 break;
             }
             if (j == 0)
             {
-                printf("<%s> ===> ", grammarTerms[accessVectorOfVector(G->Grammar, i, j)]);
+                printf("<%s> ===> ", grammarTerms[G->rules[i][j]]);
             }
             else
             {
-                if (grammarTerms[accessVectorOfVector(G->Grammar, i, j)][0] == 'T' || accessVectorOfVector(G->Grammar, i, j) == EPSILON)
-                    printf("%s ", grammarTerms[accessVectorOfVector(G->Grammar, i, j)]);
+                if (grammarTerms[G->rules[i][j]][0] == 'T' || G->rules[i][j] == EPSILON)
+                    printf("%s ", grammarTerms[G->rules[i][j]]);
                 else
-                    printf("<%s> ", grammarTerms[accessVectorOfVector(G->Grammar, i, j)]);
+                    printf("<%s> ", grammarTerms[G->rules[i][j]]);
             }
         }
     }
@@ -97,17 +114,10 @@ void print_first_set(First_Follow F, grammar G)
     
 
     
-        Vector *firstVec = &F->firstset.data[i];
-        for (int j = 0; j < firstVec->size; j++)
+        for (int j = 0; j < TERMS_SIZE; j++)
         {
-            
-            if (firstVec->data[j] == 0)
-                break;
-            else
-            {
-                fprintf(fp, "%s, ", grammarTerms[firstVec->data[j]]);
-                
-            }
+            if (symbolSetHas(&F->firstset[i], j))
+                fprintf(fp, "%s, ", grammarTerms[j]);
         }
         fprintf(fp, "\n");
     }
@@ -126,11 +136,8 @@ void print_first_set(First_Follow F, grammar G)
  * @param F The First_Follow structure containing the follow sets.
  * @param G The grammar structure.
  *
- * @note The function assumes that the follow set data is stored in a Vector structure within the First_Follow structure.
- *       The follow set for each non-terminal is accessed using the index of the non-terminal.
- *       Special values in the follow set:
- *       - 0: Indicates the end of the follow set for a non-terminal.
- *       - -1: Represents the end-of-input symbol ($).
+ * @note The follow sets are bitsets indexed by grammar symbol; bit 0 is the end-of-input symbol ($).
+ *       Members are printed in symbol index order.
  *
  * @warning If the file "follow_out.txt" cannot be opened, an error message is printed to stderr.
  */
@@ -152,22 +159,10 @@ void print_follow_set(First_Follow F, grammar G)
       
         fprintf(fp, "%s ===> ", grammarTerms[i]);
        
-        Vector *followVec = &F->followset.data[i];
-        for (int j = 0; j < followVec->size; j++)
+        for (int j = 0; j < TERMS_SIZE; j++)
         {
-      
-            if (followVec->data[j] == 0)
-                break;
-            else if (followVec->data[j] == -1)
-            {
-                fprintf(fp, "$, ");
-                
-            }
-            else
-            {
-                fprintf(fp, "%s, ", grammarTerms[followVec->data[j]]);
-            
-            }
+            if (symbolSetHas(&F->followset[i], j))
+                fprintf(fp, "%s, ", grammarTerms[j]);
         }
        
         fprintf(fp, "\n");
@@ -178,475 +173,6 @@ void print_follow_set(First_Follow F, grammar G)
 }
 
 
-/**
- * @brief Checks if a given number exists in an array.
- *
- * This function iterates through an array of integers and checks if the specified
- * number exists in the array. The array is assumed to be terminated by a zero.
- *
- * @param temp Pointer to the array of integers.
- * @param n The number to check for in the array.
- * @return Returns -1 if the number is found in the array, otherwise returns 0.
- */
-int checker(int *temp, int n)
-{
-    int i = 0, flag = 0;
-    while (temp[i] != 0)
-    {
-        if (temp[i] == n)
-        {
-            flag = -1;
-            break;
-        }
-        ++i;
-    }
-    return flag; 
-}
-
-/**
- * @brief Computes the First set for a given non-terminal in a grammar.
- *
- * This function calculates the First set for a given non-terminal symbol `n` in the provided grammar `gmr`.
- * The First set is stored in the provided `buffer` array. The function also updates the `First_Follow` structure `FF`.
- *
- * @param n The non-terminal symbol for which the First set is to be computed.
- * @param gmr The grammar structure containing the production rules.
- * @param buffer An array to store the computed First set. The array should have a size of at least 150.
- * @param FF The First_Follow structure that contains the First and Follow sets for all symbols.
- */
-void FirstSet(int n, grammar gmr, int buffer[150], First_Follow FF)
-{
-    int j = 0;
-    
-    for (int i = 0; i < 150; i++)
-    {
-        if (buffer[i] == 0)
-        {
-            j = i;
-            break;
-        }
-    }
-
-    
-    if (n < NONTERMINALS_START || n == EPSILON)
-    {
-        buffer[j] = n;
-    }
-    else
-    {
-        
-        for (int i = 0; i < GRAMMAR_SIZE; i++)
-        {
-           
-            if (accessVectorOfVector(gmr->Grammar, i, 0) == n)
-            {
-                int rhsSymbol = accessVectorOfVector(gmr->Grammar, i, 1);
-             
-                if (rhsSymbol <= 56 || rhsSymbol == 110)
-                {
-                    if (!checker(buffer, rhsSymbol))
-                    {
-                        buffer[j++] = rhsSymbol;
-                    }
-                }
-                else
-                {
-                    int epsn = 0;
-                    
-                    for (int k = 1; k < 10; k++)
-                    {
-                        int symbol = accessVectorOfVector(gmr->Grammar, i, k);
-                        if (symbol == -1)
-                            break;
-                        epsn = 0;
-                        
-                        FirstSet(symbol, gmr, FF->firstset.data[symbol].data, FF);
-
-                    
-                        Vector *firstSetVector = &FF->firstset.data[symbol];
-                        for (int l = 0; l < firstSetVector->size; l++)
-                        {
-                            int curr = firstSetVector->data[l];
-                            
-                            if (curr == 0)
-                                break;
-                            if (curr == EPSILON)
-                                epsn = 1;
-                            else
-                            {
-                                if (!checker(buffer, curr))
-                                {
-                                    buffer[j++] = curr;
-                                }
-                            }
-                        }
-                      
-                        if (epsn != 1)
-                            break;
-                    }
-                    
-                    if (epsn)
-                    {
-                        buffer[j++] = EPSILON;
-                    }
-                }
-            }
-        }
-    }
-}
-
-
-/**
- * @brief Computes the Follow Set for a given non-terminal in a grammar.
- *
- * This function computes the Follow Set for a given non-terminal symbol `n` in the provided grammar `gmr`.
- * The Follow Set is stored in the provided `buffer`. The function also uses the `First_Follow` structure `FF`
- * to access the first and follow sets of other symbols and a `check` array to avoid infinite recursion.
- *
- * @param n The non-terminal symbol for which the Follow Set is to be computed.
- * @param gmr The grammar structure containing the production rules.
- * @param buffer An array to store the computed Follow Set.
- * @param FF The First_Follow structure containing the first and follow sets of all symbols.
- * @param check An array used to mark symbols that have already been processed to avoid infinite recursion.
- */
-void FollowSet(int n, grammar gmr, int buffer[150], First_Follow FF, int check[111])
-{
-    int j = 0, k;
-
-    
-    if (check[n] == 1)
-    {
-        check[n] = 0;
-        return;
-    }
-
-    
-    if (n == NONTERMINALS_START)
-    {
-        buffer[j++] = -1; 
-    }
-
-   
-    for (int i = 0; i < GRAMMAR_SIZE; i++)
-    {
-        
-        for (int p = 1; p < 12; p++)
-        {
-            int symbolAtP = accessVectorOfVector(gmr->Grammar, i, p);
-            if (symbolAtP == -1)
-                break;
-            
-            if (symbolAtP == n)
-            {
-                
-                for (k = p + 1; accessVectorOfVector(gmr->Grammar, i, k) != -1; k++)
-                {
-                    int epsn = 0;
-                    int followingSymbol = accessVectorOfVector(gmr->Grammar, i, k);
-                    
-                    Vector *firstVec = &FF->firstset.data[followingSymbol];
-                    for (int l = 0; l < firstVec->size; l++)
-                    {
-                        int curr = firstVec->data[l];
-                        if (curr == 0)
-                            break; 
-                        if (curr == EPSILON)
-                            epsn = 1;
-                        else
-                        {
-                            if (!checker(buffer, curr))
-                            {
-                                buffer[j++] = curr;
-                            }
-                        }
-                    }
-                    
-                    if (!epsn)
-                        break;
-                }
-               
-                if (accessVectorOfVector(gmr->Grammar, i, k) == -1 &&
-                    accessVectorOfVector(gmr->Grammar, i, 0) != n)
-                {
-                    int lhs = accessVectorOfVector(gmr->Grammar, i, 0);
-                    check[lhs] = 1;
-                    
-                    FollowSet(lhs, gmr, FF->followset.data[lhs].data, FF, check);
-                    check[lhs] = 0;
-                    
-                    Vector *followVec = &FF->followset.data[lhs];
-                    for (int l = 0; l < followVec->size; l++)
-                    {
-                        int curr = followVec->data[l];
-                        if (curr == 0)
-                            break;
-                        if (!checker(buffer, curr))
-                        {
-                            buffer[j++] = curr;
-                        }
-                    }
-                }
-            }
-        }
-    }
-}
-
-/**
- * @brief Computes the First and Follow sets for a given grammar.
- *
- * This function initializes and computes the First and Follow sets for the provided grammar.
- * It allocates memory for the First_Follow structure, initializes the vectors for the first and follow sets,
- * and then populates these sets by calling the appropriate functions.
- *
- * @param G The grammar for which the First and Follow sets are to be computed.
- * @return A pointer to the First_Follow structure containing the computed First and Follow sets.
- */
-First_Follow ComputeFirstAndFollowSets(grammar G)
-{
- 
-    First_Follow F = (First_Follow)malloc(sizeof(First_Follow));
-
-    
-    initVectorOfVector(&F->firstset);
-    
-    for (int i = 0; i < TERMS_SIZE; i++)
-    {
-        Vector row;
-        initVector(&row);
-        for (int j = 0; j < 20; j++)
-        {
-            pushBack(&row, 0);
-        }
-        pushBackVector(&F->firstset, row);
-    }
-
-    
-    for (int i = 1; i < TERMS_SIZE; i++)
-    {
-        FirstSet(i, G, F->firstset.data[i].data, F);
-    }
-
-    
-    initVectorOfVector(&F->followset);
-   
-    for (int i = 0; i < NONTERMINALS_START; i++)
-    {
-        Vector dummy;
-        initVector(&dummy);
-        pushBackVector(&F->followset, dummy);
-    }
-  
-    for (int i = NONTERMINALS_START; i < NONTERMINALS_END; i++)
-    {
-        Vector row;
-        initVector(&row);
-        for (int j = 0; j < 20; j++)
-        {
-            pushBack(&row, 0);
-        }
-        pushBackVector(&F->followset, row);
-    }
-
-    int check[111] = {0};
-    int passes = 1;
-    while (passes != 6)
-    {
-        for (int i = NONTERMINALS_START; i < NONTERMINALS_END; i++)
-        {
-            FollowSet(i, G, F->followset.data[i].data, F, check);
-        }
-        passes++;
-    }
-    return F;
-}
-
-
-
-/**
- * @brief Frees the memory allocated for the First_Follow structure.
- *
- * This function takes a First_Follow structure and frees the memory
- * allocated for it. It is important to call this function to avoid
- * memory leaks when the First_Follow structure is no longer needed.
- *
- * @param F The First_Follow structure to be freed.
- */
-void freeFirstandFollow(First_Follow F)
-{
-    free(F);
-}
-
-/**
- * @brief Initializes the parse table with given First and Follow sets.
- *
- * This function allocates memory for the parse table and initializes it with default values.
- * It then populates the table based on the provided First and Follow sets.
- *
- * @param F The First and Follow sets used to initialize the parse table.
- * @return The initialized parse table.
- *
- * The function performs the following steps:
- * 1. Allocates memory for the parse table.
- * 2. Initializes the parse table with default values (-1).
- * 3. Populates the parse table based on the Follow sets.
- * 4. Sets specific entries in the parse table to SYNCRO based on predefined indices.
- */
-parsetable initialize_table(First_Follow F)
-{
-    parsetable T = (parsetable)malloc(sizeof(struct pTable));
-    
-    initVectorOfVector(&T->parser_Table);
-    for (int i = 0; i < NONTERMINALS; i++)
-    {
-        Vector row;
-        initVector(&row);
-        for (int j = 0; j <= TERMINALS; j++)
-        {
-            pushBack(&row, -1);
-        }
-        pushBackVector(&T->parser_Table, row);
-    }
-
-    
-    for (int i = 0; i < NONTERMINALS; i++)
-    {
-        int follow_index = i + NONTERMINALS_START;
-        Vector *followRow = &F->followset.data[follow_index];
-        for (int j = 0; j < followRow->size; j++)
-        {
-            int x = accessVector(followRow, j);
-            if (x == 0)
-                break;
-            if (x == -1)
-                T->parser_Table.data[i].data[0] = SYNCRO; 
-            else
-                T->parser_Table.data[i].data[x] = SYNCRO;
-        }
-    }
-
-   
-    for (int i = 0; i < NONTERMINALS; i++)
-    {
-        Vector *row = &T->parser_Table.data[i];
-        // row->data[4] = SYNCRO;
-        // row->data[18] = SYNCRO;
-        // row->data[16] = SYNCRO;
-        // row->data[29] = SYNCRO;
-        // row->data[30] = SYNCRO;
-        // row->data[9] = SYNCRO;
-        // row->data[2] = SYNCRO;
-        // row->data[26] = SYNCRO;
-        // row->data[55] = SYNCRO;
-        
-        row->data[3] = SYNCRO;
-        row->data[1] = SYNCRO;
-        row->data[15] = SYNCRO;
-        row->data[17] = SYNCRO;
-        row->data[47] = SYNCRO;
-        row->data[19] = SYNCRO;
-        row->data[56] = SYNCRO;
-        row->data[24] = SYNCRO;
-        row->data[27] = SYNCRO;
-        row->data[31] = SYNCRO;
-        row->data[32] = SYNCRO;
-        row->data[50] = SYNCRO;
-        row->data[8] = SYNCRO;
-        
-    }
-
-    return T;
-}
-/**
- * @brief Creates a parse table for the given grammar.
- *
- * This function populates the parse table `T` using the first and follow sets `F` 
- * and the grammar `G`. It iterates through each production in the grammar and 
- * fills the parse table based on the first and follow sets.
- *
- * @param F The first and follow sets.
- * @param T The parse table to be populated.
- * @param G The grammar containing the productions.
- *
- * The function follows these steps:
- * 1. For each production in the grammar:
- *    - Retrieve the left-hand side (lhs) of the production.
- *    - Iterate through the right-hand side (rhs) symbols of the production.
- *    - If the rhs symbol is EPSILON, mark the flag `fl` and break.
- *    - If the rhs symbol is a terminal, update the parse table and break.
- *    - For each symbol in the first set of the rhs symbol:
- *      - If the symbol is not EPSILON, update the parse table.
- *      - If the symbol is EPSILON, set the flag `fl2`.
- *    - If `fl2` is not set, break the loop.
- *    - If `fl2` is set and the next rhs symbol is the end of the production, set the flag `fl`.
- * 2. If the flag `fl` is set, update the parse table using the follow set of the lhs.
- */
-
-void createParseTable(First_Follow F, parsetable T, grammar G)
-{
-    int lhs, fl, fl2;
-
-    
-    for (int i = 0; i < GRAMMAR_SIZE; i++)
-    {
-        lhs = accessVectorOfVector(G->Grammar, i, 0);
-        fl = 0;
-        for (int j = 1; j < 10; j++)
-        {
-            fl2 = 0;
-            int rhs = accessVectorOfVector(G->Grammar, i, j);
-            if (rhs == -1)
-                break;
-            if (rhs == EPSILON)
-            {
-                fl = 1;
-                break;
-            }
-            
-            if (rhs >= 1 && rhs <= 56)
-            {
-                T->parser_Table.data[lhs - NONTERMINALS_START].data[rhs] = i;
-                break;
-            }
-
-            
-            for (int k = 0; k < 20; k++)
-            {
-                int first_val = accessVector(&F->firstset.data[rhs], k);
-                if (first_val == 0)
-                    break;
-                if (first_val != EPSILON)
-                {
-                    T->parser_Table.data[lhs - NONTERMINALS_START].data[first_val] = i;
-                }
-                if (first_val == EPSILON)
-                    fl2 = 1;
-            }
-            if (fl2 == 0)
-                break;
-            else if (fl2 == 1 && accessVectorOfVector(G->Grammar, i, j + 1) == -1)
-            {
-                fl = 1;
-                break;
-            }
-        }
-     
-        if (fl == 1)
-        {
-            Vector *followRow = &F->followset.data[lhs];
-            for (int j = 0; j < followRow->size; j++)
-            {
-                int x = accessVector(followRow, j);
-                if (x == 0)
-                    break;
-                if (x == -1)
-                    T->parser_Table.data[lhs - NONTERMINALS_START].data[0] = i;
-                else
-                    T->parser_Table.data[lhs - NONTERMINALS_START].data[x] = i;
-            }
-        }
-    }
-}
-
 /**
  * @brief Prints the parsing table to the log file.
  *
@@ -677,11 +203,10 @@ void printTable(parsetable T)
     for (int i = 0; i < NONTERMINALS; i++)
     {
         fprintf(tableLogFile,"%-30s ==> |\t", grammarTerms[i + NONTERMINALS_START]);
-        Vector *row = &T->parser_Table.data[i];
         // Print every element of the row.
-        for (int j = 0; j < row->size; j++)
+        for (int j = 0; j <= TERMINALS; j++)
         {
-            int val = accessVector(row, j);
+            int val = T->table[i][j];
             if (val == -1)
                 fprintf(tableLogFile,"ERR%-16s|\t"," ");
             else if (val == SYNCRO)
@@ -700,72 +225,38 @@ void printTable(parsetable T)
     }
 }
 
-/**
- * @brief Frees the memory allocated for the grammar structure.
- *
- * This function deallocates the memory used by the grammar structure,
- * including the memory for the grammar itself and the structure pointer.
- *
- * @param G A pointer to the grammar structure to be freed.
- */
-
-void freeGrammar(grammar G)
-{
-   
-    free(G->Grammar);
-    free(G);
-}
-
 /**
  * @brief Finds the index of a given token in the grammar terms array.
  *
- * This function iterates through the grammar terms array and compares each term
- * with the string representation of the given token's type. If a match is found,
- * the index of the matching term is returned.
+ * This is a single lookup in tokenTerminal[], which symbols.h generates
+ * alongside the TokenType enum and grammarTerms[].
  *
  * @param ts The token whose index is to be found.
  * @return The index of the token in the grammar terms array.
  */
 int indexoftoken(Token ts){
-    int indx = 0;
-        for (int i = 0; i < TERMS_SIZE; i++)
-        {
-            if (strcmp(grammarTerms[i], getTokenStr(ts.type)) == 0)
-            {
-                indx = i;
-            }
-        }
-        return indx;
+    // Tokens outside the grammar fall back to $ as before
+    int indx = tokenTerminal[ts.type];
+    return indx < 0 ? 0 : indx;
 }
 /**
  * @brief Generates tokens from the given testcase file.
  *
- * This function drives the token generation process by invoking the lexer
- * and then retrieves the array of tokens generated from the given testcase file.
+ * This function lexes the given testcase file in a single pass and retrieves
+ * the resulting compact token stream; the token count is stored in sz.
  * It also prints an informational message indicating the completion of the lexing process.
  *
  * @param testcaseFile The path to the testcase file from which tokens are to be generated.
- * @return A pointer to the array of generated tokens.
+ * @return A pointer to the stream of generated tokens.
  */
 
-Token *togettokens(char *testcaseFile)
+TokenStream *togettokens(char *testcaseFile)
 {
-    driverToken(testcaseFile,0);
-
-    Token *tokens = getarrayoftokens(testcaseFile);
+    TokenStream *tokens = tokenizeFile(testcaseFile);
 
-    printf("[INFO] Lexing completed and tokens generated (To view token press 2)...\n");
+    fprintf(messages(), "[INFO] Lexing completed and tokens generated (To view token press 2)...\n");
 
-    sz = getnooftokens();
-
-    // printf("%d\n", sz);
-    // for (int i = 0; i < sz; i++)
-    // {
-    //     printf("%s ", tokens[i].lexeme);
-    //     printf("%s ",getTokenStr(tokens[i].type));
-    //     printf("%d",indexoftoken(tokens[i]));
-    //     printf("\n");
-    // }
+    sz = tokens->size;
     return tokens;
 }
 
@@ -774,17 +265,19 @@ Token *togettokens(char *testcaseFile)
  * @brief Initializes the log file for the parser.
  *
  * This function checks if the log file is already open. If not, it attempts to open
- * the file "parser_output.txt" in write mode. If the file cannot be opened, an error
- * message is printed using perror.
+ * the given file (normally "parser_output.txt") in write mode. If the file cannot be
+ * opened, an error message is printed using perror.
+ *
+ * @param path Path of the log file.
  *
  * @note If the file cannot be opened, appropriate error handling should be implemented,
  *       such as exiting the program or returning from the function.
  */
-void initLogFile() {
+void initLogFile(const char *path) {
     if (logFile == NULL) {
-        logFile = fopen("parser_output.txt", "w");
+        logFile = fopen(path, "w");
         if (logFile == NULL) {
-            perror("Could not open parser_output.txt");
+            perror(path);
             // Handle error, e.g. exit or return
         }
     }
@@ -836,6 +329,65 @@ void closeTableLogFile() {
     }
 }
 
+/**
+ * @brief Reports a token the lexer could not accept.
+ *
+ * @param ts The token, whose category is LENGTHEXCEEDED or ERROR.
+ */
+static void reportLexicalError(Token ts)
+{
+    if (ts.cat == LENGTHEXCEEDED)
+    {
+        if(ts.type == TK_FUNID){
+            TRACE(&parserTrace, TRACE_LEX_FUNID_LENGTH, &ts, 0);
+            fprintf(messages(), "[Lexcial Error] Line no. %d Error: Function Identifier is longer than the prescribed length\n", ts.lineNo);
+        }
+        else
+        {
+            TRACE(&parserTrace, TRACE_LEX_ID_LENGTH, &ts, 0);
+            fprintf(messages(), "[Lexcial Error] Line no. %d Error: Variable Identifier is longer than the prescribed length \n", ts.lineNo);
+        }
+    }
+    else if (ts.cat == ERROR)
+    {
+        TRACE(&parserTrace, TRACE_LEX_UNKNOWN, &ts, 0);
+        fprintf(messages(), "[Lexcial Error] Line no. %d Error: Unknown pattern <%s> \n", ts.lineNo, lexemeText(ts.lexeme));
+    }
+}
+
+/**
+ * @brief Adds the children of a production under a tree node and pushes them.
+ *
+ * The children are one contiguous run, pushed right to left; eps children
+ * are added to the tree but not pushed.
+ *
+ * @param tree The parse tree.
+ * @param s The parse stack.
+ * @param top Index of the node being expanded.
+ * @param rule The production, as a row of the grammar.
+ */
+static inline void expandTreeNode(ParseTree *tree, Stack *s, uint32_t top, const int *rule)
+{
+    int n = 1;
+    while (rule[n] != -1)
+        n++;
+    n--;
+    uint32_t first = addTreeNodes(tree, n, top);
+    tree->nodes[top].firstChild = first;
+    tree->nodes[top].numChildren = n;
+
+    for (int i = n; i >= 1; i--)
+    {
+        int symbol = rule[i];
+        TreeNode *child = &tree->nodes[first + i - 1];
+        child->symbolID = symbol;
+        if (symbol == EPSILON)
+            continue;
+        child->isTerminal = symbol < NONTERMINALS_START;
+        pushStack(s, first + i - 1);
+    }
+}
+
 /**
  * @brief Parses a given token using the provided parse table, stack, and grammar.
  *
@@ -847,6 +399,7 @@ void closeTableLogFile() {
  * @param T The parse table used for parsing.
  * @param s The stack used for parsing.
  * @param G The grammar used for parsing.
+ * @param tree The parse tree the new nodes are added to.
  *
  * The function performs the following steps:
  * 1. Checks for lexical errors and logs them.
@@ -855,79 +408,52 @@ void closeTableLogFile() {
  * 4. Handles terminal and non-terminal symbols.
  * 5. Applies grammar rules and updates the stack accordingly.
  *
- * The function logs various parsing actions and errors to a log file.
+ * The function records its actions and errors in the parser trace (see trace.h);
+ * nothing is written to parser_output.txt until the parse is over.
  */
-void parseToken(Token ts, parsetable T, Stack *s,grammar G)
+void parseToken(Token ts, parsetable T, Stack *s,grammar G, ParseTree *tree)
 {
     if(ts.cat != NORMAL){
-        
-        if (ts.cat == LENGTHEXCEEDED)
-        {
-            if(ts.type == TK_FUNID){
-                fprintf(logFile,"[Lexcial Error] Line no. %d Error: Function Identifier is longer than the prescribed length\n\n", ts.lineNo);
-                printf("[Lexcial Error] Line no. %d Error: Function Identifier is longer than the prescribed length\n", ts.lineNo);
-        }
-            else
-            {
-                fprintf(logFile,"[Lexcial Error] Line no. %d Error: Variable Identifier is longer than the prescribed length \n\n", ts.lineNo);
-                printf("[Lexcial Error] Line no. %d Error: Variable Identifier is longer than the prescribed length \n", ts.lineNo);
-        
-        }
-        }
-        else if (ts.cat == ERROR)
-        {
-            fprintf(logFile,"[Lexcial Error] Line no. %d Error: Unknown pattern <%s> \n\n", ts.lineNo, ts.lexeme);
-            printf("[Lexcial Error] Line no. %d Error: Unknown pattern <%s> \n", ts.lineNo, ts.lexeme);
-        }
-      
+        reportLexicalError(ts);
         return;
     }
-    if (strcmp(getTokenStr(ts.type), "TK_COMMENT") == 0)
+    if (ts.type == TK_COMMENT)
         return;
     bool fl = false;//when to move the input pointer
     bool er_fl = false;
+    int indx = indexoftoken(ts);
     
        
     while (fl== false)
     {   
         if (isStackEmpty(s))
             break;
-        TreeNode *topNode = (TreeNode *)malloc(sizeof(TreeNode));
-        int temp = topStack(s, &topNode);
-        if (temp == 0)
+        uint32_t top;
+        if (topStack(s, &top) == 0)
             break;
+        TreeNode *topNode = &tree->nodes[top];
 
-        int indx = 0;
-        for (int i = 0; i < TERMS_SIZE; i++)
-        {
-            if (strcmp(grammarTerms[i], getTokenStr(ts.type)) == 0)
-            {
-                indx = i;
-            }
-        }
-
-         fprintf(logFile,"Top of Stack --> %s  Current input pointer -->%s\n",grammarTerms[topNode->symbolID],getTokenStr(ts.type));//top of stack node
+         TRACE(&parserTrace, TRACE_STACK_TOP, &ts, topNode->symbolID);
 
        
 
-        if ((topNode->isTerminal == true) && strcmp(grammarTerms[topNode->symbolID], getTokenStr(ts.type)) == 0)
+        if ((topNode->isTerminal == true) && topNode->symbolID == indx)
         {   
-            strcpy(topNode->lexeme, ts.lexeme);
+            topNode->token = addTreeToken(tree, ts.lexeme, ts.lineNo);
             popStack(s);
-            fprintf(logFile,"Terminal at top of stack matched with Terminal at current input pointer\n\n");
+            TRACE(&parserTrace, TRACE_MATCH, &ts, topNode->symbolID);
             fl = true;
-            topNode->lineno = ts.lineNo;
             break;
         }
-        else if ((topNode->isTerminal == true) && strcmp(grammarTerms[topNode->symbolID], getTokenStr(ts.type)) != 0)
+        else if ((topNode->isTerminal == true) && topNode->symbolID != indx)
         {    
             if (er_fl == false){
-                fprintf(logFile,"[Parser Error] Line %d Error: The token %s for lexeme %s does not match with the expected token %s\n", ts.lineNo, getTokenStr(ts.type), ts.lexeme, grammarTerms[topNode->symbolID]);
-                printf("[Parser Error] Line %d Error: The token %s for lexeme %s does not match with the expected token %s\n", ts.lineNo, getTokenStr(ts.type), ts.lexeme, grammarTerms[topNode->symbolID]);
+                TRACE(&parserTrace, TRACE_MISMATCH_ERROR, &ts, topNode->symbolID);
+                fprintf(messages(), "[Parser Error] Line %d Error: The token %s for lexeme %s does not match with the expected token %s\n", ts.lineNo, getTokenStr(ts.type), lexemeText(ts.lexeme), grammarTerms[topNode->symbolID]);
             
             }
             popStack(s);
-             fprintf(logFile,"The terminal at top of stack doesnt match with terminal at current input pointer so the terminal at top of stack is popped out \n\n");
+             TRACE(&parserTrace, TRACE_POP_TERMINAL, &ts, topNode->symbolID);
 
             er_fl = true;
             issyntaxcorrect = false;
@@ -935,14 +461,14 @@ void parseToken(Token ts, parsetable T, Stack *s,grammar G)
         }
         else
         {   
-            int rule = accessVectorOfVector(&T->parser_Table, topNode->symbolID - NONTERMINALS_START, indx);
+            int rule = parseTableEntry(T, topNode->symbolID, indx);
            
             if (rule == -1)
             {   
-                fprintf(logFile,"no rule found\n");
+                TRACE(&parserTrace, TRACE_NO_RULE, &ts, topNode->symbolID);
                 if (er_fl == false){
-                    fprintf(logFile,"[Parser Error] Line %d Error: Invalid token %s encountered with the value %s stack top %s\n\n", ts.lineNo, getTokenStr(ts.type), ts.lexeme, grammarTerms[topNode->symbolID]);
-                    printf("[Parser Error] Line %d Error: Invalid token %s encountered with the value %s stack top %s\n", ts.lineNo, getTokenStr(ts.type), ts.lexeme, grammarTerms[topNode->symbolID]);
+                    TRACE(&parserTrace, TRACE_NO_RULE_ERROR, &ts, topNode->symbolID);
+                    fprintf(messages(), "[Parser Error] Line %d Error: Invalid token %s encountered with the value %s stack top %s\n", ts.lineNo, getTokenStr(ts.type), lexemeText(ts.lexeme), grammarTerms[topNode->symbolID]);
                 
                 }
                 issyntaxcorrect = false;
@@ -952,87 +478,46 @@ void parseToken(Token ts, parsetable T, Stack *s,grammar G)
             }
             else if (rule == SYNCRO) // folow of the nonterminal
             {   
-                 fprintf(logFile,"Syn rule found\n");
+                 TRACE(&parserTrace, TRACE_SYNC, &ts, topNode->symbolID);
                 if (er_fl == false){
-                    printf("[Parser Error] Line %d Error: Invalid token %s encountered with the value %s stack top %s\n", ts.lineNo, getTokenStr(ts.type), ts.lexeme, grammarTerms[topNode->symbolID]);
-                    fprintf(logFile,"[Parser Error] Line %d Error: Invalid token %s encountered with the value %s stack top %s\n", ts.lineNo, getTokenStr(ts.type), ts.lexeme, grammarTerms[topNode->symbolID]);
+                    fprintf(messages(), "[Parser Error] Line %d Error: Invalid token %s encountered with the value %s stack top %s\n", ts.lineNo, getTokenStr(ts.type), lexemeText(ts.lexeme), grammarTerms[topNode->symbolID]);
+                    TRACE(&parserTrace, TRACE_SYNC_ERROR, &ts, topNode->symbolID);
                 }popStack(s);
 
-                fprintf(logFile,"Non Terminal at the top of Stack is popped out\n\n");
+                TRACE(&parserTrace, TRACE_POP_NONTERMINAL, &ts, topNode->symbolID);
                 issyntaxcorrect = false;
                 er_fl = true;
             }
             else if (rule != -1)
             {   
-                fprintf(logFile,"%s==>",grammarTerms[accessVectorOfVector(G->Grammar,rule,0)]);
-                for(int i=1;i<10;i++){
-                    if(accessVectorOfVector(G->Grammar,rule,i)==-1) {
-                        fprintf(logFile,"\n");
-                        break;}
-                fprintf(logFile,"%s   ",grammarTerms[accessVectorOfVector(G->Grammar,rule,i)]);}
-
-                fprintf(logFile,"\n");
+                TRACE(&parserTrace, TRACE_RULE, &ts, rule);
                 popStack(s);
-               
-                bool fl2 = false;
-              
-                
-                for (int i = 9; i >= 1; i--) 
-                {
-                    
-                    if (accessVectorOfVector(G->Grammar, rule, i) == -1)
-                    {   
-                        
-                        fl2 = true;
-                        topNode->children = (TreeNode **)malloc((i - 1) * sizeof(struct TreeNode*));
-
-                        topNode->numChildren = i - 1;
-                    }
-
-                    if (fl2 == true && accessVectorOfVector(G->Grammar, rule, i) != -1)
-                    {
-
-                        if (accessVectorOfVector(G->Grammar, rule, i) == EPSILON)
-                        {
-                            TreeNode *tempNode = createNode(); // create a new node and push it into the stack
+                expandTreeNode(tree, s, top, G->rules[rule]);
+            }
+        }
+    }
+}
 
-                            tempNode->children = NULL;
-                            tempNode->parent = topNode;
-                            tempNode->symbolID = 110;
-                            topNode->children[i - 1] = tempNode;
-                        }
-                        else if(accessVectorOfVector(G->Grammar, rule, i) < NONTERMINALS_START){
-
-                            TreeNode *tempNode = createNode();
-
-                            tempNode->symbolID = accessVectorOfVector(G->Grammar, rule, i);
-
-                            tempNode->parent = topNode;
-
-                            topNode->children[i - 1] = tempNode;
-
-                            tempNode->isTerminal = true;
-                            pushStack(s, tempNode);
-                        }
-                        else
-                        {
-
-                            TreeNode *tempNode = createNode();
-
-                            tempNode->symbolID = accessVectorOfVector(G->Grammar, rule, i);
-
-                            tempNode->parent = topNode;
-
-                            topNode->children[i - 1] = tempNode;
-
-
-                            pushStack(s, tempNode);
-                        }
-                    }
-                }
-            }
-        }
+/**
+ * @brief Creates the parse stack holding only the root of a new parse tree.
+ *
+ * @param tree The empty parse tree; its root (the start symbol) is added here.
+ * @return Stack* The stack, to be released with deleteStack().
+ */
+static Stack *createParseStack(ParseTree *tree)
+{
+    Stack *s = (Stack *)malloc(sizeof(Stack));
+    if (!s) {
+        printf("Memory allocation failed for Stack.\n");
+        exit(1);
     }
+    createStack(s, 10);
+    
+    uint32_t root = addTreeNodes(tree, 1, TREE_NO_NODE);
+    tree->nodes[root].symbolID = NONTERMINALS_START;
+    
+    pushStack(s, root);
+    return s;
 }
 
 /**
@@ -1045,882 +530,958 @@ void parseToken(Token ts, parsetable T, Stack *s,grammar G)
  * @param testcaseFile The path to the file containing the source code to be parsed.
  * @param T The parse table used for parsing the source code.
  * @param G The grammar used for parsing the source code.
- * @return TreeNode* The root of the constructed parse tree.
- *
- * @note The function allocates memory for the stack and the root TreeNode. It is the caller's
- * responsibility to free the memory allocated for the parse tree.
+ * @param tree The empty tree to build; destroyParseTree() frees the whole tree.
+ * @return TreeNode* The root of the constructed parse tree, valid while the tree exists.
  *
- * @warning The function exits the program if memory allocation for the stack or the root TreeNode
+ * @warning The function exits the program if memory allocation for the stack or the tree
  * fails, or if tokenization fails.
  */
 // hepler parse tree->parsefile->
 
-TreeNode* parseInputSourceCode(char *testcaseFile, parsetable T,grammar G)
+TreeNode* parseInputSourceCode(char *testcaseFile, parsetable T,grammar G, ParseTree *tree)
 {    
 
-    Stack *s = (Stack *)malloc(sizeof(Stack));
-    if (!s) {
-        printf("Memory allocation failed for Stack.\n");
-        exit(1);
-    }
-    createStack(s, 10);
-    
-    TreeNode *root = createNode();
-    if (!root) {
-        printf("Memory allocation failed for TreeNode.\n");
-        exit(1);
-    }
-    root->parent = NULL;
-    root->symbolID = 57;
-    
-    pushStack(s, root);
+    Stack *s = createParseStack(tree);
     
-    Token *tokens = togettokens(testcaseFile);
+    TokenStream *tokens = togettokens(testcaseFile);
     if (!tokens) {
         printf("Tokenization failed.\n");
         exit(1);
     }
     
-    for (int i = 0; i < sz; i++) {
+    Token t;
+    for (uint32_t i = 0; i < sz; i++) {
     
-        parseToken(tokens[i], T, s, G);
+        tokenAt(tokens, i, &t);
+        parseToken(t, T, s, G, tree);
     }
+    destroyTokenStream(tokens);
     deleteStack(s);
-    return root;
+    free(s);
+    return &tree->nodes[0];
     
 }
+
+typedef struct TreeStream TreeStream;
+static TreeStream *openTreeStream(const char *outfile);
+static void advanceTreeStream(TreeStream *ts, ParseTree *tree, Stack *s);
+static void closeTreeStream(TreeStream *ts, ParseTree *tree, bool keep);
+
 /**
- * @brief Recursively prints the details of each node in the parse tree to a file.
+ * @brief Parses a source file while it is being lexed.
  *
- * This function traverses the parse tree in a pre-order manner and prints the details
- * of each node to the specified file. The details include the lexeme, line number,
- * symbol ID, and other relevant information.
+ * Unlike parseInputSourceCode(), no token array is built: the LL(1) driver
+ * pulls each token from a Lexer when it needs it, so only the lexer's
+ * small lookahead window is held and diagnostics appear as soon as the
+ * offending token is lexed.
  *
- * @param root Pointer to the root node of the parse tree.
- * @param fd Pointer to the file where the details will be printed.
+ * With an output file, the parse tree is printed while the parse goes on and
+ * its printed nodes are dropped, so memory stays flat however long the
+ * input is. The file only appears if the code is syntactically correct.
+ * Without one, the whole tree is built as parseInputSourceCode() builds it.
+ *
+ * @param testcaseFile The path to the file containing the source code to be parsed.
+ * @param T The parse table used for parsing the source code.
+ * @param G The grammar used for parsing the source code.
+ * @param tree The empty tree to build.
+ * @param outfile Where to print the parse tree, or NULL to keep the whole tree.
+ * @return TreeNode* The root of the constructed parse tree, NULL if it was printed.
  */
-
-void printhelper(TreeNode *root, FILE *fd)
+TreeNode* parseInputSourceStream(char *testcaseFile, parsetable T, grammar G, ParseTree *tree, const char *outfile)
 {
-    int treesz = root->numChildren;
-    if (treesz >= 1)
-    {
-        printhelper(root->children[0], fd);
-    }
-    char leaf[4];
-    char dummy[5] = "----";
-    if (treesz == 0)
-    {
-        strcpy(leaf, "yes");
-        if (root->symbolID == EPSILON)
-            strcpy(root->lexeme, "eps");
-    }
-    else
-    {
-        strcpy(leaf, "no");
-        strcpy(root->lexeme, dummy);
-    }
+    Stack *s = createParseStack(tree);
+    TreeStream *ts = outfile ? openTreeStream(outfile) : NULL;
 
-    if (root->symbolID == 57)
-    {
-        fprintf(fd, "%-15s\t %-3d\t %-22s\t %-10s\t %-22s\t %-4s\t %-22s\t \n", "----", root->lineno, grammarTerms[root->symbolID], "----", "$", leaf, grammarTerms[root->symbolID]);
-    }
-    else
-    {
-        if (strcmp(grammarTerms[root->symbolID], "TK_NUM") == 0)
-            fprintf(fd, "%-15s\t %-3d\t %-22s\t %-10d\t %-22s\t %-4s\t %-22s\t \n", root->lexeme, root->lineno, grammarTerms[root->symbolID], atoi(root->lexeme), grammarTerms[root->parent->symbolID], leaf, grammarTerms[root->symbolID]);
-        else if (strcmp(grammarTerms[root->symbolID], "TK_RNUM") == 0)
-            fprintf(fd, "%-15s\t %-3d\t %-22s\t %-10.5f\t %-22s\t %-4s\t %-22s\t \n", root->lexeme, root->lineno, grammarTerms[root->symbolID], atof(root->lexeme), grammarTerms[root->parent->symbolID], leaf, grammarTerms[root->symbolID]);
-        else
-            fprintf(fd, "%-15s\t %-3d\t %-22s\t %-10s\t %-22s\t %-4s\t %-22s\t \n", root->lexeme, root->lineno, grammarTerms[root->symbolID], "----", grammarTerms[root->parent->symbolID], leaf, grammarTerms[root->symbolID]);
-    }
+    fprintf(messages(), "[INFO] Streaming tokens from the lexer into the parser...\n");
 
-    for (int i = 1; i < treesz; i++)
+    Lexer *L = openLexer(testcaseFile);
+    Token t;
+    while (readToken(L, &t))
     {
-        printhelper(root->children[i], fd);
+        parseToken(t, T, s, G, tree);
+        if (ts)
+            advanceTreeStream(ts, tree, s);
     }
+    sz = L->tokenCount;
+
+    destroyLexer(L);
+    deleteStack(s);
+    free(s);
+    if (!ts)
+        return &tree->nodes[0];
+    closeTreeStream(ts, tree, issyntaxcorrect);
+    return NULL;
 }
 
 /**
- * @brief Prints the parse tree to a specified output file.
- *
- * This function takes the root of a parse tree and an output file path,
- * and writes the parse tree to the file in a formatted manner.
+ * @brief Parses an already lexed token stream into an empty parse tree.
  *
- * @param root Pointer to the root node of the parse tree.
- * @param outfile Path to the output file where the parse tree will be written.
+ * Diagnostics go to the parser messages as in parseInputSourceCode(); nothing
+ * is printed about the lexing itself.
  *
- * @note The output file will be overwritten if it already exists.
- *       If the file cannot be opened, the function will print an error message
- *       and terminate the program.
+ * @param tokens The tokens, comments and lexical errors included.
+ * @param tree The empty tree to build.
+ * @return true if the tokens are syntactically correct.
  */
-void printParseTree(TreeNode* root, char *outfile)
+bool parseTokenStream(const TokenStream *tokens, ParseTree *tree)
 {
-    FILE *f = fopen(outfile, "w");
-    if (f == NULL)
+    issyntaxcorrect = true;
+    Stack *s = createParseStack(tree);
+    Token t;
+    for (uint32_t i = 0; i < tokens->size; i++)
     {
-        printf("Error in opening the file");
-        exit(1);
+        tokenAt(tokens, i, &t);
+        parseToken(t, T, s, G, tree);
     }
-    fprintf(f, "%-15s %-3s %-22s %-10s %-22s %-4s %-22s\n", "Lexeme", "LineNo", "TokenName", "ValueIfNumber", "Parent", "isLeaf  ", "Node");
-    printhelper(root, f);
-    fclose(f);
+    deleteStack(s);
+    free(s);
+    return issyntaxcorrect;
 }
 
-
 /**
- * @brief Initializes the grammar for the compiler project.
- * 
- * This function allocates memory for a VectorOfVector structure to hold the grammar productions.
- * It then initializes the grammar with predefined productions by converting arrays to vectors and 
- * pushing them into the VectorOfVector structure. Each production is represented as an array of integers.
- * 
- * @return grammar A pointer to the initialized grammar structure.
- * 
- * The grammar productions are as follows:
- * 
- * Production 1: <program> ===> <otherFunctions> <mainFunction>
- * Production 2: <mainFunction> ===> TK_MAIN <stmts> TK_END
- * Production 3: <otherFunctions> ===> <function> <otherFunctions>
- * Production 4: <otherFunctions> ===> <eps>
- * Production 5: <function> ===> TK_FUNID <input_par> <output_par> TK_SEM <stmts> TK_END
- * Production 6: <input_par> ===> TK_INPUT TK_PARAMETER TK_LIST TK_SQL <parameter_list> TK_SQR
- * Production 7: <output_par> ===> TK_OUTPUT TK_PARAMETER TK_LIST TK_SQL <parameter_list> TK_SQR
- * Production 8: <output_par> ===> <eps>
- * Production 9: <parameter_list> ===> <dataType> TK_ID <remaining_list>
- * Production 10: <dataType> ===> <primitiveDataType>
- * Production 11: <dataType> ===> <constructedDataType>
- * Production 12: <primitiveDataType> ===> TK_INT
- * Production 13: <primitiveDataType> ===> TK_REAL
- * Production 14: <constructedDataType> ===> <A> TK_RUID
- * Production 15: <constructedDataType> ===> TK_RUID
- * Production 16: <remaining_list> ===> TK_COMMA <parameter_list>
- * Production 17: <remaining_list> ===> <eps>
- * Production 18: <stmts> ===> <typeDefinitions> <declarations> <otherStmts> <returnStmt>
- * Production 19: <typeDefinitions> ===> <actualOrRedefined> <typeDefinitions>
- * Production 20: <typeDefinitions> ===> <eps>
- * Production 21: <actualOrRedefined> ===> <typeDefinition>
- * Production 22: <actualOrRedefined> ===> <definetypestmt>
- * Production 23: <typeDefinition> ===> TK_RECORD TK_RUID <fieldDefinitions> TK_ENDRECORD
- * Production 24: <typeDefinition> ===> TK_UNION TK_RUID <fieldDefinitions> TK_ENDUNION
- * Production 25: <fieldDefinitions> ===> <fieldDefinition> <fieldDefinition> <moreFields>
- * Production 26: <fieldDefinition> ===> TK_TYPE <fieldType> TK_COLON TK_FIELDID TK_SEM
- * Production 27: <fieldType> ===> <primitiveDataType>
- * Production 28: <fieldType> ===> <constructedDataType>
- * Production 29: <moreFields> ===> <fieldDefinition> <moreFields>
- * Production 30: <moreFields> ===> <eps>
- * Production 31: <declarations> ===> <declaration> <declarations>
- * Production 32: <declarations> ===> <eps>
- * Production 33: <declaration> ===> TK_TYPE <dataType> TK_COLON TK_ID <global_or_not> TK_SEM
- * Production 34: <global_or_not> ===> TK_COLON TK_GLOBAL
- * Production 35: <global_or_not> ===> <eps>
- * Production 36: <otherStmts> ===> <stmt> <otherStmts>
- * Production 37: <otherStmts> ===> <eps>
- * Production 38: <stmt> ===> <assignmentStmt>
- * Production 39: <stmt> ===> <iterativeStmt>
- * Production 40: <stmt> ===> <conditionalStmt>
- * Production 41: <stmt> ===> <ioStmt>
- * Production 42: <stmt> ===> <funCallStmt>
- * Production 43: <assignmentStmt> ===> <SingleOrRecId> TK_ASSIGNOP <arithmeticExpression> TK_SEM
- * Production 44: <SingleOrRecId> ===> TK_ID <option_single_constructed>
- * Production 45: <option_single_constructed> ===> <oneExpansion> <moreExpansions>
- * Production 46: <option_single_constructed> ===> <eps>
- * Production 47: <moreExpansions> ===> <oneExpansion> <moreExpansions>
- * Production 48: <moreExpansions> ===> <eps>
- * Production 49: <oneExpansion> ===> TK_DOT TK_FIELDID
- * Production 50: <funCallStmt> ===> <outputParameters> TK_CALL TK_FUNID TK_WITH TK_PARAMETERS <inputParameters> TK_SEM
- * Production 51: <outputParameters> ===> TK_SQL <idList> TK_SQR TK_ASSIGNOP
- * Production 52: <outputParameters> ===> <eps>
- * Production 53: <inputParameters> ===> TK_SQL <idList> TK_SQR
- * Production 54: <iterativeStmt> ===> TK_WHILE TK_OP <booleanExpression> TK_CL <stmt> <otherStmts> TK_ENDWHILE
- * Production 55: <conditionalStmt> ===> TK_IF TK_OP <booleanExpression> TK_CL TK_THEN <stmt> <otherStmts> <elsePart>
- * Production 56: <elsePart> ===> TK_ELSE <stmt> <otherStmts> TK_ENDIF
- * Production 57: <elsePart> ===> TK_ENDIF
- * Production 58: <ioStmt> ===> TK_READ TK_OP <var> TK_CL TK_SEM
- * Production 59: <ioStmt> ===> TK_WRITE TK_OP <var> TK_CL TK_SEM
- * Production 60: <arithmeticExpression> ===> <term> <expPrime>
- * Production 61: <expPrime> ===> <lowPrecedenceOp> <term> <expPrime>
- * Production 62: <expPrime> ===> <eps>
- * Production 63: <term> ===> <factor> <termPrime>
- * Production 64: <termPrime> ===> <highPrecedenceOp> <factor> <termPrime>
- * Production 65: <termPrime> ===> <eps>
- * Production 66: <factor> ===> TK_OP <arithmeticExpression> TK_CL
- * Production 67: <factor> ===> <var>
- * Production 68: <lowPrecedenceOp> ===> TK_PLUS
- * Production 69: <lowPrecedenceOp> ===> TK_MINUS
- * Production 70: <highPrecedenceOp> ===> TK_MUL
- * Production 71: <highPrecedenceOp> ===> TK_DIV
- * Production 72: <booleanExpression> ===> TK_OP <booleanExpression> TK_CL <logicalOp> TK_OP <booleanExpression> TK_CL
- * Production 73: <booleanExpression> ===> <var> <relationalOp> <var>
- * Production 74: <booleanExpression> ===> TK_NOT TK_OP <booleanExpression> TK_CL
- * Production 75: <var> ===> <SingleOrRecId>
- * Production 76: <var> ===> TK_NUM
- * Production 77: <var> ===> TK_RNUM
- * Production 78: <logicalOp> ===> TK_AND
- * Production 79: <logicalOp> ===> TK_OR
- * Production 80: <relationalOp> ===> TK_LT
- * Production 81: <relationalOp> ===> TK_LE
- * Production 82: <relationalOp> ===> TK_EQ
- * Production 83: <relationalOp> ===> TK_GT
- * Production 84: <relationalOp> ===> TK_GE
- * Production 85: <relationalOp> ===> TK_NE
- * Production 86: <returnStmt> ===> TK_RETURN <optionalReturn> TK_SEM
- * Production 87: <optionalReturn> ===> TK_SQL <idList> TK_SQR
- * Production 88: <optionalReturn> ===> <eps>
- * Production 89: <idList> ===> TK_ID <more_ids>
- * Production 90: <more_ids> ===> TK_COMMA <idList>
- * Production 91: <more_ids> ===> <eps>
- * Production 92: <definetypestmt> ===> TK_DEFINETYPE <A> TK_RUID TK_AS TK_RUID
- * Production 93: <A> ===> TK_RECORD
- * Production 94: <A> ===> TK_UNION
+ * @brief Reparses the input under one node of a parse tree and splices the result in.
+ *
+ * The node is parsed again, with no error recovery, from the terminals
+ * [first, end) of the token sequence its subtree now covers. The new subtree
+ * replaces the old one only if the parse matches every one of those terminals
+ * and no other: the input before first and from end on is then parsed exactly
+ * as before, so the rest of the tree stays valid. Terminal nodes get the
+ * index of the token they match.
+ *
+ * @param tree The parse tree.
+ * @param node The node whose subtree is replaced; it keeps its index and parent.
+ * @param terminals Grammar terminals of the input; only [first, end) is read.
+ * @param first The first token of the node.
+ * @param end One past the last token of the node.
+ * @param follow Terminal of the token at end, 0 ($) if the input ends there.
+ * @return true if the subtree was replaced, false if the tree is unchanged.
  */
-grammar initialize_grammar()
+bool reparseSubtree(ParseTree *tree, uint32_t node, const uint8_t *terminals, uint32_t first, uint32_t end, int follow)
 {
-    VectorOfVector *gr = (VectorOfVector *)malloc(sizeof(VectorOfVector));
-    if (!gr)
-    {
-        fprintf(stderr, "Memory allocation error in initialize_grammar\n");
-        exit(EXIT_FAILURE);
-    }
-    initVectorOfVector(gr);
-
-    // Production 1: <program> ===> <otherFunctions> <mainFunction>
-    {
-        int arr1[] = {57, 58, 59, -1, -10, -10, -10, -10, -10, -10};
-        Vector *v1 = array_to_vector(arr1, 10);
-        // printf("\nsize of 0th vectir is %d \n",v1->size);
-        pushBackVector(gr, *v1);
-    }
-    // Production 2: <mainFunction> ===> TK_MAIN <stmts> TK_END
-    {
-        int arr2[] = {59, 1, 68, 2, -1, -10, -10, -10, -10, -10};
-        Vector *v2 = array_to_vector(arr2, 10);
-        pushBackVector(gr, *v2);
-    }
-    // Production 3: <otherFunctions> ===> <function> <otherFunctions>
-    {
-        int arr3[] = {58, 60, 58, -1, -10, -10, -10, -10, -10, -10};
-        Vector *v3 = array_to_vector(arr3, 10);
-        pushBackVector(gr, *v3);
-    }
-    // Production 4: <otherFunctions> ===> <eps>
-    {
-        int arr4[] = {58, 110, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v4 = array_to_vector(arr4, 10);
-        pushBackVector(gr, *v4);
-    }
-    // Production 5: <function> ===> TK_FUNID <input_par> <output_par> TK_SEM <stmts> TK_END
-    {
-        int arr5[] = {60, 3, 61, 62, 4, 68, 2, -1, -10, -10};
-        Vector *v5 = array_to_vector(arr5, 10);
-        pushBackVector(gr, *v5);
-    }
-    // Production 6: <input_par> ===> TK_INPUT TK_PARAMETER TK_LIST TK_SQL <parameter_list> TK_SQR
-    {
-        int arr6[] = {61, 5, 6, 7, 8, 63, 9, -1, -10, -10};
-        Vector *v6 = array_to_vector(arr6, 10);
-        pushBackVector(gr, *v6);
-    }
-    // Production 7: <output_par> ===> TK_OUTPUT TK_PARAMETER TK_LIST TK_SQL <parameter_list> TK_SQR
-    {
-        int arr7[] = {62, 10, 6, 7, 8, 63, 9, -1, -10, -10};
-        Vector *v7 = array_to_vector(arr7, 10);
-        pushBackVector(gr, *v7);
-    }
-    // Production 8: <output_par> ===> <eps>
-    {
-        int arr8[] = {62, 110, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v8 = array_to_vector(arr8, 10);
-        pushBackVector(gr, *v8);
-    }
-    // Production 9: <parameter_list> ===> <dataType> TK_ID <remaining_list>
-    {
-        int arr9[] = {63, 64, 56, 67, -1, -10, -10, -10, -10, -10};
-        Vector *v9 = array_to_vector(arr9, 10);
-        pushBackVector(gr, *v9);
-    }
-    // Production 10: <dataType> ===> <primitiveDataType>
-    {
-        int arr10[] = {64, 65, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v10 = array_to_vector(arr10, 10);
-        pushBackVector(gr, *v10);
-    }
-    // Production 11: <dataType> ===> <constructedDataType>
-    {
-        int arr11[] = {64, 66, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v11 = array_to_vector(arr11, 10);
-        pushBackVector(gr, *v11);
-    }
-    // Production 12: <primitiveDataType> ===> TK_INT
-    {
-        int arr12[] = {65, 11, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v12 = array_to_vector(arr12, 10);
-        pushBackVector(gr, *v12);
-    }
-    // Production 13: <primitiveDataType> ===> TK_REAL
-    {
-        int arr13[] = {65, 12, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v13 = array_to_vector(arr13, 10);
-        pushBackVector(gr, *v13);
-    }
-    // Production 14: <constructedDataType> ===> <A> TK_RUID
-    {
-        int arr14[] = {66, 109, 13, -1, -10, -10, -10, -10, -10, -10};
-        Vector *v14 = array_to_vector(arr14, 10);
-        pushBackVector(gr, *v14);
-    }
-    // Production 15: <constructedDataType> ===> TK_RUID
-    {
-        int arr15[] = {66, 13, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v15 = array_to_vector(arr15, 10);
-        pushBackVector(gr, *v15);
-    }
-    // Production 16: <remaining_list> ===> TK_COMMA <parameter_list>
-    {
-        int arr16[] = {67, 14, 63, -1, -10, -10, -10, -10, -10, -10};
-        Vector *v16 = array_to_vector(arr16, 10);
-        pushBackVector(gr, *v16);
-    }
-    // Production 17: <remaining_list> ===> <eps>
-    {
-        int arr17[] = {67, 110, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v17 = array_to_vector(arr17, 10);
-        pushBackVector(gr, *v17);
-    }
-    // Production 18: <stmts> ===> <typeDefinitions> <declarations> <otherStmts> <returnStmt>
-    {
-        int arr18[] = {68, 69, 76, 79, 104, -1, -10, -10, -10, -10};
-        Vector *v18 = array_to_vector(arr18, 10);
-        pushBackVector(gr, *v18);
-    }
-    // Production 19: <typeDefinitions> ===> <actualOrRedefined> <typeDefinitions>
-    {
-        int arr19[] = {69, 70, 69, -1, -10, -10, -10, -10, -10, -10};
-        Vector *v19 = array_to_vector(arr19, 10);
-        pushBackVector(gr, *v19);
-    }
-    // Production 20: <typeDefinitions> ===> <eps>
-    {
-        int arr20[] = {69, 110, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v20 = array_to_vector(arr20, 10);
-        pushBackVector(gr, *v20);
-    }
-    // Production 21: <actualOrRedefined> ===> <typeDefinition>
-    {
-        int arr21[] = {70, 71, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v21 = array_to_vector(arr21, 10);
-        pushBackVector(gr, *v21);
-    }
-    // Production 22: <actualOrRedefined> ===> <definetypestmt>
-    {
-        int arr22[] = {70, 108, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v22 = array_to_vector(arr22, 10);
-        pushBackVector(gr, *v22);
-    }
-    // Production 23: <typeDefinition> ===> TK_RECORD TK_RUID <fieldDefinitions> TK_ENDRECORD
-    {
-        int arr23[] = {71, 15, 13, 72, 16, -1, -10, -10, -10, -10};
-        Vector *v23 = array_to_vector(arr23, 10);
-        pushBackVector(gr, *v23);
-    }
-    // Production 24: <typeDefinition> ===> TK_UNION TK_RUID <fieldDefinitions> TK_ENDUNION
-    {
-        int arr24[] = {71, 17, 13, 72, 18, -1, -10, -10, -10, -10};
-        Vector *v24 = array_to_vector(arr24, 10);
-        pushBackVector(gr, *v24);
-    }
-    // Production 25: <fieldDefinitions> ===> <fieldDefinition> <fieldDefinition> <moreFields>
-    {
-        int arr25[] = {72, 73, 73, 75, -1, -10, -10, -10, -10, -10};
-        Vector *v25 = array_to_vector(arr25, 10);
-        pushBackVector(gr, *v25);
-    }
-    // Production 26: <fieldDefinition> ===> TK_TYPE <fieldType> TK_COLON TK_FIELDID TK_SEM
-    {
-        int arr26[] = {73, 19, 74, 20, 21, 4, -1, -10, -10, -10};
-        Vector *v26 = array_to_vector(arr26, 10);
-        pushBackVector(gr, *v26);
-    }
-    // Production 27: <fieldType> ===> <primitiveDataType>
-    {
-        int arr27[] = {74, 65, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v27 = array_to_vector(arr27, 10);
-        pushBackVector(gr, *v27);
-    }
-    // Production 28: <fieldType> ===> <constructedDataType>
-    {
-        int arr28[] = {74, 66, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v28 = array_to_vector(arr28, 10);
-        pushBackVector(gr, *v28);
-    }
-    // Production 29: <moreFields> ===> <fieldDefinition> <moreFields>
-    {
-        int arr29[] = {75, 73, 75, -1, -10, -10, -10, -10, -10, -10};
-        Vector *v29 = array_to_vector(arr29, 10);
-        pushBackVector(gr, *v29);
-    }
-    // Production 30: <moreFields> ===> <eps>
-    {
-        int arr30[] = {75, 110, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v30 = array_to_vector(arr30, 10);
-        pushBackVector(gr, *v30);
-    }
-    // Production 31: <declarations> ===> <declaration> <declarations>
-    {
-        int arr31[] = {76, 77, 76, -1, -10, -10, -10, -10, -10, -10};
-        Vector *v31 = array_to_vector(arr31, 10);
-        pushBackVector(gr, *v31);
-    }
-    // Production 32: <declarations> ===> <eps>
-    {
-        int arr32[] = {76, 110, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v32 = array_to_vector(arr32, 10);
-        pushBackVector(gr, *v32);
-    }
-    // Production 33: <declaration> ===> TK_TYPE <dataType> TK_COLON TK_ID <global_or_not> TK_SEM
-    {
-        int arr33[] = {77, 19, 64, 20, 56, 78, 4, -1, -10, -10};
-        Vector *v33 = array_to_vector(arr33, 10);
-        pushBackVector(gr, *v33);
-    }
-    // Production 34: <global_or_not> ===> TK_COLON TK_GLOBAL
-    {
-        int arr34[] = {78, 20, 22, -1, -10, -10, -10, -10, -10, -10};
-        Vector *v34 = array_to_vector(arr34, 10);
-        pushBackVector(gr, *v34);
-    }
-    // Production 35: <global_or_not> ===> <eps>
-    {
-        int arr35[] = {78, 110, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v35 = array_to_vector(arr35, 10);
-        pushBackVector(gr, *v35);
-    }
-    // Production 36: <otherStmts> ===> <stmt> <otherStmts>
-    {
-        int arr36[] = {79, 80, 79, -1, -10, -10, -10, -10, -10, -10};
-        Vector *v36 = array_to_vector(arr36, 10);
-        pushBackVector(gr, *v36);
-    }
-    // Production 37: <otherStmts> ===> <eps>
-    {
-        int arr37[] = {79, 110, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v37 = array_to_vector(arr37, 10);
-        pushBackVector(gr, *v37);
-    }
-    // Production 38: <stmt> ===> <assignmentStmt>
-    {
-        int arr38[] = {80, 81, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v38 = array_to_vector(arr38, 10);
-        pushBackVector(gr, *v38);
-    }
-    // Production 39: <stmt> ===> <iterativeStmt>
-    {
-        int arr39[] = {80, 89, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v39 = array_to_vector(arr39, 10);
-        pushBackVector(gr, *v39);
-    }
-    // Production 40: <stmt> ===> <conditionalStmt>
-    {
-        int arr40[] = {80, 90, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v40 = array_to_vector(arr40, 10);
-        pushBackVector(gr, *v40);
-    }
-    // Production 41: <stmt> ===> <ioStmt>
-    {
-        int arr41[] = {80, 92, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v41 = array_to_vector(arr41, 10);
-        pushBackVector(gr, *v41);
-    }
-    // Production 42: <stmt> ===> <funCallStmt>
-    {
-        int arr42[] = {80, 86, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v42 = array_to_vector(arr42, 10);
-        pushBackVector(gr, *v42);
-    }
-    // Production 43: <assignmentStmt> ===> <SingleOrRecId> TK_ASSIGNOP <arithmeticExpression> TK_SEM
-    {
-        int arr43[] = {81, 82, 23, 93, 4, -1, -10, -10, -10, -10};
-        Vector *v43 = array_to_vector(arr43, 10);
-        pushBackVector(gr, *v43);
-    }
-    // Production 44: <SingleOrRecId> ===> TK_ID <option_single_constructed>
-    {
-        int arr44[] = {82, 56, 83, -1, -10, -10, -10, -10, -10, -10};
-        Vector *v44 = array_to_vector(arr44, 10);
-        pushBackVector(gr, *v44);
-    }
-    // Production 45: <option_single_constructed> ===> <oneExpansion> <moreExpansions>
-    {
-        int arr45[] = {83, 84, 85, -1, -10, -10, -10, -10, -10, -10};
-        Vector *v45 = array_to_vector(arr45, 10);
-        pushBackVector(gr, *v45);
-    }
-    // Production 46: <option_single_constructed> ===> <eps>
-    {
-        int arr46[] = {83, 110, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v46 = array_to_vector(arr46, 10);
-        pushBackVector(gr, *v46);
-    }
-    // Production 47: <moreExpansions> ===> <oneExpansion> <moreExpansions>
-    {
-        int arr47[] = {85, 84, 85, -1, -10, -10, -10, -10, -10, -10};
-        Vector *v47 = array_to_vector(arr47, 10);
-        pushBackVector(gr, *v47);
-    }
-    // Production 48: <moreExpansions> ===> <eps>
-    {
-        int arr48[] = {85, 110, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v48 = array_to_vector(arr48, 10);
-        pushBackVector(gr, *v48);
-    }
-    // Production 49: <oneExpansion> ===> TK_DOT TK_FIELDID
-    {
-        int arr49[] = {84, 49, 21, -1, -10, -10, -10, -10, -10, -10};
-        Vector *v49 = array_to_vector(arr49, 10);
-        pushBackVector(gr, *v49);
-    }
-    // Production 50: <funCallStmt> ===> <outputParameters> TK_CALL TK_FUNID TK_WITH TK_PARAMETERS <inputParameters> TK_SEM
-    {
-        int arr50[] = {86, 87, 50, 3, 51, 52, 88, 4, -1, -10};
-        Vector *v50 = array_to_vector(arr50, 10);
-        pushBackVector(gr, *v50);
-    }
-    // Production 51: <outputParameters> ===> TK_SQL <idList> TK_SQR TK_ASSIGNOP
-    {
-        int arr51[] = {87, 8, 106, 9, 23, -1, -10, -10, -10, -10};
-        Vector *v51 = array_to_vector(arr51, 10);
-        pushBackVector(gr, *v51);
-    }
-    // Production 52: <outputParameters> ===> <eps>
-    {
-        int arr52[] = {87, 110, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v52 = array_to_vector(arr52, 10);
-        pushBackVector(gr, *v52);
-    }
-    // Production 53: <inputParameters> ===> TK_SQL <idList> TK_SQR
-    {
-        int arr53[] = {88, 8, 106, 9, -1, -10, -10, -10, -10, -10};
-        Vector *v53 = array_to_vector(arr53, 10);
-        pushBackVector(gr, *v53);
-    }
-    // Production 54: <iterativeStmt> ===> TK_WHILE TK_OP <booleanExpression> TK_CL <stmt> <otherStmts> TK_ENDWHILE
-    {
-        int arr54[] = {89, 24, 25, 100, 26, 80, 79, 55, -1, -10};
-        Vector *v54 = array_to_vector(arr54, 10);
-        pushBackVector(gr, *v54);
-    }
-    // Production 55: <conditionalStmt> ===> TK_IF TK_OP <booleanExpression> TK_CL TK_THEN <stmt> <otherStmts> <elsePart>
-    {
-        int arr55[] = {90, 27, 25, 100, 26, 28, 80, 79, 91, -1};
-        Vector *v55 = array_to_vector(arr55, 10);
-        pushBackVector(gr, *v55);
-    }
-    // Production 56: <elsePart> ===> TK_ELSE <stmt> <otherStmts> TK_ENDIF
-    {
-        int arr56[] = {91, 29, 80, 79, 30, -1, -10, -10, -10, -10};
-        Vector *v56 = array_to_vector(arr56, 10);
-        pushBackVector(gr, *v56);
-    }
-    // Production 57: <elsePart> ===> TK_ENDIF
-    {
-        int arr57[] = {91, 30, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v57 = array_to_vector(arr57, 10);
-        pushBackVector(gr, *v57);
-    }
-    // Production 58: <ioStmt> ===> TK_READ TK_OP <var> TK_CL TK_SEM
-    {
-        int arr58[] = {92, 31, 25, 101, 26, 4, -1, -10, -10, -10};
-        Vector *v58 = array_to_vector(arr58, 10);
-        pushBackVector(gr, *v58);
-    }
-    // Production 59: <ioStmt> ===> TK_WRITE TK_OP <var> TK_CL TK_SEM
-    {
-        int arr59[] = {92, 32, 25, 101, 26, 4, -1, -10, -10, -10};
-        Vector *v59 = array_to_vector(arr59, 10);
-        pushBackVector(gr, *v59);
-    }
-    // Production 60: <arithmeticExpression> ===> <term> <expPrime>
-    {
-        int arr60[] = {93, 95, 94, -1, -10, -10, -10, -10, -10, -10};
-        Vector *v60 = array_to_vector(arr60, 10);
-        pushBackVector(gr, *v60);
-    }
-    // Production 61: <expPrime> ===> <lowPrecedenceOp> <term> <expPrime>
-    {
-        int arr61[] = {94, 98, 95, 94, -1, -10, -10, -10, -10, -10};
-        Vector *v61 = array_to_vector(arr61, 10);
-        pushBackVector(gr, *v61);
-    }
-    // Production 62: <expPrime> ===> <eps>
-    {
-        int arr62[] = {94, 110, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v62 = array_to_vector(arr62, 10);
-        pushBackVector(gr, *v62);
-    }
-    // Production 63: <term> ===> <factor> <termPrime>
-    {
-        int arr63[] = {95, 97, 96, -1, -10, -10, -10, -10, -10, -10};
-        Vector *v63 = array_to_vector(arr63, 10);
-        pushBackVector(gr, *v63);
-    }
-    // Production 64: <termPrime> ===> <highPrecedenceOp> <factor> <termPrime>
-    {
-        int arr64[] = {96, 99, 97, 96, -1, -10, -10, -10, -10, -10};
-        Vector *v64 = array_to_vector(arr64, 10);
-        pushBackVector(gr, *v64);
+    uint32_t mark = tree->nodeCount;
+    uint32_t root = addTreeNodes(tree, 1, tree->nodes[node].parent);
+    tree->nodes[root].symbolID = tree->nodes[node].symbolID;
+
+    Stack s;
+    createStack(&s, 16);
+    pushStack(&s, root);
+    uint32_t next = first, top;
+    bool matched = true;
+    while (matched && topStack(&s, &top))
+    {
+        int lookahead = next < end ? terminals[next] : follow;
+        TreeNode *topNode = &tree->nodes[top];
+        if (topNode->isTerminal)
+        {
+            matched = topNode->symbolID == lookahead && next < end;
+            if (matched)
+            {
+                topNode->token = next++;
+                popStack(&s);
+            }
+            continue;
+        }
+        int rule = parseTableEntry(T, topNode->symbolID, lookahead);
+        matched = rule >= 0;
+        if (matched)
+        {
+            popStack(&s);
+            expandTreeNode(tree, &s, top, G->rules[rule]);
+        }
     }
-    // Production 65: <termPrime> ===> <eps>
+    deleteStack(&s);
+    if (!matched || next != end)
     {
-        int arr65[] = {96, 110, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v65 = array_to_vector(arr65, 10);
-        pushBackVector(gr, *v65);
+        tree->nodeCount = mark;
+        return false;
     }
-    // Production 66: <factor> ===> TK_OP <arithmeticExpression> TK_CL
+
+    // The new root's children move under the old node; the root itself is left unreachable
+    TreeNode *slot = &tree->nodes[node];
+    slot->numChildren = tree->nodes[root].numChildren;
+    slot->firstChild = tree->nodes[root].firstChild;
+    for (int i = 0; i < slot->numChildren; i++)
+        tree->nodes[slot->firstChild + i].parent = node;
+    return true;
+}
+
+// Pushes the symbols and actions of a production right to left; each action
+// sits on top of the semantic stack height it folds back to
+static void pushAstRule(Stack *s, int rule, uint32_t mark)
+{
+    int n = 0;
+    while (astRules[rule][n] != -1)
+        n++;
+    for (int i = n - 1; i >= 0; i--)
     {
-        int arr66[] = {97, 25, 93, 26, -1, -10, -10, -10, -10, -10};
-        Vector *v66 = array_to_vector(arr66, 10);
-        pushBackVector(gr, *v66);
+        if (astRules[rule][i] >= AST_ACTION_BASE)
+            pushStack(s, mark);
+        pushStack(s, (uint32_t)astRules[rule][i]);
     }
-    // Production 67: <factor> ===> <var>
+}
+
+// Pops an action and its mark off the parse stack and runs it
+static void runAstAction(Stack *s, uint32_t action, Ast *ast)
+{
+    uint32_t mark = 0;
+    popStack(s);
+    topStack(s, &mark);
+    popStack(s);
+    astAction(ast, (int)action, mark);
+}
+
+/**
+ * @brief Processes one token in AST mode.
+ *
+ * The LL(1) decisions, diagnostics and error recovery are those of parseToken(),
+ * but the stack holds grammar symbols and the semantic actions of astRules[]
+ * instead of parse-tree nodes, so no concrete tree is built: kept tokens become
+ * AST leaves and each action folds its production's values into one node.
+ *
+ * @param ts The token to be parsed.
+ * @param T The parse table used for parsing.
+ * @param s The parse stack of symbols and actions.
+ * @param ast The AST being built.
+ */
+void astParseToken(Token ts, parsetable T, Stack *s, Ast *ast)
+{
+    if (ts.cat != NORMAL)
     {
-        int arr67[] = {97, 101, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v67 = array_to_vector(arr67, 10);
-        pushBackVector(gr, *v67);
+        reportLexicalError(ts);
+        return;
     }
-    // Production 68: <lowPrecedenceOp> ===> TK_PLUS
+    if (ts.type == TK_COMMENT)
+        return;
+    bool er_fl = false;
+    int indx = indexoftoken(ts);
+
+    uint32_t top;
+    while (topStack(s, &top))
     {
-        int arr68[] = {98, 33, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v68 = array_to_vector(arr68, 10);
-        pushBackVector(gr, *v68);
+        if (top >= AST_ACTION_BASE)
+        {
+            runAstAction(s, top, ast);
+            continue;
+        }
+        TRACE(&parserTrace, TRACE_STACK_TOP, &ts, top);
+
+        if (top < NONTERMINALS_START)
+        {
+            popStack(s);
+            if ((int)top == indx)
+            {
+                if (astKeepsToken(indx))
+                    astPushLeaf(ast, indx, ts.lexeme, ts.lineNo);
+                TRACE(&parserTrace, TRACE_MATCH, &ts, top);
+                return;
+            }
+            if (er_fl == false)
+            {
+                TRACE(&parserTrace, TRACE_MISMATCH_ERROR, &ts, top);
+                fprintf(messages(), "[Parser Error] Line %d Error: The token %s for lexeme %s does not match with the expected token %s\n", ts.lineNo, getTokenStr(ts.type), lexemeText(ts.lexeme), grammarTerms[top]);
+            }
+            TRACE(&parserTrace, TRACE_POP_TERMINAL, &ts, top);
+            er_fl = true;
+            issyntaxcorrect = false;
+            continue;
+        }
+
+        int rule = parseTableEntry(T, top, indx);
+        if (rule == -1)
+        {
+            TRACE(&parserTrace, TRACE_NO_RULE, &ts, top);
+            if (er_fl == false)
+            {
+                TRACE(&parserTrace, TRACE_NO_RULE_ERROR, &ts, top);
+                fprintf(messages(), "[Parser Error] Line %d Error: Invalid token %s encountered with the value %s stack top %s\n", ts.lineNo, getTokenStr(ts.type), lexemeText(ts.lexeme), grammarTerms[top]);
+            }
+            issyntaxcorrect = false;
+            return;
+        }
+        popStack(s);
+        if (rule == SYNCRO)
+        {
+            TRACE(&parserTrace, TRACE_SYNC, &ts, top);
+            if (er_fl == false)
+            {
+                fprintf(messages(), "[Parser Error] Line %d Error: Invalid token %s encountered with the value %s stack top %s\n", ts.lineNo, getTokenStr(ts.type), lexemeText(ts.lexeme), grammarTerms[top]);
+                TRACE(&parserTrace, TRACE_SYNC_ERROR, &ts, top);
+            }
+            TRACE(&parserTrace, TRACE_POP_NONTERMINAL, &ts, top);
+            issyntaxcorrect = false;
+            er_fl = true;
+            continue;
+        }
+        TRACE(&parserTrace, TRACE_RULE, &ts, rule);
+        pushAstRule(s, rule, ast->valueCount);
     }
-    // Production 69: <lowPrecedenceOp> ===> TK_MINUS
+}
+
+/**
+ * @brief Builds the AST of a source file without building its parse tree.
+ *
+ * @param testcaseFile The path to the file containing the source code to be parsed.
+ * @param T The parse table used for parsing the source code.
+ * @param ast The empty AST to build.
+ * @param streaming Pull tokens from the lexer during parsing instead of lexing the whole file first.
+ */
+void buildAstFromSource(char *testcaseFile, parsetable T, Ast *ast, bool streaming)
+{
+    Stack s;
+    createStack(&s, 16);
+    pushStack(&s, NONTERMINALS_START);
+
+    Token t;
+    if (streaming)
     {
-        int arr69[] = {98, 34, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v69 = array_to_vector(arr69, 10);
-        pushBackVector(gr, *v69);
+        fprintf(messages(), "[INFO] Streaming tokens from the lexer into the parser...\n");
+        Lexer *L = openLexer(testcaseFile);
+        while (readToken(L, &t))
+            astParseToken(t, T, &s, ast);
+        sz = L->tokenCount;
+        destroyLexer(L);
     }
-    // Production 70: <highPrecedenceOp> ===> TK_MUL
+    else
     {
-        int arr70[] = {99, 35, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v70 = array_to_vector(arr70, 10);
-        pushBackVector(gr, *v70);
+        TokenStream *tokens = togettokens(testcaseFile);
+        for (uint32_t i = 0; i < sz; i++)
+        {
+            tokenAt(tokens, i, &t);
+            astParseToken(t, T, &s, ast);
+        }
+        destroyTokenStream(tokens);
     }
-    // Production 71: <highPrecedenceOp> ===> TK_DIV
+
+    // Input is over: run the actions still pending, e.g. those of <program>
+    uint32_t top;
+    while (topStack(&s, &top))
     {
-        int arr71[] = {99, 36, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v71 = array_to_vector(arr71, 10);
-        pushBackVector(gr, *v71);
+        if (top >= AST_ACTION_BASE)
+            runAstAction(&s, top, ast);
+        else
+            popStack(&s);
     }
-    // Production 72: <booleanExpression> ===> TK_OP <booleanExpression> TK_CL <logicalOp> TK_OP <booleanExpression> TK_CL
+    deleteStack(&s);
+}
+#define TREE_OUT_SIZE (1 << 20) // Bytes formatted before each write()
+#define TREE_TEXT_SIZE (1 << 16) // Initial buffer of formatParseTree(), doubled as needed
+#define TREE_VALUE_SIZE 320 // Longest "%.5f" of a double: 309 integer digits, sign, point, 5 decimals
+#define TREE_VISIT_EMIT TREE_KEEP_NODE // Walk stack entry: print the node, don't expand it
+#define TREE_STREAM_SLACK (1u << 16) // Printed nodes a streaming parse lets pile up before dropping them
+
+/* Output buffer of the parse tree printer; with fd < 0 it grows to hold the whole tree */
+typedef struct
+{
+    char *data;
+    size_t used;
+    size_t capacity;
+    int fd;
+} TreeOut;
+
+static void flushTreeOut(TreeOut *out)
+{
+    if (out->fd < 0)
     {
-        int arr72[] = {100, 25, 100, 26, 102, 25, 100, 26, -1, -10};
-        Vector *v72 = array_to_vector(arr72, 10);
-        pushBackVector(gr, *v72);
+        out->capacity *= 2;
+        out->data = (char *)realloc(out->data, out->capacity);
+        if (out->data == NULL)
+        {
+            fprintf(stderr, "Memory allocation failed in flushTreeOut\n");
+            exit(1);
+        }
+        return;
     }
-    // Production 73: <booleanExpression> ===> <var> <relationalOp> <var>
+    size_t done = 0;
+    while (done < out->used)
     {
-        int arr73[] = {100, 101, 103, 101, -1, -10, -10, -10, -10, -10};
-        Vector *v73 = array_to_vector(arr73, 10);
-        pushBackVector(gr, *v73);
+        ssize_t n = write(out->fd, out->data + done, out->used - done);
+        if (n < 0)
+        {
+            perror("Error in writing the parse tree");
+            exit(1);
+        }
+        done += (size_t)n;
     }
-    // Production 74: <booleanExpression> ===> TK_NOT TK_OP <booleanExpression> TK_CL
+    out->used = 0;
+}
+
+// Appends s followed by spaces up to width, like "%-<width>s", then "\t ";
+// keeps a byte spare for the newline that ends the line
+static void putTreeField(TreeOut *out, const char *s, int width)
+{
+    size_t len = strlen(s);
+    if (out->used + len + width + 3 > out->capacity)
+        flushTreeOut(out);
+    if (out->used + len + width + 3 > out->capacity)
     {
-        int arr74[] = {100, 37, 25, 100, 26, -1, -10, -10, -10, -10};
-        Vector *v74 = array_to_vector(arr74, 10);
-        pushBackVector(gr, *v74);
+        // Lexemes are bounded by BUFFER_SIZE; never expected
+        fprintf(stderr, "Parse tree field too long\n");
+        exit(1);
     }
-    // Production 75: <var> ===> <SingleOrRecId>
+    memcpy(out->data + out->used, s, len);
+    out->used += len;
+    for (int pad = width - (int)len; pad > 0; pad--)
+        out->data[out->used++] = ' ';
+    out->data[out->used++] = '\t';
+    out->data[out->used++] = ' ';
+}
+
+/**
+ * @brief Formats one node of the parse tree as a line of the output.
+ *
+ * @param tree The parse tree.
+ * @param n Index of the node to print.
+ * @param parentSymbol Grammar symbol of the node's parent, -1 for the root.
+ * @param out The output buffer.
+ */
+static void printTreeNode(const ParseTree *tree, uint32_t n, int parentSymbol, TreeOut *out)
+{
+    const TreeNode *node = &tree->nodes[n];
+    const char *lexeme = "";
+    int lineno = 0;
+    LexemeId id = LEXEME_EMPTY;
+    if (node->token != TREE_NO_TOKEN)
     {
-        int arr75[] = {101, 82, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v75 = array_to_vector(arr75, 10);
-        pushBackVector(gr, *v75);
+        id = tree->tokens[node->token].lexeme;
+        lexeme = lexemeText(id);
+        lineno = tree->tokens[node->token].lineNo;
     }
-    // Production 76: <var> ===> TK_NUM
+    const char *leaf = "yes";
+    if (node->numChildren == 0)
     {
-        int arr76[] = {101, 53, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v76 = array_to_vector(arr76, 10);
-        pushBackVector(gr, *v76);
+        if (node->symbolID == EPSILON)
+            lexeme = "eps";
     }
-    // Production 77: <var> ===> TK_RNUM
+    else
     {
-        int arr77[] = {101, 54, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v77 = array_to_vector(arr77, 10);
-        pushBackVector(gr, *v77);
+        leaf = "no";
+        lexeme = "----";
     }
-    // Production 78: <logicalOp> ===> TK_AND
+
+    char lineNo[16], value[TREE_VALUE_SIZE];
+    snprintf(lineNo, sizeof(lineNo), "%d", lineno);
+    const char *symbol = grammarTerms[node->symbolID];
+    const char *parent = "$";
+    const char *number = "----";
+    if (parentSymbol < 0)
+        lexeme = "----";
+    else
     {
-        int arr78[] = {102, 38, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v78 = array_to_vector(arr78, 10);
-        pushBackVector(gr, *v78);
+        parent = grammarTerms[parentSymbol];
+        // The lexer cached the value of every number lexeme in the pool
+        if (node->symbolID == SYM_TK_NUM)
+        {
+            snprintf(value, sizeof(value), "%d", (int)internedValue(lexemePool(), id));
+            number = value;
+        }
+        else if (node->symbolID == SYM_TK_RNUM)
+        {
+            snprintf(value, sizeof(value), "%.5f", internedValue(lexemePool(), id));
+            number = value;
+        }
     }
-    // Production 79: <logicalOp> ===> TK_OR
+
+    putTreeField(out, lexeme, 15);
+    putTreeField(out, lineNo, 3);
+    putTreeField(out, symbol, 22);
+    putTreeField(out, number, 10);
+    putTreeField(out, parent, 22);
+    putTreeField(out, leaf, 4);
+    putTreeField(out, symbol, 22);
+    out->data[out->used++] = '\n';
+}
+
+/**
+ * @brief Prints every node of the parse tree, in order, into the output buffer.
+ *
+ * A node is printed after the subtree of its first child and before the
+ * subtrees of its other children. The walk keeps its own stack instead of
+ * recursing, so deep expression chains cannot overflow the call stack.
+ *
+ * @param tree The parse tree.
+ * @param out The output buffer.
+ */
+static void printTreeNodes(const ParseTree *tree, TreeOut *out)
+{
+    uint32_t capacity = 256, depth = 0;
+    uint32_t *stack = (uint32_t *)malloc(capacity * sizeof(uint32_t));
+    if (stack == NULL)
     {
-        int arr79[] = {102, 39, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v79 = array_to_vector(arr79, 10);
-        pushBackVector(gr, *v79);
+        fprintf(stderr, "Memory allocation failed in printTreeNodes\n");
+        exit(1);
     }
-    // Production 80: <relationalOp> ===> TK_LT
+    stack[depth++] = 0;
+
+    while (depth > 0)
     {
-        int arr80[] = {103, 40, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v80 = array_to_vector(arr80, 10);
-        pushBackVector(gr, *v80);
+        uint32_t entry = stack[--depth];
+        uint32_t n = entry & ~TREE_VISIT_EMIT;
+        const TreeNode *node = &tree->nodes[n];
+        if ((entry & TREE_VISIT_EMIT) || node->numChildren == 0)
+        {
+            printTreeNode(tree, n, node->parent == TREE_NO_NODE ? -1 : tree->nodes[node->parent].symbolID, out);
+            continue;
+        }
+
+        // Pushed in reverse: first child's subtree, the node, then the rest
+        if (depth + node->numChildren + 1 > capacity)
+        {
+            capacity = 2 * capacity + node->numChildren + 1;
+            stack = (uint32_t *)realloc(stack, capacity * sizeof(uint32_t));
+            if (stack == NULL)
+            {
+                fprintf(stderr, "Memory allocation failed in printTreeNodes\n");
+                exit(1);
+            }
+        }
+        for (int i = node->numChildren - 1; i >= 1; i--)
+            stack[depth++] = node->firstChild + i;
+        stack[depth++] = n | TREE_VISIT_EMIT;
+        stack[depth++] = node->firstChild;
     }
-    // Production 81: <relationalOp> ===> TK_LE
+    free(stack);
+}
+
+// Allocates the buffer and puts the header line in it
+static void startTreeOut(TreeOut *out)
+{
+    out->data = (char *)malloc(out->capacity);
+    if (out->data == NULL)
     {
-        int arr81[] = {103, 41, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v81 = array_to_vector(arr81, 10);
-        pushBackVector(gr, *v81);
+        fprintf(stderr, "Memory allocation failed in printParseTree\n");
+        exit(1);
     }
-    // Production 82: <relationalOp> ===> TK_EQ
+    out->used = (size_t)snprintf(out->data, out->capacity, "%-15s %-3s %-22s %-10s %-22s %-4s %-22s\n", "Lexeme", "LineNo", "TokenName", "ValueIfNumber", "Parent", "isLeaf  ", "Node");
+}
+
+/**
+ * @brief Prints the parse tree to a specified output file.
+ *
+ * This function takes a parse tree and an output file path,
+ * and writes the parse tree to the file in a formatted manner.
+ * Lines are formatted into a 1 MB buffer that is written out whenever it fills.
+ *
+ * @param tree The parse tree.
+ * @param outfile Path to the output file where the parse tree will be written.
+ *
+ * @note The output file will be overwritten if it already exists.
+ *       If the file cannot be opened, the function will print an error message
+ *       and terminate the program.
+ */
+void printParseTree(const ParseTree *tree, char *outfile)
+{
+    TreeOut out = {NULL, 0, TREE_OUT_SIZE, open(outfile, O_WRONLY | O_CREAT | O_TRUNC, 0644)};
+    if (out.fd < 0)
     {
-        int arr82[] = {103, 42, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v82 = array_to_vector(arr82, 10);
-        pushBackVector(gr, *v82);
+        printf("Error in opening the file");
+        exit(1);
     }
-    // Production 83: <relationalOp> ===> TK_GT
+    startTreeOut(&out);
+    printTreeNodes(tree, &out);
+    flushTreeOut(&out);
+    free(out.data);
+    close(out.fd);
+}
+
+/**
+ * @brief Formats the parse tree in memory, exactly as printParseTree() writes it.
+ *
+ * @param tree The parse tree.
+ * @param length Set to the length of the text.
+ * @return char* The text, to be freed by the caller (not NUL-terminated).
+ */
+char *formatParseTree(const ParseTree *tree, size_t *length)
+{
+    TreeOut out = {NULL, 0, TREE_TEXT_SIZE, -1};
+    startTreeOut(&out);
+    printTreeNodes(tree, &out);
+    *length = out.used;
+    return out.data;
+}
+
+/*
+ * Parse tree printer that keeps pace with a streaming parse. It walks the
+ * tree in the order of printTreeNodes(), but stops at the first leaf the
+ * parse has not reached yet: the top of the parse stack. The parse expands
+ * the leftmost pending node first, so everything before that leaf is final.
+ * Printed nodes are dropped from the tree now and then (retainTreeNodes()).
+ * The walk remembers each entry's parent symbol, because a printed node's
+ * parent may already have been dropped.
+ */
+struct TreeStream
+{
+    TreeOut out;
+    char *path;       // Written to <outfile>.part, renamed on success
+    char *outfile;
+    uint32_t *walk;   // Walk stack, as in printTreeNodes()
+    int *parents;     // Parent symbol of each walk entry, -1 for the root
+    uint32_t depth;
+    uint32_t capacity;
+    uint32_t retained; // Nodes left by the last compaction
+};
+
+static TreeStream *openTreeStream(const char *outfile)
+{
+    TreeStream *ts = (TreeStream *)calloc(1, sizeof(TreeStream));
+    size_t len = strlen(outfile);
+    if (ts)
     {
-        int arr83[] = {103, 43, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v83 = array_to_vector(arr83, 10);
-        pushBackVector(gr, *v83);
+        ts->outfile = strdup(outfile);
+        ts->path = (char *)malloc(len + sizeof(".part"));
+        ts->capacity = 256;
+        ts->walk = (uint32_t *)malloc(ts->capacity * sizeof(uint32_t));
+        ts->parents = (int *)malloc(ts->capacity * sizeof(int));
     }
-    // Production 84: <relationalOp> ===> TK_GE
+    if (!ts || !ts->outfile || !ts->path || !ts->walk || !ts->parents)
     {
-        int arr84[] = {103, 44, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v84 = array_to_vector(arr84, 10);
-        pushBackVector(gr, *v84);
+        fprintf(stderr, "Memory allocation failed in openTreeStream\n");
+        exit(1);
     }
-    // Production 85: <relationalOp> ===> TK_NE
+    memcpy(ts->path, outfile, len);
+    memcpy(ts->path + len, ".part", sizeof(".part"));
+    ts->out = (TreeOut){NULL, 0, TREE_OUT_SIZE, open(ts->path, O_WRONLY | O_CREAT | O_TRUNC, 0644)};
+    if (ts->out.fd < 0)
     {
-        int arr85[] = {103, 45, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v85 = array_to_vector(arr85, 10);
-        pushBackVector(gr, *v85);
+        perror(ts->path);
+        exit(1);
     }
-    // Production 86: <returnStmt> ===> TK_RETURN <optionalReturn> TK_SEM
-    {
-        int arr86[] = {104, 46, 105, 4, -1, -10, -10, -10, -10, -10};
-        Vector *v86 = array_to_vector(arr86, 10);
-        pushBackVector(gr, *v86);
+    startTreeOut(&ts->out);
+    ts->walk[0] = 0; // The root, which createParseStack() just added
+    ts->parents[0] = -1;
+    ts->depth = 1;
+    return ts;
+}
+
+/**
+ * @brief Prints what the parse has finished of the tree and drops it once enough has piled up.
+ *
+ * @param ts The printer.
+ * @param tree The parse tree.
+ * @param s The parse stack; NULL once the input has ended, to print the rest.
+ */
+static void advanceTreeStream(TreeStream *ts, ParseTree *tree, Stack *s)
+{
+    uint32_t pending = TREE_NO_NODE;
+    if (s)
+        topStack(s, &pending);
+    while (ts->depth > 0)
+    {
+        uint32_t entry = ts->walk[ts->depth - 1];
+        uint32_t n = entry & ~TREE_VISIT_EMIT;
+        const TreeNode *node = &tree->nodes[n];
+        if ((entry & TREE_VISIT_EMIT) || node->numChildren == 0)
+        {
+            if (n == pending)
+                break;
+            ts->depth--;
+            printTreeNode(tree, n, ts->parents[ts->depth], &ts->out);
+            continue;
+        }
+
+        int parent = ts->parents[--ts->depth];
+        if (ts->depth + node->numChildren + 1 > ts->capacity)
+        {
+            ts->capacity = 2 * ts->capacity + node->numChildren + 1;
+            ts->walk = (uint32_t *)realloc(ts->walk, ts->capacity * sizeof(uint32_t));
+            ts->parents = (int *)realloc(ts->parents, ts->capacity * sizeof(int));
+            if (!ts->walk || !ts->parents)
+            {
+                fprintf(stderr, "Memory allocation failed in advanceTreeStream\n");
+                exit(1);
+            }
+        }
+        for (int i = node->numChildren - 1; i >= 1; i--)
+        {
+            ts->walk[ts->depth] = node->firstChild + i;
+            ts->parents[ts->depth++] = node->symbolID;
+        }
+        ts->walk[ts->depth] = n | TREE_VISIT_EMIT;
+        ts->parents[ts->depth++] = parent;
+        ts->walk[ts->depth] = node->firstChild;
+        ts->parents[ts->depth++] = node->symbolID;
     }
-    // Production 87: <optionalReturn> ===> TK_SQL <idList> TK_SQR
+
+    // Every node still needed is under a walk entry; the parse stack only refers to such nodes
+    if (s && tree->nodeCount > 2 * ts->retained + TREE_STREAM_SLACK)
     {
-        int arr87[] = {105, 8, 106, 9, -1, -10, -10, -10, -10, -10};
-        Vector *v87 = array_to_vector(arr87, 10);
-        pushBackVector(gr, *v87);
+        retainTreeNodes(tree, ts->walk, ts->depth, s->array, (uint32_t)(s->top + 1));
+        ts->retained = tree->nodeCount;
     }
-    // Production 88: <optionalReturn> ===> <eps>
-    {
-        int arr88[] = {105, 110, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v88 = array_to_vector(arr88, 10);
-        pushBackVector(gr, *v88);
+}
+
+/**
+ * @brief Prints the rest of the tree and puts the file in place, or removes it.
+ *
+ * @param keep Rename the output to the requested file; false removes it.
+ */
+static void closeTreeStream(TreeStream *ts, ParseTree *tree, bool keep)
+{
+    advanceTreeStream(ts, tree, NULL);
+    flushTreeOut(&ts->out);
+    close(ts->out.fd);
+    if (!keep)
+        unlink(ts->path);
+    else if (rename(ts->path, ts->outfile) != 0)
+    {
+        perror(ts->outfile);
+        exit(1);
     }
-    // Production 89: <idList> ===> TK_ID <more_ids>
+    free(ts->out.data);
+    free(ts->walk);
+    free(ts->parents);
+    free(ts->path);
+    free(ts->outfile);
+    free(ts);
+}
+
+
+/**
+ * @brief Prints the FIRST and FOLLOW sets and the parse table.
+ *
+ * The tables are generated at build time (grammarDef.h), so this only writes
+ * first_out.txt, follow_out.txt and parse_table_output.txt; a batch run calls
+ * it once for all of its files.
+ */
+void printGrammarTables(void)
+{
+    initTableLogFile();
+    print_first_set(F, G);
+    fprintf(messages(), "[INFO] First Set has been printed successfully in first_out.txt ...\n");
+    print_follow_set(F, G);
+    fprintf(messages(), "[INFO] Follow Set has been printed successfully in follow_out.txt ...\n");
+
+    printTable(T);
+    fprintf(messages(), "[INFO] Parse table has been printed successfully in parse_table_ouput.txt ...\n");
+    closeTableLogFile();
+}
+
+/**
+ * @brief Opens the parse log before parsing, so that a full trace ring is spilled to it.
+ *
+ * With PARSER_TRACE_FILE set the ring grows instead, so that the saved trace
+ * keeps every event.
+ *
+ * @param logPath Path the parser trace is rendered to.
+ * @return true if tracing is off or the log is open, false if it could not be opened (reported on stderr).
+ */
+static bool openParseLog(const char *logPath)
+{
+    if (parserTrace.level == TRACE_OFF)
+        return true;
+    initLogFile(logPath);
+    if (logFile == NULL)
+        return false;
+    if (!getenv("PARSER_TRACE_FILE"))
+        traceSpillTo(&parserTrace, G, lexemePool(), logFile);
+    return true;
+}
+
+/**
+ * @brief Renders the events left in the trace ring and closes the parse log.
+ */
+static void closeParseLog(void)
+{
+    if (logFile != NULL)
+        renderTrace(&parserTrace, G, lexemePool()->text, logFile);
+    traceSpillTo(&parserTrace, NULL, NULL, NULL);
+    closeLogFile();
+}
+
+/**
+ * @brief Parses one source file and writes its parse log and parse tree.
+ *
+ * @param testfile Path to the input source code file to be parsed.
+ * @param outfile Path to the output file where the parse tree will be printed if the code is syntactically correct.
+ * @param logPath Path the parser trace is rendered to (see trace.h).
+ * @param streaming Pull tokens from the lexer during parsing instead of lexing the whole file first.
+ * @return true if the code is syntactically correct, false too if the log could not be opened.
+ */
+bool parseFile(char *testfile, char *outfile, const char *logPath, bool streaming)
+{
+    if (parserTrace.events == NULL)
+        traceInit(&parserTrace);
+    traceReset(&parserTrace);
+    issyntaxcorrect = true;
+
+    if (!openParseLog(logPath))
+        return false;
+    ParseTree *tree = createParseTree();
+    if (streaming)
+        parseInputSourceStream(testfile,T,G,tree,outfile);
+    else
+        parseInputSourceCode(testfile,T,G,tree);
+    if (parserTrace.level != TRACE_OFF)
     {
-        int arr89[] = {106, 56, 107, -1, -10, -10, -10, -10, -10, -10};
-        Vector *v89 = array_to_vector(arr89, 10);
-        pushBackVector(gr, *v89);
+        closeParseLog();
+        fprintf(messages(), "[INFO] Entire Parsing Process and Logic is printed successfully in %s ...\n", logPath);
     }
-    // Production 90: <more_ids> ===> TK_COMMA <idList>
-    {
-        int arr90[] = {107, 14, 106, -1, -10, -10, -10, -10, -10, -10};
-        Vector *v90 = array_to_vector(arr90, 10);
-        pushBackVector(gr, *v90);
+    else
+        fprintf(messages(), "[INFO] Parser tracing is off so %s is not written\n", logPath);
+    const char *traceFile = getenv("PARSER_TRACE_FILE");
+    if (traceFile && saveTrace(&parserTrace, lexemePool(), traceFile))
+        fprintf(messages(), "[INFO] Binary parser trace saved in %s, render it with tools/tracedump ...\n", traceFile);
+    if(issyntaxcorrect){ 
+         fprintf(messages(), "[INFO] Code is syntactically correct so parse tree is generated successfully in %s ...\n\n",outfile);
+        if (!streaming)
+            printParseTree(tree,outfile);}
+    else{
+        fprintf(messages(), "[INFO] Code is syntactically incorrect so parse tree is constructed but printParseTree is not called\n\n");
     }
-    // Production 91: <more_ids> ===> <eps>
-    {
-        int arr91[] = {107, 110, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v91 = array_to_vector(arr91, 10);
-        pushBackVector(gr, *v91);
+    destroyParseTree(tree);
+    return issyntaxcorrect;
+}
+
+// Reads the wall clock and the calling thread's CPU clock
+static void markPhase(struct timespec *wall, struct timespec *cpu)
+{
+    clock_gettime(CLOCK_MONOTONIC, wall);
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, cpu);
+}
+
+static double secondsBetween(const struct timespec *start, const struct timespec *end)
+{
+    return (end->tv_sec - start->tv_sec) + (end->tv_nsec - start->tv_nsec) / 1e9;
+}
+
+/**
+ * @brief Does the work of parser_main() one phase at a time and times every phase.
+ *
+ * The whole file is lexed before parsing starts, so that lexing and parsing
+ * are timed apart; the outputs are the same as those of parseFile().
+ *
+ * @param testfile Path to the input source code file to be parsed.
+ * @param outfile Path to the output file where the parse tree will be printed if the code is syntactically correct.
+ * @param logPath Path the parser trace is rendered to (see trace.h).
+ * @param tableFiles Also write the FIRST/FOLLOW and parse table files, as parser_main() does.
+ * @param times Receives the wall and CPU time of each phase, the source size and the token count.
+ * @return true if the code is syntactically correct, false too if the log could not be opened.
+ */
+bool timeParsePhases(char *testfile, char *outfile, const char *logPath, bool tableFiles, PhaseTimes *times)
+{
+    struct timespec wall[PHASE_COUNT + 1], cpu[PHASE_COUNT + 1];
+    if (parserTrace.events == NULL)
+        traceInit(&parserTrace);
+    traceReset(&parserTrace);
+    // A log that cannot be opened fails the file, but every phase is still timed
+    if (parserTrace.level != TRACE_OFF)
+        initLogFile(logPath);
+    bool logOpen = parserTrace.level == TRACE_OFF || logFile != NULL;
+
+    markPhase(&wall[PHASE_TABLE_FILES], &cpu[PHASE_TABLE_FILES]);
+    if (tableFiles)
+        printGrammarTables();
+
+    markPhase(&wall[PHASE_LEX], &cpu[PHASE_LEX]);
+    TokenStream *tokens = togettokens(testfile);
+
+    markPhase(&wall[PHASE_PARSE], &cpu[PHASE_PARSE]);
+    ParseTree *tree = createParseTree();
+    bool correct = parseTokenStream(tokens, tree);
+
+    // No spill stream here: the ring grows, so the log is rendered in its own phase
+    markPhase(&wall[PHASE_PARSE_LOG], &cpu[PHASE_PARSE_LOG]);
+    if (parserTrace.level != TRACE_OFF)
+    {
+        closeParseLog();
+        if (logOpen)
+            fprintf(messages(), "[INFO] Entire Parsing Process and Logic is printed successfully in %s ...\n", logPath);
     }
-    // Production 92: <definetypestmt> ===> TK_DEFINETYPE <A> TK_RUID TK_AS TK_RUID
+    else
+        fprintf(messages(), "[INFO] Parser tracing is off so %s is not written\n", logPath);
+
+    markPhase(&wall[PHASE_TREE], &cpu[PHASE_TREE]);
+    if (!logOpen)
+        fprintf(messages(), "[INFO] %s could not be opened so the parse tree is not printed\n\n", logPath);
+    else if (correct)
     {
-        int arr92[] = {108, 47, 109, 13, 48, 13, -1, -10, -10, -10};
-        Vector *v92 = array_to_vector(arr92, 10);
-        pushBackVector(gr, *v92);
-        // printVector(v92);
+        fprintf(messages(), "[INFO] Code is syntactically correct so parse tree is generated successfully in %s ...\n\n", outfile);
+        printParseTree(tree, outfile);
     }
-    // Production 93: <A> ===> TK_RECORD
+    else
+        fprintf(messages(), "[INFO] Code is syntactically incorrect so parse tree is constructed but printParseTree is not called\n\n");
+    markPhase(&wall[PHASE_COUNT], &cpu[PHASE_COUNT]);
+
+    for (int i = 0; i < PHASE_COUNT; i++)
     {
-        int arr93[] = {109, 15, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v93 = array_to_vector(arr93, 10);
-        pushBackVector(gr, *v93);
+        times->wall[i] = secondsBetween(&wall[i], &wall[i + 1]);
+        times->cpu[i] = secondsBetween(&cpu[i], &cpu[i + 1]);
     }
-    // Production 94: <A> ===> TK_UNION
+    times->tokens = tokens->size;
+    struct stat st;
+    times->bytes = stat(testfile, &st) == 0 ? (long)st.st_size : 0;
+    destroyParseTree(tree);
+    destroyTokenStream(tokens);
+    return correct && logOpen;
+}
+
+/**
+ * @brief Parses one source file into an AST and writes its parse log and AST.
+ *
+ * @param testfile Path to the input source code file to be parsed.
+ * @param outfile Path to the output file where the AST will be printed if the code is syntactically correct.
+ * @param logPath Path the parser trace is rendered to (see trace.h).
+ * @param streaming Pull tokens from the lexer during parsing instead of lexing the whole file first.
+ * @return true if the code is syntactically correct, false too if the log could not be opened.
+ */
+bool astFile(char *testfile, char *outfile, const char *logPath, bool streaming)
+{
+    if (parserTrace.events == NULL)
+        traceInit(&parserTrace);
+    traceReset(&parserTrace);
+    issyntaxcorrect = true;
+
+    if (!openParseLog(logPath))
+        return false;
+    Ast *ast = createAst();
+    buildAstFromSource(testfile, T, ast, streaming);
+    if (parserTrace.level != TRACE_OFF)
     {
-        int arr94[] = {109, 17, -1, -10, -10, -10, -10, -10, -10, -10};
-        Vector *v94 = array_to_vector(arr94, 10);
-        pushBackVector(gr, *v94);
+        closeParseLog();
+        fprintf(messages(), "[INFO] Entire Parsing Process and Logic is printed successfully in %s ...\n", logPath);
     }
-    // printVectorOfVector(gr);
-
-    grammar G = (grammar)malloc(sizeof(struct grammar));
-    G->Grammar = (VectorOfVector *)malloc(sizeof(VectorOfVector));
-    initVectorOfVector(G->Grammar);
-    // G->Grammar=gr;
-    for (int i = 0; i < GRAMMAR_SIZE; i++)
+    fprintf(messages(), "[INFO] AST has %u nodes in %zu bytes\n", ast->nodeCount, astBytes(ast));
+    if (issyntaxcorrect)
     {
-        Vector v;
-        initVector(&v);
-        for (int j = 0; j < 10; j++)
-        {
-            pushBack(&v, accessVectorOfVector(gr, i, j));
-
-        }
-
-        pushBackVector(G->Grammar, v);
+        printAst(ast, outfile);
+        fprintf(messages(), "[INFO] Code is syntactically correct so the AST is printed successfully in %s ...\n\n", outfile);
     }
+    else
+        fprintf(messages(), "[INFO] Code is syntactically incorrect so the AST is not printed\n\n");
+    destroyAst(ast);
+    return issyntaxcorrect;
+}
 
-    return G;
+/**
+ * @brief Sends the calling thread's parser diagnostics and progress messages to a stream.
+ *
+ * @param out The stream, or NULL for stdout.
+ */
+void setParserMessages(FILE *out)
+{
+    parserMessages = out;
 }
 
+/**
+ * @brief Frees the calling thread's parser trace buffer.
+ */
+void releaseParserTrace(void)
+{
+    traceFree(&parserTrace);
+}
 
 /**
  * @brief Main function for the parser module.
  *
- * This function initializes the necessary components for the parser, including
- * grammar, FIRST and FOLLOW sets, and the parse table. It then parses the input
+ * This function prints the FIRST and FOLLOW sets and the parse table, and then parses the input
  * source code and generates the parse tree if the code is syntactically correct.
  * The results are printed to various output files.
  *
  * @param testfile Path to the input source code file to be parsed.
  * @param outfile Path to the output file where the parse tree will be printed if the code is syntactically correct.
+ * @param streaming Pull tokens from the lexer during parsing instead of lexing the whole file first.
  */
-void parser_main(char *testfile,char* outfile)
+void parser_main(char *testfile,char* outfile,bool streaming)
 {
-    initTableLogFile();
-    initLogFile();
-     if (parser_called == 0)
-    {
-        printf("[INFO] Initializing grammar...\n");
-        G = initialize_grammar();
-        printf("[INFO] Computing FIRST and FOLLOW sets...\n");
-        F = ComputeFirstAndFollowSets(G);
-        printf("[INFO] First and Follow sets automated \n");
-         printf("[INFO] Initializing parse table...\n");
-        T = initialize_table(F);
-        createParseTable(F, T,G);
-        parser_called = 1;
-    }
-
-
-
-    print_first_set(F, G);
-    printf("[INFO] First Set has been printed successfully in first_out.txt ...\n");
-    print_follow_set(F, G);
-    printf("[INFO] Follow Set has been printed successfully in follow_out.txt ...\n");
-
-    printTable(T);
-    printf("[INFO] Parse table has been printed successfully in parse_table_ouput.txt ...\n");
-    char dummy[5] = "----\0";
-    TreeNode* root=parseInputSourceCode(testfile,T,G);
-    printf("[INFO] Entire Parsing Process and Logic is printed successfully in parser_output.txt ...\n");
-    if(issyntaxcorrect){ 
-         printf("[INFO] Code is syntactically correct so parse tree is generated successfully in %s ...\n\n",outfile);
-        printParseTree(root,outfile);}
-    else{
-        printf("[INFO] Code is syntactically incorrect so parse tree is constructed but printParseTree is not called\n\n");
-    }
-    freeSyntaxTree(root);
-    closeLogFile();
-    closeTableLogFile();
-    // printf("[] Testing complete!\n");
-}
\ No newline at end of file
+    printGrammarTables();
+    parseFile(testfile, outfile, "parser_output.txt", streaming);
+}
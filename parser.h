@@ -7,25 +7,49 @@
 #include "vectorofvector.h"
 #include "parserDef.h"
 
-#define GRAMMAR_SIZE 94      // Total number of productions
 #define MAX_PROD_LENGTH 11   // (For documentation only)
 
-// Function prototype for initializing the grammar.
-// This creates a VectorOfVector where each production is stored as a Vector.
-grammar initialize_grammar();
-void parser_main(char *testfile,char* outfile);
+// The grammar, FIRST/FOLLOW sets and parse table come from grammarDef.h,
+// generated from grammer.txt by tools/grammargen.
+void parser_main(char *testfile,char* outfile,bool streaming);
+void printGrammarTables(void);
+bool parseFile(char *testfile, char *outfile, const char *logPath, bool streaming);
+bool astFile(char *testfile, char *outfile, const char *logPath, bool streaming);
+void setParserMessages(FILE *out);
+void releaseParserTrace(void);
+
+// Phases timed by timeParsePhases(). The grammar, FIRST/FOLLOW sets and parse
+// table are built by tools/grammargen, so they take no time at run time.
+typedef enum
+{
+    PHASE_TABLE_FILES, // first_out.txt, follow_out.txt and parse_table_output.txt
+    PHASE_LEX,
+    PHASE_PARSE,
+    PHASE_PARSE_LOG,   // Rendering the parser trace to the parse log
+    PHASE_TREE,        // Printing the parse tree
+    PHASE_COUNT
+} ParsePhase;
+
+typedef struct
+{
+    double wall[PHASE_COUNT]; // Seconds, CLOCK_MONOTONIC
+    double cpu[PHASE_COUNT];  // Seconds, CPU time of the calling thread
+    long bytes;               // Size of the source
+    uint32_t tokens;          // Tokens lexed, comments and lexical errors included
+} PhaseTimes;
+
+bool timeParsePhases(char *testfile, char *outfile, const char *logPath, bool tableFiles, PhaseTimes *times);
 
 typedef struct TreeNode TreeNode;
+typedef struct ParseTree ParseTree;
 
-// Function to check whether the given term is already present in the set or not
-int checker(int *temp, int n);
+TreeNode* parseInputSourceCode(char *testcaseFile, parsetable T,grammar G, ParseTree *tree);
+TreeNode* parseInputSourceStream(char *testcaseFile, parsetable T, grammar G, ParseTree *tree, const char *outfile);
+void printParseTree(const ParseTree *tree, char *outfile);
+char *formatParseTree(const ParseTree *tree, size_t *length);
+bool parseTokenStream(const TokenStream *tokens, ParseTree *tree);
+bool reparseSubtree(ParseTree *tree, uint32_t node, const uint8_t *terminals, uint32_t first, uint32_t end, int follow);
 
-//Computes the FOLLOW set for a given non-terminal in a grammar.
-void FirstSet(int n, grammar gmr, int buffer[150], First_Follow FF);
-void FollowSet(int n, grammar gmr, int buffer[150], First_Follow FF, int check[111]);
-First_Follow ComputeFirstAndFollowSets(grammar G);
-
-void createParseTable(First_Follow F, parsetable T, grammar G);
-TreeNode* parseInputSourceCode(char *testcaseFile, parsetable T,grammar G);
-void printParseTree(TreeNode* root, char *outfile);
+typedef struct Ast Ast;
+void buildAstFromSource(char *testcaseFile, parsetable T, Ast *ast, bool streaming);
 #endif // PARSER_H
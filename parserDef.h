@@ -1,26 +1,42 @@
+#ifndef PARSERDEF_H
+#define PARSERDEF_H
 
 
-
+#include <stdint.h>
 #include "vectorofvector.h"
-struct First_Follow
+#include "lexer.h"
+
+#define PRODUCTION_WIDTH 10 // lhs, at most 8 rhs symbols, -1
+#define AST_RULE_WIDTH 12   // at most 8 rhs symbols and 3 semantic actions, -1
+
+// Semantic actions in astRules[] (grammarDef.h), run when the AST builder pops them
+#define AST_ACTION_BASE 256
+#define AST_NODE 0     // @Kind: a Kind node over every value the production pushed
+#define AST_OPTIONAL 1 // @Kind?: the same, but a single value is passed on as it is
+#define AST_FOLD 2     // @Kind^: "operand op operand ..." folded left into Kind nodes
+#define AST_ACTION(kind, mode) (AST_ACTION_BASE + (kind) * 4 + (mode))
+
+// Set of grammar symbols, bit i for symbol index i
+typedef struct
 {
-    VectorOfVector firstset;
-    VectorOfVector followset;
-};
+    uint64_t word[2];
+} SymbolSet;
 
-struct grammar
+static inline int symbolSetHas(const SymbolSet *s, int symbol)
 {
-    VectorOfVector *Grammar;
-};
+    return (s->word[symbol >> 6] >> (symbol & 63)) & 1;
+}
 
-struct pTable
+struct First_Follow
 {
-    VectorOfVector parser_Table;
+    const SymbolSet *firstset;  // indexed by grammar symbol
+    const SymbolSet *followset; // indexed by grammar symbol, non-terminals only
 };
 
-typedef struct pTable *parsetable;
-typedef struct grammar *grammar;
-typedef struct First_Follow *First_Follow;
+struct grammar
+{
+    const int (*rules)[PRODUCTION_WIDTH]; // production i: lhs, rhs..., -1
+};
 
 #define NONTERMINALS 53
 #define TERMINALS 56
@@ -29,118 +45,64 @@ typedef struct First_Follow *First_Follow;
 #define NONTERMINALS_START 57
 #define NONTERMINALS_END 110
 #define SYNCRO -2
-static char *grammarTerms[111] = {
-"$",                         // 0
-//terminals
-"TK_MAIN",                   // 1
-"TK_END",                    // 2
-"TK_FUNID",                  // 3
-"TK_SEM",                    // 4
-"TK_INPUT",                  // 5
-"TK_PARAMETER",              // 6
-"TK_LIST",                   // 7
-"TK_SQL",                    // 8
-"TK_SQR",                    // 9
-"TK_OUTPUT",                 // 10
-"TK_INT",                    // 11
-"TK_REAL",                   // 12
-"TK_RUID",                   // 13
-"TK_COMMA",                  // 14
-"TK_RECORD",                 // 15
-"TK_ENDRECORD",              // 16
-"TK_UNION",                  // 17
-"TK_ENDUNION",               // 18
-"TK_TYPE",                   // 19
-"TK_COLON",                  // 20
-"TK_FIELDID",                // 21
-"TK_GLOBAL",                 // 22
-"TK_ASSIGNOP",               // 23
-"TK_WHILE",                  // 24
-"TK_OP",                     // 25
-"TK_CL",                     // 26
-"TK_IF",                     // 27
-"TK_THEN",                   // 28
-"TK_ELSE",                   // 29
-"TK_ENDIF",                  // 30
-"TK_READ",                   // 31
-"TK_WRITE",                  // 32
-"TK_PLUS",                   // 33
-"TK_MINUS",                  // 34
-"TK_MUL",                    // 35
-"TK_DIV",                    // 36
-"TK_NOT",                    // 37
-"TK_AND",                    // 38
-"TK_OR",                     // 39
-"TK_LT",                     // 40
-"TK_LE",                     // 41
-"TK_EQ",                     // 42
-"TK_GT",                     // 43
-"TK_GE",                     // 44
-"TK_NE",                     // 45
-"TK_RETURN",                 // 46
-"TK_DEFINETYPE",             // 47
-"TK_AS",                     // 48
-"TK_DOT",                    // 49
-"TK_CALL",                   // 50
-"TK_WITH",                   // 51
-"TK_PARAMETERS",             // 52
-"TK_NUM",                    // 53
-"TK_RNUM",                   // 54
-"TK_ENDWHILE",               // 55
-"TK_ID",                     // 56
-// Non-Terminals
-"program",                   // 57
-"otherFunctions",            // 58
-"mainFunction",              // 59
-"function",                  // 60
-"input_par",                 // 61
-"output_par",                // 62
-"parameter_list",            // 63
-"dataType",                  // 64
-"primitiveDataType",         // 65
-"constructedDataType",       // 66
-"remaining_list",            // 67
-"stmts",                     // 68
-"typeDefinitions",           // 69
-"actualOrRedefined",         // 70
-"typeDefinition",            // 71
-"fieldDefinitions",          // 72
-"fieldDefinition",           // 73
-"fieldType",                 // 74
-"moreFields",                // 75
-"declarations",              // 76
-"declaration",               // 77
-"global_or_not",             // 78
-"otherStmts",                // 79
-"stmt",                      // 80
-"assignmentStmt",            // 81
-"SingleOrRecId",             // 82
-"option_single_constructed", // 83
-"oneExpansion",              // 84
-"moreExpansions",            // 85
-"funCallStmt",               // 86
-"outputParameters",          // 87
-"inputParameters",           // 88
-"iterativeStmt",             // 89
-"conditionalStmt",           // 90
-"elsePart",                  // 91
-"ioStmt",                    // 92
-"arithmeticExpression",      // 93
-"expPrime",                  // 94
-"term",                      // 95
-"termPrime",                 // 96
-"factor",                    // 97
-"lowPrecedenceOp",           // 98
-"highPrecedenceOp",          // 99
-"booleanExpression",         // 100
-"var",                       // 101
-"logicalOp",                 // 102
-"relationalOp",              // 103
-"returnStmt",                // 104
-"optionalReturn",            // 105
-"idList",                    // 106
-"more_ids",                  // 107
-"definetypestmt",            // 108
-"A",                         // 109
-"eps"                        // 110 terminal
-};
\ No newline at end of file
+
+// Dense LL(1) table: production index, -1 (error) or SYNCRO, about 6 KB
+struct pTable
+{
+    int16_t table[NONTERMINALS][TERMINALS + 1];
+};
+
+// The tables are generated at build time (grammarDef.h) and never modified
+typedef const struct pTable *parsetable;
+typedef const struct grammar *grammar;
+typedef const struct First_Follow *First_Follow;
+
+// Unchecked lookup for the parse loop. Every entry is a production index, -1 or
+// SYNCRO by construction: tools/grammargen derives the table from grammer.txt
+// (reporting LL(1) conflicts as warnings), and nothing checks it at run time.
+static inline int parseTableEntry(parsetable T, int nonTerminal, int terminal)
+{
+    return T->table[nonTerminal - NONTERMINALS_START][terminal];
+}
+// Grammar symbol indices: SYM_<token> for terminals, SYM_<name> for non-terminals
+#define TERMINAL_ID(name, index) SYM_##name = index,
+#define NONTERMINAL_ID(name) SYM_##name,
+enum GrammarSymbol
+{
+    SYM_DOLLAR = 0,
+    TERMINAL_SYMBOLS(TERMINAL_ID)
+    SYM_NONTERMINALS_BEFORE = NONTERMINALS_START - 1,
+    NONTERMINAL_SYMBOLS(NONTERMINAL_ID)
+    SYM_EPS
+};
+#undef TERMINAL_ID
+#undef NONTERMINAL_ID
+
+#define TERMINAL_NAME(name, index) [index] = #name,
+#define NONTERMINAL_NAME(name) #name,
+static char *grammarTerms[TERMS_SIZE] = {
+    [SYM_DOLLAR] = "$",
+    TERMINAL_SYMBOLS(TERMINAL_NAME)
+    [NONTERMINALS_START] = NONTERMINAL_SYMBOLS(NONTERMINAL_NAME)
+    [SYM_EPS] = "eps"
+};
+#undef TERMINAL_NAME
+#undef NONTERMINAL_NAME
+
+// TokenType -> grammar terminal index; -1 for tokens the grammar never sees
+#define TERMINAL_OF(name, index) index,
+#define NOT_TERMINAL(name) -1,
+static const signed char tokenTerminal[TK_ERR + 1] = {
+    TERMINAL_SYMBOLS(TERMINAL_OF)
+    LEXER_ONLY_SYMBOLS(NOT_TERMINAL)
+    -1
+};
+#undef TERMINAL_OF
+#undef NOT_TERMINAL
+
+_Static_assert(SYM_EPS == EPSILON && SYM_EPS + 1 == TERMS_SIZE, "symbols.h does not match the grammar size");
+#define COUNT_TERMINAL(name, index) +1
+_Static_assert(TERMINALS == 0 TERMINAL_SYMBOLS(COUNT_TERMINAL), "symbols.h does not match the terminal count");
+#undef COUNT_TERMINAL
+
+#endif // PARSERDEF_H
@@ -0,0 +1,421 @@
+/**
+ * @file server.c
+ * @brief Compile server answering lex and parse requests on a Unix domain socket.
+ *
+ * The grammar and parse table are static data (grammarDef.h), so a server
+ * pays for nothing but the lexing and parsing of each request. Worker threads
+ * take turns accepting connections and serve one connection at a time. Each
+ * keeps its lexeme pool from one request to the next, so identifiers a build
+ * keeps sending are interned once. Sources, diagnostics and trees never touch
+ * the file system.
+ *
+ * A request may carry at most SERVER_MAX_SOURCE bytes of source (8 MB unless
+ * the environment variable says otherwise). The source buffer grows as its
+ * bytes arrive, so a client cannot make the server allocate a length it
+ * never sends.
+ */
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "server.h"
+#include "lexer.h"
+#include "parser.h"
+#include "tree.h"
+
+#define SERVER_BACKLOG 64              ///< Connections the listening socket queues before accept()
+#define SERVER_MAX_SOURCE (8ul << 20)  ///< Largest source one request may carry, unless SERVER_MAX_SOURCE is set
+#define SERVER_READ_CHUNK (1ul << 16)  ///< First size of a connection's source buffer
+#define SERVER_POOL_LIMIT (1u << 20)   ///< Lexemes a worker's pool may hold before it starts a new one
+
+typedef enum
+{
+    REQUEST_LEX,
+    REQUEST_TOKENS,
+    REQUEST_PARSE,
+    REQUEST_TREE,
+    REQUEST_PING,
+    REQUEST_SHUTDOWN
+} RequestKind;
+
+static const char *requestNames[] = {"lex", "tokens", "parse", "tree", "ping", "shutdown"};
+
+/* State shared by the workers; stopping and the counters are guarded by lock */
+typedef struct
+{
+    int listenFd;
+    bool stopping;
+    unsigned long requests;
+    unsigned long connections;
+    unsigned long maxSource;  // Largest source one request may carry
+    pthread_mutex_t lock;
+} Server;
+
+/**
+ * @brief Serves lex and parse requests on a Unix domain socket until a shutdown request.
+ *
+ * A stale socket left at the path by a server that did not shut down is
+ * replaced; any other file there is left alone and the server does not start.
+ *
+ * @param socketPath Path of the socket; it is removed when the server stops.
+ * @param workers Number of connections served at a time.
+ * @return int EXIT_SUCCESS after a shutdown request, EXIT_FAILURE if the socket could not be opened.
+ */
+int runServer(const char *socketPath, int workers);
+
+/**
+ * @brief Creates, binds and listens on the server socket.
+ *
+ * @param path Path of the socket.
+ * @return int The listening socket, -1 on error (reported on stderr).
+ */
+static int openServerSocket(const char *path)
+{
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr.sun_path))
+    {
+        fprintf(stderr, "Socket path %s is longer than %zu characters\n", path, sizeof(addr.sun_path) - 1);
+        return -1;
+    }
+    strcpy(addr.sun_path, path);
+
+    // A socket left behind by a server that was killed; nothing listens on it
+    struct stat st;
+    if (stat(path, &st) == 0 && S_ISSOCK(st.st_mode))
+    {
+        int probe = socket(AF_UNIX, SOCK_STREAM, 0);
+        bool live = probe >= 0 && connect(probe, (struct sockaddr *)&addr, sizeof(addr)) == 0;
+        if (probe >= 0)
+            close(probe);
+        if (live)
+        {
+            fprintf(stderr, "A server is already listening on %s\n", path);
+            return -1;
+        }
+        unlink(path);
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+    {
+        perror("socket");
+        return -1;
+    }
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(fd, SERVER_BACKLOG) != 0)
+    {
+        perror(path);
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Sends every byte of the buffers, resuming after short writes; false if the client went away
+static bool sendBuffers(int fd, struct iovec *iov, int count)
+{
+    while (count > 0)
+    {
+        struct msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = iov;
+        msg.msg_iovlen = (size_t)count;
+        ssize_t n = sendmsg(fd, &msg, MSG_NOSIGNAL);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        while (count > 0 && (size_t)n >= iov->iov_len)
+        {
+            n -= (ssize_t)iov->iov_len;
+            iov++;
+            count--;
+        }
+        if (count > 0)
+        {
+            iov->iov_base = (char *)iov->iov_base + n;
+            iov->iov_len -= (size_t)n;
+        }
+    }
+    return true;
+}
+
+static bool sendResponse(int fd, const char *status, const char *diagnostics, size_t diagnosticsLength, const char *output, size_t outputLength)
+{
+    char header[64];
+    int headerLength = snprintf(header, sizeof(header), "%s %zu %zu\n", status, diagnosticsLength, outputLength);
+    struct iovec iov[3] = {
+        {header, (size_t)headerLength},
+        {(void *)diagnostics, diagnosticsLength},
+        {(void *)output, outputLength},
+    };
+    return sendBuffers(fd, iov, 3);
+}
+
+/**
+ * @brief Lexes, and for parse requests parses, one source.
+ *
+ * @param kind The request.
+ * @param source The source.
+ * @param length Length of the source.
+ * @param diagnostics Receives the lexical and syntax errors.
+ * @param output Receives the token listing or the parse tree, if the request asks for one.
+ * @return bool true if the source has no errors.
+ */
+static bool runRequest(RequestKind kind, const char *source, size_t length, FILE *diagnostics, FILE *output)
+{
+    TokenStream *S = tokenizeText(source, length);
+    bool correct = true;
+    Token t;
+    if (kind == REQUEST_LEX || kind == REQUEST_TOKENS)
+    {
+        for (uint32_t i = 0; i < S->size; i++)
+        {
+            tokenAt(S, i, &t);
+            if (t.cat != NORMAL)
+            {
+                printToken(&t, diagnostics);
+                correct = false;
+            }
+            if (kind == REQUEST_TOKENS)
+                printToken(&t, output);
+        }
+        destroyTokenStream(S);
+        return correct;
+    }
+
+    // The parser reports lexical errors as it skips them but does not count them
+    for (uint32_t i = 0; i < S->size && correct; i++)
+        correct = S->cat[i] == NORMAL;
+    setParserMessages(diagnostics);
+    ParseTree *tree = createParseTree();
+    bool syntaxCorrect = parseTokenStream(S, tree);
+    setParserMessages(NULL);
+    if (kind == REQUEST_TREE && syntaxCorrect)
+    {
+        size_t treeLength;
+        char *text = formatParseTree(tree, &treeLength);
+        fwrite(text, 1, treeLength, output);
+        free(text);
+    }
+    destroyParseTree(tree);
+    destroyTokenStream(S);
+    return correct && syntaxCorrect;
+}
+
+/**
+ * @brief Reads the source of a request, growing the buffer as the bytes arrive.
+ *
+ * @param in The connection.
+ * @param source The connection's source buffer, reallocated as needed.
+ * @param sourceSize Size of *source.
+ * @param length Bytes the request says follow.
+ * @return int 1 once length bytes are read, 0 if the client closed early, -1 if the buffer could not grow.
+ */
+static int readSource(FILE *in, char **source, size_t *sourceSize, unsigned long length)
+{
+    unsigned long have = 0;
+    while (have < length)
+    {
+        if (have == *sourceSize)
+        {
+            size_t size = *sourceSize ? *sourceSize * 2 : SERVER_READ_CHUNK;
+            if (size > length)
+                size = length;
+            char *grown = (char *)realloc(*source, size);
+            if (!grown)
+                return -1;
+            *source = grown;
+            *sourceSize = size;
+        }
+        size_t want = (*sourceSize < length ? *sourceSize : length) - have;
+        size_t got = fread(*source + have, 1, want, in);
+        if (got == 0)
+            return 0;
+        have += got;
+    }
+    return 1;
+}
+
+/**
+ * @brief Reads and answers requests on a connection until the client closes it.
+ *
+ * @param srv The server.
+ * @param fd The connection; it is closed on return.
+ */
+static void serveConnection(Server *srv, int fd)
+{
+    FILE *in = fdopen(fd, "r");
+    if (!in)
+    {
+        close(fd);
+        return;
+    }
+    char *line = NULL, *source = NULL;
+    size_t lineSize = 0, sourceSize = 0;
+    ssize_t read;
+    while ((read = getline(&line, &lineSize, in)) > 0)
+    {
+        char command[16];
+        unsigned long length = 0;
+        int fields = sscanf(line, "%15s %lu", command, &length);
+        int kind = -1;
+        for (int i = 0; fields >= 1 && i <= REQUEST_SHUTDOWN; i++)
+        {
+            if (strcmp(command, requestNames[i]) == 0)
+                kind = i;
+        }
+        bool sized = kind >= 0 && kind < REQUEST_PING;
+        if (kind < 0 || (sized && fields != 2))
+        {
+            const char *error = "Expected lex, tokens, parse or tree <length>, ping or shutdown\n";
+            sendResponse(fd, "bad", error, strlen(error), NULL, 0);
+            break;
+        }
+        if (sized && length > srv->maxSource)
+        {
+            const char *error = "Source is larger than the server accepts\n";
+            sendResponse(fd, "bad", error, strlen(error), NULL, 0);
+            break;
+        }
+
+        pthread_mutex_lock(&srv->lock);
+        srv->requests++;
+        if (kind == REQUEST_SHUTDOWN)
+            srv->stopping = true;
+        pthread_mutex_unlock(&srv->lock);
+        if (kind == REQUEST_SHUTDOWN)
+        {
+            // Wakes every worker blocked in accept()
+            shutdown(srv->listenFd, SHUT_RDWR);
+            sendResponse(fd, "ok", NULL, 0, NULL, 0);
+            break;
+        }
+        if (kind == REQUEST_PING)
+        {
+            if (!sendResponse(fd, "ok", NULL, 0, NULL, 0))
+                break;
+            continue;
+        }
+
+        int got = readSource(in, &source, &sourceSize, length);
+        if (got == 0)
+            break;
+
+        // Running out of memory fails the request, not the server
+        char *diagnostics = NULL, *output = NULL;
+        size_t diagnosticsLength = 0, outputLength = 0;
+        FILE *diag = got > 0 ? open_memstream(&diagnostics, &diagnosticsLength) : NULL;
+        FILE *out = diag ? open_memstream(&output, &outputLength) : NULL;
+        if (!out)
+        {
+            if (diag)
+                fclose(diag);
+            free(diagnostics);
+            const char *error = "Server is out of memory\n";
+            sendResponse(fd, "bad", error, strlen(error), NULL, 0);
+            break;
+        }
+        bool correct = runRequest((RequestKind)kind, source, length, diag, out);
+        fclose(diag);
+        fclose(out);
+        bool sent = sendResponse(fd, correct ? "ok" : "errors", diagnostics, diagnosticsLength, output, outputLength);
+        free(diagnostics);
+        free(output);
+
+        // Lexemes of past requests are kept for the next ones, up to a point
+        if (lexemePool()->count > SERVER_POOL_LIMIT)
+            releaseLexemePool();
+        if (!sent)
+            break;
+    }
+    free(line);
+    free(source);
+    fclose(in);
+}
+
+/**
+ * @brief Worker thread: accepts connections and serves them until the server stops.
+ */
+static void *serverWorker(void *arg)
+{
+    Server *srv = (Server *)arg;
+    while (1)
+    {
+        int fd = accept(srv->listenFd, NULL, NULL);
+        pthread_mutex_lock(&srv->lock);
+        bool stopping = srv->stopping;
+        if (fd >= 0)
+            srv->connections++;
+        pthread_mutex_unlock(&srv->lock);
+        if (stopping)
+        {
+            if (fd >= 0)
+                close(fd);
+            break;
+        }
+        if (fd < 0)
+        {
+            if (errno == EINTR || errno == ECONNABORTED)
+                continue;
+            perror("accept");
+            break;
+        }
+        serveConnection(srv, fd);
+    }
+
+    releaseParserTrace();
+    releaseLexemePool();
+    return NULL;
+}
+
+int runServer(const char *socketPath, int workers)
+{
+    Server srv = {0};
+    srv.listenFd = openServerSocket(socketPath);
+    if (srv.listenFd < 0)
+        return EXIT_FAILURE;
+    if (workers < 1)
+        workers = 1;
+    srv.maxSource = SERVER_MAX_SOURCE;
+    const char *maxSource = getenv("SERVER_MAX_SOURCE");
+    if (maxSource && strtoul(maxSource, NULL, 10) > 0)
+        srv.maxSource = strtoul(maxSource, NULL, 10);
+    pthread_mutex_init(&srv.lock, NULL);
+
+    printf("[INFO] Serving lex and parse requests on %s with %d worker%s\n", socketPath, workers, workers == 1 ? "" : "s");
+    fflush(stdout);
+    pthread_t *threads = (pthread_t *)malloc(workers * sizeof(pthread_t));
+    if (!threads)
+    {
+        fprintf(stderr, "Memory allocation failed in runServer\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < workers; i++)
+    {
+        if (pthread_create(&threads[i], NULL, serverWorker, &srv) != 0)
+        {
+            fprintf(stderr, "Could not start server worker %d\n", i);
+            exit(EXIT_FAILURE);
+        }
+    }
+    for (int i = 0; i < workers; i++)
+        pthread_join(threads[i], NULL);
+    free(threads);
+
+    close(srv.listenFd);
+    unlink(socketPath);
+    pthread_mutex_destroy(&srv.lock);
+    printf("[INFO] Served %lu requests on %lu connections\n", srv.requests, srv.connections);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,28 @@
+#ifndef COMPILER_SERVER_H
+#define COMPILER_SERVER_H
+
+/*
+ * Compile server: lexes and parses sources sent over a Unix domain socket,
+ * so that a build can check many small files without starting a process for
+ * each one. A connection carries any number of requests, one after the other.
+ *
+ * Request:  <command> <length>\n followed by <length> bytes of source
+ *   lex     lexical errors only
+ *   tokens  lexical errors, and the token listing as output
+ *   parse   lexical and syntax errors
+ *   tree    lexical and syntax errors, and the parse tree as output when the
+ *           source is syntactically correct
+ *   ping and shutdown take no length; shutdown stops the server once the
+ *   connections being served are closed.
+ *
+ * Response: <status> <diagnostics length> <output length>\n followed by the
+ * diagnostics and then the output, in the formats of stage1exe's own files.
+ *   ok      no errors
+ *   errors  the source has lexical or syntax errors
+ *   bad     the request could not be read, its source is larger than the
+ *           server accepts (SERVER_MAX_SOURCE bytes, 8 MB by default) or the
+ *           server ran out of memory; the connection is closed after it
+ */
+int runServer(const char *socketPath, int workers);
+
+#endif /* COMPILER_SERVER_H */
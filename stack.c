@@ -2,7 +2,7 @@
 
 /**
  * @file stack.c
- * @brief Implementation of a dynamic stack for TreeNode pointers.
+ * @brief Implementation of a dynamic stack of parse-tree node indices.
  */
 
 #include <stdlib.h>
@@ -57,13 +57,13 @@ int isStackEmpty(const Stack *stack);
 void resizeStack(Stack *stack);
 
 /**
- * @brief Pushes a TreeNode pointer onto the stack.
+ * @brief Pushes a tree node onto the stack.
  * 
  * @param stack Pointer to the stack.
- * @param node Pointer to the TreeNode to be pushed.
+ * @param node Index of the node in its ParseTree.
  * @return int 1 on success, 0 on failure.
  */
-int pushStack(Stack *stack, TreeNode *node);
+int pushStack(Stack *stack, uint32_t node);
 
 /**
  * @brief Pops the top element from the stack.
@@ -77,10 +77,10 @@ int popStack(Stack *stack);
  * @brief Retrieves the top element of the stack without removing it.
  * 
  * @param stack Pointer to the stack.
- * @param node Pointer to the TreeNode pointer where the top element will be stored.
+ * @param node Where the index of the top node will be stored.
  * @return int 1 on success, 0 if the stack is empty.
  */
-int topStack(Stack *stack, TreeNode **node);
+int topStack(Stack *stack, uint32_t *node);
 
 Token* createDummyToken(const char* lexeme) {
     Token* token = malloc(sizeof(Token));
@@ -89,8 +89,8 @@ Token* createDummyToken(const char* lexeme) {
         exit(EXIT_FAILURE);
     }
   
-    strncpy(token->lexeme, lexeme, BUFFER_SIZE);
-    token->lexeme[BUFFER_SIZE - 1] = '\0'; 
+    token->lexeme = internString(lexemePool(), lexeme, (int)strlen(lexeme));
+    token->length = (int)strlen(lexeme);
     
     token->type = 0;    
     token->cat = 0;     
@@ -98,7 +98,7 @@ Token* createDummyToken(const char* lexeme) {
     return token;
 }
 void createStack(Stack *stack, int capacity) {
-    stack->array = (TreeNode **)malloc(capacity * sizeof(TreeNode *));
+    stack->array = (uint32_t *)malloc(capacity * sizeof(uint32_t));
     if (stack->array == NULL) {
         fprintf(stderr, "Memory allocation failed in createStack\n");
         exit(EXIT_FAILURE);
@@ -125,7 +125,7 @@ int isStackEmpty(const Stack *stack) {
 void resizeStack(Stack *stack) {
     int oldCapacity = stack->capacity;
     int newCapacity = oldCapacity * 2;
-    TreeNode **newArray = (TreeNode **)realloc(stack->array, newCapacity * sizeof(TreeNode *));
+    uint32_t *newArray = (uint32_t *)realloc(stack->array, newCapacity * sizeof(uint32_t));
     if (newArray == NULL) {
         fprintf(stderr, "Memory allocation failed in resizeStack\n");
         exit(EXIT_FAILURE);
@@ -135,7 +135,7 @@ void resizeStack(Stack *stack) {
     // printf("Stack resized from %d to %d elements\n", oldCapacity, newCapacity);
 }
 
-int pushStack(Stack *stack, TreeNode *node) {
+int pushStack(Stack *stack, uint32_t node) {
     if (isStackFull(stack)) {
         resizeStack(stack);
     }
@@ -149,7 +149,7 @@ int popStack(Stack *stack) {
     stack->top--;
     return 1;  // Success
 }
-int topStack(Stack *stack, TreeNode **node) {
+int topStack(Stack *stack, uint32_t *node) {
     if (isStackEmpty(stack)) {
         return 0;  // Failure, stack is empty
     }
@@ -8,7 +8,7 @@
 #include "tree.h"
 
 typedef struct {
-    TreeNode **array;    
+    uint32_t *array;     // Indices of nodes in the parse tree
     int capacity;        
     int top;            
 } Stack;
@@ -18,9 +18,9 @@ void deleteStack(Stack *stack);
 int isStackFull(const Stack *stack);
 int isStackEmpty(const Stack *stack);
 void resizeStack(Stack *stack);
-int pushStack(Stack *stack, TreeNode *node);
+int pushStack(Stack *stack, uint32_t node);
 int popStack(Stack *stack);
-int topStack(Stack *stack, TreeNode **node);
+int topStack(Stack *stack, uint32_t *node);
 void printStack(const Stack *stack);
 
 
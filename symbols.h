@@ -0,0 +1,133 @@
+#ifndef SYMBOLS_H
+#define SYMBOLS_H
+
+/*
+ * Single table of the language's symbols. lexer.h expands it into the
+ * TokenType enum and getTokenStr(); parserDef.h expands it into the grammar
+ * symbol indices, grammarTerms[] and the TokenType -> terminal map, so the
+ * lexer and the parser can no longer disagree on a name or an index.
+ */
+
+/* Tokens that are grammar terminals: X(token, grammar index). The order
+   here is the TokenType order. */
+#define TERMINAL_SYMBOLS(X) \
+    X(TK_MINUS,       34) \
+    X(TK_IF,          27) \
+    X(TK_DIV,         36) \
+    X(TK_CALL,        50) \
+    X(TK_WITH,        51) \
+    X(TK_MAIN,         1) \
+    X(TK_ENDWHILE,    55) \
+    X(TK_TYPE,        19) \
+    X(TK_ELSE,        29) \
+    X(TK_INT,         11) \
+    X(TK_NOT,         37) \
+    X(TK_GT,          43) \
+    X(TK_PARAMETERS,  52) \
+    X(TK_THEN,        28) \
+    X(TK_SEM,          4) \
+    X(TK_RETURN,      46) \
+    X(TK_ID,          56) \
+    X(TK_DEFINETYPE,  47) \
+    X(TK_OP,          25) \
+    X(TK_WHILE,       24) \
+    X(TK_OR,          39) \
+    X(TK_FUNID,        3) \
+    X(TK_COMMA,       14) \
+    X(TK_INPUT,        5) \
+    X(TK_UNION,       17) \
+    X(TK_RECORD,      15) \
+    X(TK_DOT,         49) \
+    X(TK_RUID,        13) \
+    X(TK_WRITE,       32) \
+    X(TK_ENDUNION,    18) \
+    X(TK_FIELDID,     21) \
+    X(TK_LIST,         7) \
+    X(TK_AND,         38) \
+    X(TK_CL,          26) \
+    X(TK_ASSIGNOP,    23) \
+    X(TK_OUTPUT,      10) \
+    X(TK_EQ,          42) \
+    X(TK_ENDIF,       30) \
+    X(TK_GLOBAL,      22) \
+    X(TK_AS,          48) \
+    X(TK_COLON,       20) \
+    X(TK_NE,          45) \
+    X(TK_GE,          44) \
+    X(TK_LE,          41) \
+    X(TK_SQR,          9) \
+    X(TK_END,          2) \
+    X(TK_PLUS,        33) \
+    X(TK_ENDRECORD,   16) \
+    X(TK_READ,        31) \
+    X(TK_LT,          40) \
+    X(TK_SQL,          8) \
+    X(TK_NUM,         53) \
+    X(TK_RNUM,        54) \
+    X(TK_PARAMETER,    6) \
+    X(TK_MUL,         35) \
+    X(TK_REAL,        12)
+
+/* Tokens the lexer produces or reserves but the grammar never sees */
+#define LEXER_ONLY_SYMBOLS(X) \
+    X(TK_EPS)                 \
+    X(TK_EOF)                 \
+    X(TK_COMMENT)
+
+/* Non-terminals in grammar index order, starting at NONTERMINALS_START */
+#define NONTERMINAL_SYMBOLS(X) \
+    X(program) \
+    X(otherFunctions) \
+    X(mainFunction) \
+    X(function) \
+    X(input_par) \
+    X(output_par) \
+    X(parameter_list) \
+    X(dataType) \
+    X(primitiveDataType) \
+    X(constructedDataType) \
+    X(remaining_list) \
+    X(stmts) \
+    X(typeDefinitions) \
+    X(actualOrRedefined) \
+    X(typeDefinition) \
+    X(fieldDefinitions) \
+    X(fieldDefinition) \
+    X(fieldType) \
+    X(moreFields) \
+    X(declarations) \
+    X(declaration) \
+    X(global_or_not) \
+    X(otherStmts) \
+    X(stmt) \
+    X(assignmentStmt) \
+    X(SingleOrRecId) \
+    X(option_single_constructed) \
+    X(oneExpansion) \
+    X(moreExpansions) \
+    X(funCallStmt) \
+    X(outputParameters) \
+    X(inputParameters) \
+    X(iterativeStmt) \
+    X(conditionalStmt) \
+    X(elsePart) \
+    X(ioStmt) \
+    X(arithmeticExpression) \
+    X(expPrime) \
+    X(term) \
+    X(termPrime) \
+    X(factor) \
+    X(lowPrecedenceOp) \
+    X(highPrecedenceOp) \
+    X(booleanExpression) \
+    X(var) \
+    X(logicalOp) \
+    X(relationalOp) \
+    X(returnStmt) \
+    X(optionalReturn) \
+    X(idList) \
+    X(more_ids) \
+    X(definetypestmt) \
+    X(A)
+
+#endif /* SYMBOLS_H */
@@ -0,0 +1,249 @@
+/**
+ * @file compileclient.c
+ * @brief Sends source files to a compile server (stage1exe --serve) over one connection.
+ *
+ *   ./stage1exe --serve /tmp/stage1.sock --jobs 4 &
+ *   ./tools/compileclient /tmp/stage1.sock parse testcase*.txt
+ *
+ * Diagnostics are printed per file; with --out-dir the token listings or
+ * parse trees are written to DIR/<name>.tokens.txt or DIR/<name>.tree.txt.
+ * --repeat N sends every file N times and only reports the request latencies
+ * of the repeats; ping and shutdown take no files.
+ *
+ * Usage: compileclient <socket> <lex|tokens|parse|tree|ping|shutdown> [--repeat N] [--out-dir DIR] [files...]
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#define CLIENT_PATH_MAX 4096
+
+static int connectServer(const char *path)
+{
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", path);
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0)
+    {
+        perror(path);
+        exit(EXIT_FAILURE);
+    }
+    return fd;
+}
+
+static char *readFile(const char *path, size_t *length)
+{
+    FILE *fp = fopen(path, "rb");
+    if (!fp)
+    {
+        perror(path);
+        return NULL;
+    }
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    char *text = (char *)malloc(size > 0 ? (size_t)size : 1);
+    if (!text)
+    {
+        fprintf(stderr, "Memory allocation failed in readFile\n");
+        exit(EXIT_FAILURE);
+    }
+    *length = fread(text, 1, size > 0 ? (size_t)size : 0, fp);
+    fclose(fp);
+    return text;
+}
+
+// A server that refuses a request answers "bad" and closes without reading the rest; its answer is still read
+static void sendAll(int fd, const char *data, size_t length)
+{
+    while (length > 0)
+    {
+        ssize_t n = send(fd, data, length, MSG_NOSIGNAL);
+        if (n < 0 && (errno == EPIPE || errno == ECONNRESET))
+            return;
+        if (n <= 0)
+        {
+            perror("Sending to the server");
+            exit(EXIT_FAILURE);
+        }
+        data += n;
+        length -= (size_t)n;
+    }
+}
+
+/* One response: status line, then diagnostics and output */
+typedef struct
+{
+    char status[16];
+    char *diagnostics;
+    size_t diagnosticsLength;
+    char *output;
+    size_t outputLength;
+} Response;
+
+static char *readBlock(FILE *in, size_t length)
+{
+    char *data = (char *)malloc(length + 1);
+    if (!data || fread(data, 1, length, in) != length)
+    {
+        fprintf(stderr, "The server closed the connection\n");
+        exit(EXIT_FAILURE);
+    }
+    data[length] = '\0';
+    return data;
+}
+
+static void request(int fd, FILE *in, const char *command, const char *source, size_t length, Response *r)
+{
+    char header[64];
+    int n = source ? snprintf(header, sizeof(header), "%s %zu\n", command, length) : snprintf(header, sizeof(header), "%s\n", command);
+    sendAll(fd, header, (size_t)n);
+    if (source)
+        sendAll(fd, source, length);
+
+    char line[128];
+    if (!fgets(line, sizeof(line), in) || sscanf(line, "%15s %zu %zu", r->status, &r->diagnosticsLength, &r->outputLength) != 3)
+    {
+        fprintf(stderr, "The server closed the connection\n");
+        exit(EXIT_FAILURE);
+    }
+    r->diagnostics = readBlock(in, r->diagnosticsLength);
+    r->output = readBlock(in, r->outputLength);
+}
+
+static int compareDoubles(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "Usage: %s <socket> <lex|tokens|parse|tree|ping|shutdown> [--repeat N] [--out-dir DIR] [files...]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    const char *command = argv[2];
+    int repeat = 1, first = argc;
+    const char *outDir = NULL;
+    for (int i = 3; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--repeat") == 0 && i + 1 < argc)
+            repeat = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--out-dir") == 0 && i + 1 < argc)
+            outDir = argv[++i];
+        else
+        {
+            first = i;
+            break;
+        }
+    }
+    if (repeat < 1)
+        repeat = 1;
+
+    int fd = connectServer(argv[1]);
+    FILE *in = fdopen(dup(fd), "r");
+    Response r;
+    if (strcmp(command, "ping") == 0 || strcmp(command, "shutdown") == 0)
+    {
+        request(fd, in, command, NULL, 0, &r);
+        printf("%s\n", r.status);
+        int ok = strcmp(r.status, "ok") == 0;
+        free(r.diagnostics);
+        free(r.output);
+        fclose(in);
+        close(fd);
+        return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    int files = argc - first, failed = 0, timed = 0;
+    double *latency = (double *)malloc((size_t)(files > 0 ? files : 1) * repeat * sizeof(double));
+    if (!latency)
+    {
+        fprintf(stderr, "Memory allocation failed in main\n");
+        return EXIT_FAILURE;
+    }
+    size_t bytes = 0;
+    for (int f = first; f < argc; f++)
+    {
+        size_t length;
+        char *source = readFile(argv[f], &length);
+        if (!source)
+        {
+            failed++;
+            continue;
+        }
+        for (int k = 0; k < repeat; k++)
+        {
+            struct timespec t0, t1;
+            clock_gettime(CLOCK_MONOTONIC, &t0);
+            request(fd, in, command, source, length, &r);
+            clock_gettime(CLOCK_MONOTONIC, &t1);
+            if (repeat == 1 || k > 0)
+            {
+                latency[timed++] = (t1.tv_sec - t0.tv_sec) * 1e6 + (t1.tv_nsec - t0.tv_nsec) / 1e3;
+                bytes += length;
+            }
+            if (k == 0)
+            {
+                if (strcmp(r.status, "bad") == 0)
+                {
+                    fprintf(stderr, "%s: %s", argv[f], r.diagnostics);
+                    free(r.diagnostics);
+                    free(r.output);
+                    free(source);
+                    free(latency);
+                    fclose(in);
+                    close(fd);
+                    return EXIT_FAILURE;
+                }
+                failed += strcmp(r.status, "ok") != 0;
+                if (r.diagnosticsLength > 0)
+                    printf("==> %s <==\n%s", argv[f], r.diagnostics);
+                if (outDir && r.outputLength > 0)
+                {
+                    char path[CLIENT_PATH_MAX];
+                    const char *name = strrchr(argv[f], '/');
+                    name = name ? name + 1 : argv[f];
+                    const char *dot = strrchr(name, '.');
+                    int len = dot && dot != name ? (int)(dot - name) : (int)strlen(name);
+                    snprintf(path, sizeof(path), "%s/%.*s%s", outDir, len, name, strcmp(command, "tokens") == 0 ? ".tokens.txt" : ".tree.txt");
+                    FILE *out = fopen(path, "w");
+                    if (!out)
+                        perror(path);
+                    else
+                    {
+                        fwrite(r.output, 1, r.outputLength, out);
+                        fclose(out);
+                    }
+                }
+            }
+            free(r.diagnostics);
+            free(r.output);
+        }
+        free(source);
+    }
+
+    if (timed > 0)
+    {
+        double total = 0;
+        for (int i = 0; i < timed; i++)
+            total += latency[i];
+        qsort(latency, (size_t)timed, sizeof(double), compareDoubles);
+        printf("[INFO] %s: %d files, %d with errors; %d timed requests, latency min %.1f us, median %.1f us, max %.1f us, %.1f MB/s\n",
+               command, files, failed, timed, latency[0], latency[timed / 2], latency[timed - 1], bytes / total);
+    }
+    free(latency);
+    fclose(in);
+    close(fd);
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
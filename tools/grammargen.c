@@ -0,0 +1,572 @@
+/**
+ * @file grammargen.c
+ * @brief Generates the parser's grammar tables (grammarDef.h) from grammer.txt.
+ *
+ * The generator reads the productions in grammer.txt, numbers them in file
+ * order, computes the FIRST and FOLLOW sets and fills the LL(1) parse table,
+ * including the SYNCRO entries used for error recovery. Everything is written
+ * out as static const data, so the parser does no grammar work at start-up
+ * and editing the grammar needs no hand renumbering.
+ *
+ * Symbol names and indices come from symbols.h, the table the lexer and the
+ * parser are built from.
+ *
+ * A production may carry semantic actions for the AST builder: "@Kind" builds
+ * a Kind node over the values the production pushed so far, "@Kind?" does the
+ * same unless there is a single value, and "@Kind^" folds "operand op operand
+ * ..." left-associatively into Kind nodes. Actions can sit anywhere on the
+ * right-hand side; they are left out of grammarRules and the FIRST/FOLLOW
+ * computation and only appear in astRules.
+ *
+ * Usage: grammargen <grammar file> <output header>
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "../symbols.h"
+
+#define MAX_LINE 1024
+#define MAX_RULES 512
+#define RULE_WIDTH 10      ///< lhs, up to 8 rhs symbols, -1; must match PRODUCTION_WIDTH
+#define AST_RULE_WIDTH 12  ///< up to 8 rhs symbols and 3 actions, -1; must match parserDef.h
+#define MAX_AST_KINDS 64
+#define ACTION_BASE 1000   ///< astRules entries >= this are actions: ACTION_BASE + kind * 4 + mode
+
+/* Terminals are numbered 1..TERMINAL_COUNT, so a new one moves the non-terminals up */
+#define COUNT_TERMINAL(name, index) +1
+#define TERMINAL_IN_RANGE(name, index) \
+    _Static_assert((index) >= 1 && (index) <= TERMINAL_COUNT, #name " is numbered past the terminals in symbols.h");
+enum
+{
+    TERMINAL_COUNT = 0 TERMINAL_SYMBOLS(COUNT_TERMINAL)
+};
+TERMINAL_SYMBOLS(TERMINAL_IN_RANGE)
+#undef COUNT_TERMINAL
+#undef TERMINAL_IN_RANGE
+
+/* Symbol indices, as in parserDef.h */
+#define TERMINAL_INDEX(name, index) SYM_##name = index,
+#define NONTERMINAL_INDEX(name) SYM_##name,
+enum
+{
+    SYM_DOLLAR = 0,
+    TERMINAL_SYMBOLS(TERMINAL_INDEX)
+    SYM_NONTERMINALS_BEFORE = TERMINAL_COUNT,
+    NONTERMINAL_SYMBOLS(NONTERMINAL_INDEX)
+    SYM_EPS,
+    SYMBOL_COUNT
+};
+#undef TERMINAL_INDEX
+#undef NONTERMINAL_INDEX
+
+#define NONTERMINALS_START (SYM_NONTERMINALS_BEFORE + 1)
+#define TERMINALS SYM_NONTERMINALS_BEFORE
+
+#define TERMINAL_NAME(name, index) [index] = #name,
+#define NONTERMINAL_NAME(name) #name,
+static const char *symbolName[SYMBOL_COUNT] = {
+    [SYM_DOLLAR] = "$",
+    TERMINAL_SYMBOLS(TERMINAL_NAME)
+    [NONTERMINALS_START] = NONTERMINAL_SYMBOLS(NONTERMINAL_NAME)
+    [SYM_EPS] = "eps"
+};
+#undef TERMINAL_NAME
+#undef NONTERMINAL_NAME
+
+_Static_assert(SYMBOL_COUNT <= 128, "grammar symbols no longer fit a 128-bit SymbolSet");
+
+/**
+ * Set of grammar symbols, bit i for symbol i; same layout as SymbolSet in
+ * parserDef.h. SYM_DOLLAR marks end of input in FOLLOW, SYM_EPS nullable in FIRST.
+ */
+typedef struct
+{
+    uint64_t word[2];
+} SymbolSet;
+
+/**
+ * Tokens the parser resynchronises on in every row: the starts of functions,
+ * type definitions, declarations and statements.
+ */
+static const int syncTokens[] = {
+    SYM_TK_FUNID, SYM_TK_MAIN, SYM_TK_RECORD, SYM_TK_UNION, SYM_TK_DEFINETYPE,
+    SYM_TK_TYPE, SYM_TK_ID, SYM_TK_WHILE, SYM_TK_IF, SYM_TK_READ,
+    SYM_TK_WRITE, SYM_TK_CALL, SYM_TK_SQL,
+};
+
+static int rules[MAX_RULES][RULE_WIDTH];
+static int astRules[MAX_RULES][AST_RULE_WIDTH];
+static char ruleText[MAX_RULES][MAX_LINE];
+static int nRules = 0;
+
+static const char *actionModeName[] = {"AST_NODE", "AST_OPTIONAL", "AST_FOLD"};
+static char astKindName[MAX_AST_KINDS][64] = {"Leaf"}; ///< Kind 0 is a token leaf
+static int nAstKinds = 1;
+
+static SymbolSet first[SYMBOL_COUNT];
+static SymbolSet follow[SYMBOL_COUNT];
+static int table[SYMBOL_COUNT - NONTERMINALS_START][TERMINALS + 1];
+
+static const char *grammarName; ///< For error messages
+
+/**
+ * @brief Maps a symbol as written in the grammar file to its index.
+ *
+ * @param word "<name>" for a non-terminal, "<eps>" or a TK_* terminal.
+ * @param line Line number for the error message.
+ * @return int The symbol index.
+ */
+static int lookupSymbol(const char *word, int line)
+{
+    char name[MAX_LINE];
+    size_t len = strlen(word);
+    if (len > 2 && word[0] == '<' && word[len - 1] == '>')
+    {
+        memcpy(name, word + 1, len - 2);
+        name[len - 2] = '\0';
+        if (strcmp(name, "eps") == 0)
+            return SYM_EPS;
+        for (int s = NONTERMINALS_START; s < SYM_EPS; s++)
+        {
+            if (strcmp(symbolName[s], name) == 0)
+                return s;
+        }
+    }
+    else
+    {
+        for (int s = 1; s <= TERMINALS; s++)
+        {
+            if (strcmp(symbolName[s], word) == 0)
+                return s;
+        }
+    }
+    fprintf(stderr, "%s:%d: error: unknown symbol %s\n", grammarName, line, word);
+    exit(EXIT_FAILURE);
+}
+
+/**
+ * @brief Maps a semantic action as written in the grammar file to its astRules entry.
+ *
+ * @param word "@Kind", "@Kind?" or "@Kind^"; kinds are numbered in order of first use.
+ * @param line Line number for the error message.
+ * @return int ACTION_BASE + kind * 4 + mode.
+ */
+static int lookupAction(const char *word, int line)
+{
+    char name[64];
+    size_t len = strlen(word + 1);
+    int mode = 0;
+    if (len > 0 && word[len] == '?')
+        mode = 1, len--;
+    else if (len > 0 && word[len] == '^')
+        mode = 2, len--;
+    if (len == 0 || len >= sizeof(name))
+    {
+        fprintf(stderr, "%s:%d: error: bad action %s\n", grammarName, line, word);
+        exit(EXIT_FAILURE);
+    }
+    memcpy(name, word + 1, len);
+    name[len] = '\0';
+
+    int kind = 0;
+    while (kind < nAstKinds && strcmp(astKindName[kind], name) != 0)
+        kind++;
+    if (kind == 0 || kind == nAstKinds)
+    {
+        if (kind == 0 || nAstKinds == MAX_AST_KINDS)
+        {
+            fprintf(stderr, "%s:%d: error: action %s is reserved or one kind too many\n", grammarName, line, word);
+            exit(EXIT_FAILURE);
+        }
+        kind = nAstKinds++;
+        strcpy(astKindName[kind], name);
+    }
+    return ACTION_BASE + kind * 4 + mode;
+}
+
+/**
+ * @brief Reads the productions, one "<lhs> ===> rhs..." per line.
+ *
+ * @param path The grammar file.
+ */
+static void readGrammar(const char *path)
+{
+    FILE *fp = fopen(path, "r");
+    if (!fp)
+    {
+        perror(path);
+        exit(EXIT_FAILURE);
+    }
+
+    char line[MAX_LINE];
+    int lineNo = 0;
+    while (fgets(line, sizeof(line), fp))
+    {
+        lineNo++;
+        line[strcspn(line, "\r\n")] = '\0';
+        if (strspn(line, " \t") == strlen(line))
+            continue;
+        if (nRules == MAX_RULES)
+        {
+            fprintf(stderr, "%s:%d: error: more than %d productions\n", path, lineNo, MAX_RULES);
+            exit(EXIT_FAILURE);
+        }
+        snprintf(ruleText[nRules], MAX_LINE, "%s", line);
+
+        int *rule = rules[nRules];
+        int *astRule = astRules[nRules];
+        int n = 0, nAst = 0;
+        int arrow = 0;
+        for (char *word = strtok(line, " \t"); word; word = strtok(NULL, " \t"))
+        {
+            if (strcmp(word, "===>") == 0)
+            {
+                if (n != 1 || arrow)
+                    break;
+                arrow = 1;
+                continue;
+            }
+            if (nAst == AST_RULE_WIDTH - 1)
+            {
+                fprintf(stderr, "%s:%d: error: more than %d symbols and actions on the right-hand side\n", path,
+                        lineNo, AST_RULE_WIDTH - 1);
+                exit(EXIT_FAILURE);
+            }
+            if (word[0] == '@')
+            {
+                if (!arrow)
+                    break;
+                astRule[nAst++] = lookupAction(word, lineNo);
+                continue;
+            }
+            if (n == RULE_WIDTH - 1)
+            {
+                fprintf(stderr, "%s:%d: error: more than %d symbols on the right-hand side\n", path, lineNo,
+                        RULE_WIDTH - 2);
+                exit(EXIT_FAILURE);
+            }
+            rule[n] = lookupSymbol(word, lineNo);
+            if (arrow && rule[n] != SYM_EPS)
+                astRule[nAst++] = rule[n];
+            n++;
+        }
+        if (!arrow || n < 2 || rule[0] < NONTERMINALS_START || rule[0] == SYM_EPS)
+        {
+            fprintf(stderr, "%s:%d: error: expected <non-terminal> ===> symbols\n", path, lineNo);
+            exit(EXIT_FAILURE);
+        }
+        rule[n] = -1;
+        astRule[nAst] = -1;
+        nRules++;
+    }
+    fclose(fp);
+}
+
+static int setHas(const SymbolSet *s, int symbol)
+{
+    return (s->word[symbol >> 6] >> (symbol & 63)) & 1;
+}
+
+static void setAdd(SymbolSet *s, int symbol)
+{
+    s->word[symbol >> 6] |= (uint64_t)1 << (symbol & 63);
+}
+
+/**
+ * @brief dst |= src, leaving out one symbol (-1 for none).
+ *
+ * @return int 1 if dst gained a symbol.
+ */
+static int setUnion(SymbolSet *dst, const SymbolSet *src, int except)
+{
+    int changed = 0;
+    for (int w = 0; w < 2; w++)
+    {
+        uint64_t add = src->word[w];
+        if (except >= 0 && except >> 6 == w)
+            add &= ~((uint64_t)1 << (except & 63));
+        changed |= (add & ~dst->word[w]) != 0;
+        dst->word[w] |= add;
+    }
+    return changed;
+}
+
+/**
+ * @brief FIRST of the right-hand side of a production from position k on.
+ *
+ * @return SymbolSet Contains SYM_EPS if every symbol from k on is nullable.
+ */
+static SymbolSet firstOfSuffix(int rule, int k)
+{
+    SymbolSet s = {{0, 0}};
+    for (; rules[rule][k] != -1; k++)
+    {
+        setUnion(&s, &first[rules[rule][k]], SYM_EPS);
+        if (!setHas(&first[rules[rule][k]], SYM_EPS))
+            return s;
+    }
+    setAdd(&s, SYM_EPS);
+    return s;
+}
+
+/**
+ * @brief Computes every FIRST set with a worklist of productions.
+ *
+ * A production is re-evaluated only when the FIRST set of a symbol on its
+ * right-hand side grew, and the loop ends when no set changes, so the
+ * result does not depend on production order or a fixed number of sweeps.
+ */
+static void computeFirstSets(void)
+{
+    static int users[SYMBOL_COUNT][MAX_RULES]; // symbol -> productions using it on the right
+    static int nUsers[SYMBOL_COUNT];
+    static int queue[MAX_RULES];
+    static int queued[MAX_RULES];
+
+    for (int s = 0; s < NONTERMINALS_START; s++)
+        setAdd(&first[s], s);
+    setAdd(&first[SYM_EPS], SYM_EPS);
+
+    for (int i = 0; i < nRules; i++)
+    {
+        for (int k = 1; rules[i][k] != -1; k++)
+        {
+            int s = rules[i][k];
+            if (nUsers[s] == 0 || users[s][nUsers[s] - 1] != i)
+                users[s][nUsers[s]++] = i;
+        }
+    }
+
+    // Circular queue; each production is in it at most once
+    int head = 0, count = 0;
+    for (int i = 0; i < nRules; i++)
+    {
+        queue[count++] = i;
+        queued[i] = 1;
+    }
+    while (count > 0)
+    {
+        int i = queue[head];
+        head = (head + 1) % MAX_RULES;
+        count--;
+        queued[i] = 0;
+
+        int lhs = rules[i][0];
+        SymbolSet rhs = firstOfSuffix(i, 1);
+        if (!setUnion(&first[lhs], &rhs, -1))
+            continue;
+        for (int u = 0; u < nUsers[lhs]; u++)
+        {
+            int j = users[lhs][u];
+            if (!queued[j])
+            {
+                queue[(head + count++) % MAX_RULES] = j;
+                queued[j] = 1;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Computes every FOLLOW set with a worklist of non-terminals.
+ *
+ * The FIRST part of each FOLLOW set is fixed once FIRST is known and is
+ * added up front. What remains are the edges A -> B for productions
+ * A ===> ... B beta with beta nullable; FOLLOW(A) is pushed along them until
+ * no set grows.
+ */
+static void computeFollowSets(void)
+{
+    static int edges[SYMBOL_COUNT][MAX_RULES * RULE_WIDTH];
+    static int nEdges[SYMBOL_COUNT];
+    int queue[SYMBOL_COUNT];
+    int queued[SYMBOL_COUNT] = {0};
+
+    setAdd(&follow[NONTERMINALS_START], SYM_DOLLAR);
+    for (int i = 0; i < nRules; i++)
+    {
+        int lhs = rules[i][0];
+        for (int k = 1; rules[i][k] != -1; k++)
+        {
+            int b = rules[i][k];
+            if (b < NONTERMINALS_START || b == SYM_EPS)
+                continue;
+            SymbolSet rest = firstOfSuffix(i, k + 1);
+            setUnion(&follow[b], &rest, SYM_EPS);
+            if (setHas(&rest, SYM_EPS) && b != lhs)
+                edges[lhs][nEdges[lhs]++] = b;
+        }
+    }
+
+    int head = 0, count = 0;
+    for (int s = NONTERMINALS_START; s < SYM_EPS; s++)
+    {
+        queue[count++] = s;
+        queued[s] = 1;
+    }
+    while (count > 0)
+    {
+        int a = queue[head];
+        head = (head + 1) % SYMBOL_COUNT;
+        count--;
+        queued[a] = 0;
+
+        for (int e = 0; e < nEdges[a]; e++)
+        {
+            int b = edges[a][e];
+            if (setUnion(&follow[b], &follow[a], -1) && !queued[b])
+            {
+                queue[(head + count++) % SYMBOL_COUNT] = b;
+                queued[b] = 1;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Stores a production in the parse table, reporting LL(1) conflicts.
+ */
+static void setEntry(int lhs, int terminal, int rule)
+{
+    int *cell = &table[lhs - NONTERMINALS_START][terminal];
+    if (*cell >= 0 && *cell != rule)
+        fprintf(stderr, "%s: warning: conflict for %s on %s: productions %d and %d\n", grammarName,
+                symbolName[lhs], symbolName[terminal], *cell + 1, rule + 1);
+    *cell = rule;
+}
+
+/**
+ * @brief Fills the parse table from the FIRST and FOLLOW sets.
+ *
+ * Cells start as -1 (error). FOLLOW of the row and the sync tokens become
+ * SYNCRO (-2), and are then overwritten by any production that applies.
+ */
+static void buildTable(void)
+{
+    for (int r = 0; r < SYM_EPS - NONTERMINALS_START; r++)
+    {
+        for (int t = 0; t <= TERMINALS; t++)
+            table[r][t] = -1;
+        for (int t = 0; t <= TERMINALS; t++)
+        {
+            if (setHas(&follow[r + NONTERMINALS_START], t))
+                table[r][t] = -2;
+        }
+        for (size_t k = 0; k < sizeof(syncTokens) / sizeof(syncTokens[0]); k++)
+            table[r][syncTokens[k]] = -2;
+    }
+
+    for (int i = 0; i < nRules; i++)
+    {
+        int lhs = rules[i][0];
+        SymbolSet predict = firstOfSuffix(i, 1);
+        if (setHas(&predict, SYM_EPS))
+            setUnion(&predict, &follow[lhs], -1);
+        for (int t = 0; t <= TERMINALS; t++)
+        {
+            if (setHas(&predict, t))
+                setEntry(lhs, t, i);
+        }
+    }
+}
+
+/**
+ * @brief Writes a set as a SymbolSet initializer.
+ */
+static void writeSet(FILE *out, const SymbolSet *set, int symbol)
+{
+    fprintf(out, "    {{0x%016llxULL, 0x%016llxULL}}, /* %s */\n", (unsigned long long)set->word[0],
+            (unsigned long long)set->word[1], symbolName[symbol]);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 3)
+    {
+        fprintf(stderr, "Usage: %s <grammer.txt> <grammarDef.h>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    grammarName = argv[1];
+    readGrammar(argv[1]);
+
+    computeFirstSets();
+    computeFollowSets();
+    buildTable();
+
+    FILE *out = fopen(argv[2], "w");
+    if (!out)
+    {
+        perror(argv[2]);
+        return EXIT_FAILURE;
+    }
+    fprintf(out, "/* Generated by tools/grammargen from %s -- do not edit by hand. */\n\n", argv[1]);
+    fprintf(out, "#ifndef GRAMMARDEF_H\n#define GRAMMARDEF_H\n\n#include \"parserDef.h\"\n\n");
+    fprintf(out, "#define GRAMMAR_SIZE %d\n\n", nRules);
+
+    fprintf(out, "/* Productions: lhs, rhs symbols, -1 */\n");
+    fprintf(out, "static const int grammarRules[GRAMMAR_SIZE][PRODUCTION_WIDTH] = {\n");
+    for (int i = 0; i < nRules; i++)
+    {
+        fprintf(out, "    {");
+        for (int k = 0; k == 0 || rules[i][k - 1] != -1; k++)
+            fprintf(out, "%s%d", k ? ", " : "", rules[i][k]);
+        fprintf(out, "}, /* %d: %s */\n", i + 1, ruleText[i]);
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "/* AST node kinds, named by the @actions in %s; AST_Leaf is an input token */\n", argv[1]);
+    fprintf(out, "enum AstKind\n{\n");
+    for (int k = 0; k < nAstKinds; k++)
+        fprintf(out, "    AST_%s,\n", astKindName[k]);
+    fprintf(out, "    AST_KIND_COUNT\n};\n\n");
+    fprintf(out, "static const char *const astKindNames[AST_KIND_COUNT] = {\n");
+    for (int k = 0; k < nAstKinds; k++)
+        fprintf(out, "    \"%s\",\n", astKindName[k]);
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "/* Productions as the AST builder expands them: rhs symbols and actions, -1 */\n");
+    fprintf(out, "static const int astRules[GRAMMAR_SIZE][AST_RULE_WIDTH] = {\n");
+    for (int i = 0; i < nRules; i++)
+    {
+        fprintf(out, "    {");
+        for (int k = 0; k == 0 || astRules[i][k - 1] != -1; k++)
+        {
+            int e = astRules[i][k];
+            if (e >= ACTION_BASE)
+                fprintf(out, "%sAST_ACTION(AST_%s, %s)", k ? ", " : "", astKindName[(e - ACTION_BASE) / 4],
+                        actionModeName[(e - ACTION_BASE) % 4]);
+            else
+                fprintf(out, "%s%d", k ? ", " : "", e);
+        }
+        fprintf(out, "}, /* %d */\n", i + 1);
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "/* FIRST set of every symbol */\nstatic const SymbolSet grammarFirst[TERMS_SIZE] = {\n");
+    for (int s = 0; s < SYMBOL_COUNT; s++)
+        writeSet(out, &first[s], s);
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "/* FOLLOW set of every non-terminal, $ is bit 0 */\nstatic const SymbolSet grammarFollow[TERMS_SIZE] = {\n");
+    for (int s = 0; s < SYMBOL_COUNT; s++)
+        writeSet(out, &follow[s], s);
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "/* [non-terminal][terminal] -> production, -1 (error) or SYNCRO */\n");
+    fprintf(out, "static const struct pTable grammarTable = {{\n");
+    for (int r = 0; r < SYM_EPS - NONTERMINALS_START; r++)
+    {
+        fprintf(out, "    {");
+        for (int t = 0; t <= TERMINALS; t++)
+            fprintf(out, "%s%d", t ? "," : "", table[r][t]);
+        fprintf(out, "}, /* %s */\n", symbolName[r + NONTERMINALS_START]);
+    }
+    fprintf(out, "}};\n\n#endif /* GRAMMARDEF_H */\n");
+    fclose(out);
+
+    fprintf(stderr, "grammargen: %d productions, %d terminals, %d non-terminals, %d AST kinds\n", nRules, TERMINALS,
+            SYM_EPS - NONTERMINALS_START, nAstKinds);
+    return EXIT_SUCCESS;
+}
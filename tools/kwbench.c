@@ -0,0 +1,108 @@
+/**
+ * @file kwbench.c
+ * @brief Microbenchmark for keyword recognition.
+ *
+ * Lexes a source file, keeps every identifier-shaped lexeme (field ids,
+ * function ids and keywords) and classifies them repeatedly with
+ *  - the former linear strcmp scan over the keyword list, and
+ *  - lookupKeyword(), the generated perfect hash.
+ * Both must agree on every lexeme; the time per lookup of each is reported.
+ *
+ * Usage: kwbench [source file] [rounds]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../lexer.h"
+#include "../lexerDef.h"
+
+static const char *linearText[LEX_KEYWORD_COUNT + 1];
+static TokenType linearType[LEX_KEYWORD_COUNT + 1];
+
+/**
+ * @brief The lookup lexer.c used before the perfect hash: strcmp every keyword.
+ */
+static TokenType linearLookup(const char *lex)
+{
+    for (int i = 0; linearText[i] != NULL; i++)
+    {
+        if (strcmp(lex, linearText[i]) == 0)
+            return linearType[i];
+    }
+    return TK_ID;
+}
+
+static double elapsedNs(struct timespec a, struct timespec b)
+{
+    return (b.tv_sec - a.tv_sec) * 1e9 + (b.tv_nsec - a.tv_nsec);
+}
+
+int main(int argc, char **argv)
+{
+    char *fn = argc > 1 ? argv[1] : "longtestcase.txt";
+    int rounds = argc > 2 ? atoi(argv[2]) : 2000;
+
+    int k = 0;
+    for (int h = 0; h < LEX_KEYWORD_HASH_SIZE; h++)
+    {
+        if (lexKeywordText[h] != NULL)
+        {
+            linearText[k] = lexKeywordText[h];
+            linearType[k] = (TokenType)lexKeywordType[h];
+            k++;
+        }
+    }
+    linearText[k] = NULL;
+
+    TokenStream *S = tokenizeFile(fn);
+    const char **words = (const char **)malloc(S->size * sizeof(char *));
+    int nWords = 0;
+    for (uint32_t i = 0; i < S->size; i++)
+    {
+        const char *lex = lexemeText(S->lexeme[i]);
+        if (S->cat[i] == NORMAL && ((lex[0] >= 'a' && lex[0] <= 'z') || lex[0] == '_'))
+            words[nWords++] = lex;
+    }
+    if (nWords == 0)
+    {
+        fprintf(stderr, "kwbench: no identifiers in %s\n", fn);
+        return EXIT_FAILURE;
+    }
+
+    for (int i = 0; i < nWords; i++)
+    {
+        if (linearLookup(words[i]) != lookupKeyword(words[i]))
+        {
+            fprintf(stderr, "kwbench: lookups disagree on \"%s\"\n", words[i]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    struct timespec a, b;
+    volatile unsigned sink = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &a);
+    for (int r = 0; r < rounds; r++)
+        for (int i = 0; i < nWords; i++)
+            sink += linearLookup(words[i]);
+    clock_gettime(CLOCK_MONOTONIC, &b);
+    double linearNs = elapsedNs(a, b) / ((double)rounds * nWords);
+
+    clock_gettime(CLOCK_MONOTONIC, &a);
+    for (int r = 0; r < rounds; r++)
+        for (int i = 0; i < nWords; i++)
+            sink += lookupKeyword(words[i]);
+    clock_gettime(CLOCK_MONOTONIC, &b);
+    double hashNs = elapsedNs(a, b) / ((double)rounds * nWords);
+
+    printf("%d identifier-shaped lexemes from %s, %d rounds\n", nWords, fn, rounds);
+    printf("linear strcmp scan : %8.2f ns/lookup\n", linearNs);
+    printf("perfect hash       : %8.2f ns/lookup\n", hashNs);
+    printf("speedup            : %8.2fx\n", linearNs / hashNs);
+
+    free(words);
+    destroyTokenStream(S);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,769 @@
+/**
+ * @file lexgen.c
+ * @brief Generates the table-driven lexer DFA (lexerDef.h) from lexer.spec.
+ *
+ * The generator reads the declarative state/edge description in lexer.spec,
+ * drops unreachable states, minimizes the automaton with Moore's partition
+ * refinement, groups input bytes into equivalence classes (bytes whose
+ * transition column is identical in every state) and finally writes a compact
+ * transition table plus per-state accept/retract/token metadata. It also
+ * searches for a perfect hash over the keyword list so the lexer can classify
+ * an identifier with one probe and one compare.
+ *
+ * Usage: lexgen <spec file> <output header>
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#define MAX_SPEC_STATES 256 ///< Largest state number accepted in the spec
+#define MAX_LINE 1024
+#define MAX_NAME 32
+#define NO_EDGE -1          ///< Trap transition
+#define EOF_BYTE 0xFF       ///< (char)EOF as seen by getState()
+#define MAX_KEYWORDS 128
+#define MAX_KEYWORD_LEN 32
+#define HASH_SEED 2023u     ///< Fixed so regenerating gives the same tables
+
+/**
+ * @brief Everything the spec says about one state.
+ */
+typedef struct
+{
+    int used;              ///< State is mentioned anywhere in the spec
+    int next[256];         ///< Explicit transition per byte, or NO_EDGE
+    int other;             ///< Target of the "other" edge, or NO_EDGE
+    int accepting;         ///< 1 if this is a final state
+    int retract;           ///< Characters to push back on accept
+    char action[MAX_NAME]; ///< TK_* token or @funid/@fieldid/@skip/@exit
+    int newline;           ///< Increments the line counter on accept
+    int noappend;          ///< Characters read out of this state are not kept
+} SpecState;
+
+static SpecState spec[MAX_SPEC_STATES];
+
+/**
+ * @brief A reserved word and the token it maps to.
+ */
+typedef struct
+{
+    char lexeme[MAX_KEYWORD_LEN];
+    char type[MAX_NAME];
+} SpecKeyword;
+
+static SpecKeyword keywords[MAX_KEYWORDS];
+static int nKeywords = 0;
+static int lineNo = 0;
+static const char *specName = NULL;
+
+/**
+ * @brief Reports a spec error with its line number and exits.
+ *
+ * @param msg The message to print.
+ * @param arg Optional argument printed after the message (may be NULL).
+ */
+static void specError(const char *msg, const char *arg)
+{
+    fprintf(stderr, "%s:%d: error: %s%s%s\n", specName, lineNo, msg, arg ? " " : "", arg ? arg : "");
+    exit(EXIT_FAILURE);
+}
+
+/**
+ * @brief Splits a spec line into whitespace separated words.
+ *
+ * Quoted characters such as ' ' are kept together as one word and a '#'
+ * outside quotes starts a comment.
+ *
+ * @param line The line to split (modified in place).
+ * @param words Output array of word pointers.
+ * @param maxWords Capacity of words.
+ * @return int The number of words found.
+ */
+static int splitWords(char *line, char **words, int maxWords)
+{
+    int n = 0;
+    char *p = line;
+    while (*p)
+    {
+        while (*p && isspace((unsigned char)*p))
+            p++;
+        if (!*p || *p == '#')
+            break;
+        if (n == maxWords)
+            specError("too many words on line", NULL);
+        words[n++] = p;
+        if (*p == '\'')
+        {
+            /* 'x' or '\x', optionally followed by -'y' */
+            p++;
+            if (*p == '\\')
+                p++;
+            if (*p)
+                p++;
+            if (*p == '\'')
+                p++;
+            if (*p == '-' && p[1] == '\'')
+            {
+                p += 2;
+                if (*p == '\\')
+                    p++;
+                if (*p)
+                    p++;
+                if (*p == '\'')
+                    p++;
+            }
+        }
+        else
+        {
+            while (*p && !isspace((unsigned char)*p))
+                p++;
+        }
+        if (*p)
+            *p++ = '\0';
+    }
+    return n;
+}
+
+/**
+ * @brief Parses a state number and marks the state as used.
+ *
+ * @param word The word holding the number.
+ * @return int The state number.
+ */
+static int parseState(const char *word)
+{
+    char *end;
+    long s = strtol(word, &end, 10);
+    if (*word == '\0' || *end != '\0' || s < 0 || s >= MAX_SPEC_STATES)
+        specError("bad state number", word);
+    spec[s].used = 1;
+    return (int)s;
+}
+
+/**
+ * @brief Decodes one quoted character starting at p.
+ *
+ * @param p Pointer to the opening quote; advanced past the closing quote.
+ * @return int The byte value.
+ */
+static int parseQuotedChar(const char **p)
+{
+    const char *q = *p;
+    int c;
+    if (*q != '\'')
+        specError("expected quoted character near", *p);
+    q++;
+    if (*q == '\\')
+    {
+        q++;
+        switch (*q)
+        {
+        case 'n':
+            c = '\n';
+            break;
+        case 't':
+            c = '\t';
+            break;
+        case 'r':
+            c = '\r';
+            break;
+        case '0':
+            c = '\0';
+            break;
+        case '\\':
+        case '\'':
+            c = *q;
+            break;
+        default:
+            specError("unknown escape in", *p);
+            return 0;
+        }
+    }
+    else
+    {
+        c = (unsigned char)*q;
+    }
+    q++;
+    if (*q != '\'')
+        specError("unterminated character in", *p);
+    *p = q + 1;
+    return c;
+}
+
+/**
+ * @brief Adds the edges of one charset word to a state.
+ *
+ * @param from Source state.
+ * @param to Target state.
+ * @param word The charset ('x', 'a'-'z', EOF or other).
+ */
+static void addEdges(int from, int to, const char *word)
+{
+    int lo, hi;
+    if (strcmp(word, "other") == 0)
+    {
+        if (spec[from].other != NO_EDGE)
+            specError("duplicate \"other\" edge", NULL);
+        spec[from].other = to;
+        return;
+    }
+    if (strcmp(word, "EOF") == 0)
+    {
+        lo = hi = EOF_BYTE;
+    }
+    else
+    {
+        const char *p = word;
+        lo = hi = parseQuotedChar(&p);
+        if (*p == '-')
+        {
+            p++;
+            hi = parseQuotedChar(&p);
+        }
+        if (*p != '\0' || hi < lo)
+            specError("bad character set", word);
+    }
+    for (int c = lo; c <= hi; c++)
+    {
+        if (spec[from].next[c] != NO_EDGE && spec[from].next[c] != to)
+            specError("nondeterministic edge for character set", word);
+        spec[from].next[c] = to;
+    }
+}
+
+/**
+ * @brief Reads the whole spec file into the spec[] array.
+ *
+ * @param fn The spec filename.
+ */
+static void readSpec(const char *fn)
+{
+    FILE *fp = fopen(fn, "r");
+    if (!fp)
+    {
+        perror(fn);
+        exit(EXIT_FAILURE);
+    }
+    specName = fn;
+    for (int s = 0; s < MAX_SPEC_STATES; s++)
+    {
+        for (int c = 0; c < 256; c++)
+            spec[s].next[c] = NO_EDGE;
+        spec[s].other = NO_EDGE;
+    }
+
+    char line[MAX_LINE];
+    char *w[64];
+    while (fgets(line, sizeof(line), fp))
+    {
+        lineNo++;
+        int n = splitWords(line, w, 64);
+        if (n == 0)
+            continue;
+        if (strcmp(w[0], "accept") == 0)
+        {
+            if (n < 4 || n > 5)
+                specError("usage: accept <state> <retract> <action> [newline]", NULL);
+            int s = parseState(w[1]);
+            if (spec[s].accepting)
+                specError("state accepted twice:", w[1]);
+            spec[s].accepting = 1;
+            spec[s].retract = atoi(w[2]);
+            if (spec[s].retract < 0 || spec[s].retract > 2)
+                specError("retract must be 0, 1 or 2:", w[2]);
+            if (strlen(w[3]) >= MAX_NAME)
+                specError("action name too long:", w[3]);
+            if (strncmp(w[3], "TK_", 3) != 0 && strcmp(w[3], "@funid") != 0 && strcmp(w[3], "@fieldid") != 0 &&
+                strcmp(w[3], "@skip") != 0 && strcmp(w[3], "@exit") != 0)
+                specError("unknown action", w[3]);
+            strcpy(spec[s].action, w[3]);
+            if (n == 5)
+            {
+                if (strcmp(w[4], "newline") != 0)
+                    specError("unknown accept flag", w[4]);
+                spec[s].newline = 1;
+            }
+        }
+        else if (strcmp(w[0], "keyword") == 0)
+        {
+            if (n != 3 || strncmp(w[2], "TK_", 3) != 0)
+                specError("usage: keyword <lexeme> <TK_*>", NULL);
+            if (nKeywords == MAX_KEYWORDS)
+                specError("too many keywords", NULL);
+            if (strlen(w[1]) >= MAX_KEYWORD_LEN || strlen(w[2]) >= MAX_NAME)
+                specError("keyword too long:", w[1]);
+            for (int k = 0; k < nKeywords; k++)
+            {
+                if (strcmp(keywords[k].lexeme, w[1]) == 0)
+                    specError("duplicate keyword", w[1]);
+            }
+            strcpy(keywords[nKeywords].lexeme, w[1]);
+            strcpy(keywords[nKeywords].type, w[2]);
+            nKeywords++;
+        }
+        else if (strcmp(w[0], "noappend") == 0)
+        {
+            if (n != 2)
+                specError("usage: noappend <state>", NULL);
+            spec[parseState(w[1])].noappend = 1;
+        }
+        else
+        {
+            if (n < 4 || strcmp(w[n - 2], "->") != 0)
+                specError("usage: <from> <charset> ... -> <to>", NULL);
+            int from = parseState(w[0]);
+            int to = parseState(w[n - 1]);
+            for (int i = 1; i < n - 2; i++)
+                addEdges(from, to, w[i]);
+        }
+    }
+    fclose(fp);
+
+    if (!spec[0].used)
+    {
+        lineNo = 0;
+        specError("the spec does not define start state 0", NULL);
+    }
+    for (int s = 0; s < MAX_SPEC_STATES; s++)
+    {
+        if (!spec[s].accepting)
+            continue;
+        int hasEdge = spec[s].other != NO_EDGE;
+        for (int c = 0; c < 256 && !hasEdge; c++)
+            hasEdge = spec[s].next[c] != NO_EDGE;
+        if (hasEdge)
+        {
+            fprintf(stderr, "%s: error: accepting state %d has outgoing edges\n", fn, s);
+            exit(EXIT_FAILURE);
+        }
+    }
+}
+
+/**
+ * @brief Resolves the spec transition of state s on byte c ("other" included).
+ */
+static int specNext(int s, int c)
+{
+    return spec[s].next[c] != NO_EDGE ? spec[s].next[c] : spec[s].other;
+}
+
+/**
+ * @brief The keyword hash; must match keywordHash() in lexer.c.
+ *
+ * @param asso Associated value per byte.
+ * @param lex The lexeme.
+ * @param len Its length (at least 1).
+ * @param size Table size (power of two).
+ */
+static unsigned hashKeyword(const unsigned *asso, const char *lex, int len, unsigned size)
+{
+    return (len + asso[(unsigned char)lex[0]] + asso[(unsigned char)lex[len > 1]] +
+            asso[(unsigned char)lex[len - 1]]) & (size - 1);
+}
+
+/**
+ * @brief Counts keywords that land in an already occupied slot.
+ */
+static int countCollisions(const unsigned *asso, unsigned size, int *slotOwner)
+{
+    int collisions = 0;
+    for (unsigned i = 0; i < size; i++)
+        slotOwner[i] = -1;
+    for (int k = 0; k < nKeywords; k++)
+    {
+        unsigned h = hashKeyword(asso, keywords[k].lexeme, (int)strlen(keywords[k].lexeme), size);
+        if (slotOwner[h] == -1)
+            slotOwner[h] = k;
+        else
+            collisions++;
+    }
+    return collisions;
+}
+
+/**
+ * @brief Searches associated byte values that make the keyword hash perfect.
+ *
+ * Starting from the smallest power of two that holds every keyword, a seeded
+ * local search repeatedly re-assigns the value of one character of a
+ * colliding keyword to whatever minimizes the number of collisions. The table
+ * doubles if no perfect assignment shows up within the step budget.
+ *
+ * @param asso Output: 256 associated values.
+ * @return unsigned The table size.
+ */
+static unsigned findKeywordHash(unsigned *asso)
+{
+    unsigned size = 1;
+    while (size < (unsigned)nKeywords)
+        size <<= 1;
+    if (nKeywords == 0)
+    {
+        memset(asso, 0, 256 * sizeof(unsigned));
+        return 1;
+    }
+
+    unsigned rng = HASH_SEED;
+    int *owner = (int *)malloc(4096 * sizeof(int));
+    for (; size <= 4096; size <<= 1)
+    {
+        for (int attempt = 0; attempt < 50; attempt++)
+        {
+            for (int c = 0; c < 256; c++)
+            {
+                rng = rng * 1103515245u + 12345u;
+                asso[c] = (rng >> 16) & (size - 1);
+            }
+            int best = countCollisions(asso, size, owner);
+            for (int step = 0; step < 2000 && best > 0; step++)
+            {
+                /* Pick a keyword that collides and perturb one of its hashed characters */
+                int k;
+                do
+                {
+                    rng = rng * 1103515245u + 12345u;
+                    k = (int)((rng >> 16) % (unsigned)nKeywords);
+                    const char *lex = keywords[k].lexeme;
+                    int len = (int)strlen(lex);
+                    if (owner[hashKeyword(asso, lex, len, size)] != k)
+                        break;
+                } while (1);
+
+                const char *lex = keywords[k].lexeme;
+                int len = (int)strlen(lex);
+                rng = rng * 1103515245u + 12345u;
+                int pick = (int)((rng >> 16) % 3);
+                unsigned char c = (unsigned char)(pick == 0 ? lex[0] : pick == 1 ? lex[len > 1] : lex[len - 1]);
+
+                unsigned bestValue = asso[c];
+                for (unsigned v = 0; v < size; v++)
+                {
+                    asso[c] = v;
+                    int coll = countCollisions(asso, size, owner);
+                    if (coll < best || (coll == best && ((rng >> 8) & 1)))
+                    {
+                        best = coll;
+                        bestValue = v;
+                    }
+                }
+                asso[c] = bestValue;
+                countCollisions(asso, size, owner);
+            }
+            if (best == 0)
+            {
+                free(owner);
+                return size;
+            }
+        }
+    }
+    free(owner);
+    fprintf(stderr, "%s: error: no perfect keyword hash found\n", specName);
+    exit(EXIT_FAILURE);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 3)
+    {
+        fprintf(stderr, "Usage: %s <lexer.spec> <lexerDef.h>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    readSpec(argv[1]);
+
+    /* Keep only states reachable from the start state */
+    int reach[MAX_SPEC_STATES] = {0};
+    int order[MAX_SPEC_STATES];
+    int nReach = 0;
+    reach[0] = 1;
+    order[nReach++] = 0;
+    for (int i = 0; i < nReach; i++)
+    {
+        for (int c = 0; c < 256; c++)
+        {
+            int t = specNext(order[i], c);
+            if (t != NO_EDGE && !reach[t])
+            {
+                reach[t] = 1;
+                order[nReach++] = t;
+            }
+        }
+    }
+    for (int s = 0; s < MAX_SPEC_STATES; s++)
+    {
+        if (spec[s].used && !reach[s])
+            fprintf(stderr, "%s: warning: state %d is unreachable\n", argv[1], s);
+    }
+
+    /*
+     * Moore minimization. The initial partition separates states by their
+     * metadata; blocks are then split until every pair in a block moves to
+     * the same block on every byte.
+     */
+    int block[MAX_SPEC_STATES];
+    int nBlocks = 0;
+    for (int i = 0; i < nReach; i++)
+    {
+        int s = order[i];
+        block[s] = -1;
+        for (int j = 0; j < i; j++)
+        {
+            int r = order[j];
+            if (spec[r].accepting == spec[s].accepting && spec[r].retract == spec[s].retract &&
+                strcmp(spec[r].action, spec[s].action) == 0 && spec[r].newline == spec[s].newline &&
+                spec[r].noappend == spec[s].noappend)
+            {
+                block[s] = block[r];
+                break;
+            }
+        }
+        if (block[s] == -1)
+            block[s] = nBlocks++;
+    }
+
+    int changed = 1;
+    while (changed)
+    {
+        int newBlock[MAX_SPEC_STATES];
+        int newCount = 0;
+        changed = 0;
+        for (int i = 0; i < nReach; i++)
+        {
+            int s = order[i];
+            newBlock[s] = -1;
+            for (int j = 0; j < i; j++)
+            {
+                int r = order[j];
+                if (block[r] != block[s])
+                    continue;
+                int same = 1;
+                for (int c = 0; c < 256 && same; c++)
+                {
+                    int tr = specNext(r, c), ts = specNext(s, c);
+                    int br = tr == NO_EDGE ? -1 : block[tr];
+                    int bs = ts == NO_EDGE ? -1 : block[ts];
+                    same = br == bs;
+                }
+                if (same)
+                {
+                    newBlock[s] = newBlock[r];
+                    break;
+                }
+            }
+            if (newBlock[s] == -1)
+                newBlock[s] = newCount++;
+        }
+        if (newCount != nBlocks)
+            changed = 1;
+        nBlocks = newCount;
+        for (int i = 0; i < nReach; i++)
+            block[order[i]] = newBlock[order[i]];
+    }
+
+    /* One representative spec state per minimized state (BFS order keeps 0 first) */
+    int rep[MAX_SPEC_STATES];
+    for (int i = nReach - 1; i >= 0; i--)
+        rep[block[order[i]]] = order[i];
+
+    /* Byte equivalence classes: identical columns in the minimized table */
+    int classOf[256];
+    int classRep[256];
+    int nClasses = 0;
+    for (int c = 0; c < 256; c++)
+    {
+        classOf[c] = -1;
+        for (int k = 0; k < nClasses && classOf[c] == -1; k++)
+        {
+            int d = classRep[k];
+            int same = 1;
+            for (int b = 0; b < nBlocks && same; b++)
+            {
+                int tc = specNext(rep[b], c), td = specNext(rep[b], d);
+                same = (tc == NO_EDGE ? -1 : block[tc]) == (td == NO_EDGE ? -1 : block[td]);
+            }
+            if (same)
+                classOf[c] = k;
+        }
+        if (classOf[c] == -1)
+        {
+            classRep[nClasses] = c;
+            classOf[c] = nClasses++;
+        }
+    }
+
+    FILE *out = fopen(argv[2], "w");
+    if (!out)
+    {
+        perror(argv[2]);
+        return EXIT_FAILURE;
+    }
+    const char *stateType = nBlocks < 128 ? "signed char" : "short";
+
+    fprintf(out, "/* Generated by tools/lexgen from %s -- do not edit by hand. */\n\n", argv[1]);
+    fprintf(out, "#ifndef LEXERDEF_H\n#define LEXERDEF_H\n\n#include \"lexer.h\"\n\n");
+    fprintf(out, "#define LEX_START_STATE 0\n");
+    fprintf(out, "#define LEX_NUM_STATES %d\n", nBlocks);
+    fprintf(out, "#define LEX_NUM_CLASSES %d\n\n", nClasses);
+
+    fprintf(out, "/* Byte -> character class */\nstatic const unsigned char lexCharClass[256] = {");
+    for (int c = 0; c < 256; c++)
+        fprintf(out, "%s%2d,", c % 16 == 0 ? "\n    " : " ", classOf[c]);
+    fprintf(out, "\n};\n\n");
+
+    fprintf(out, "/* [state][class] -> next state, TRAP_STATE on error */\n");
+    fprintf(out, "static const %s lexTransition[LEX_NUM_STATES][LEX_NUM_CLASSES] = {\n", stateType);
+    for (int b = 0; b < nBlocks; b++)
+    {
+        fprintf(out, "    {");
+        for (int k = 0; k < nClasses; k++)
+        {
+            int t = specNext(rep[b], classRep[k]);
+            fprintf(out, "%s%2d", k ? ", " : "", t == NO_EDGE ? -1 : block[t]);
+        }
+        fprintf(out, "}, /* spec state %d */\n", rep[b]);
+    }
+    fprintf(out, "};\n\n");
+
+    static const char *details[] = {"NON_FINAL", "FINAL_NO_RETRACT", "FINAL_RETRACTONCE", "FINAL_RETRACTTWICE"};
+    fprintf(out, "/* Per-state accept/retract metadata */\nstatic const unsigned char lexStateDetail[LEX_NUM_STATES] = {\n");
+    for (int b = 0; b < nBlocks; b++)
+    {
+        int s = rep[b];
+        fprintf(out, "    %s,\n", spec[s].accepting ? details[1 + spec[s].retract] : details[0]);
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "/* Per-state accept action */\nstatic const unsigned char lexStateAction[LEX_NUM_STATES] = {\n");
+    for (int b = 0; b < nBlocks; b++)
+    {
+        const char *a = spec[rep[b]].action;
+        const char *name = !spec[rep[b]].accepting ? "LEX_NONE"
+                           : strcmp(a, "@funid") == 0   ? "LEX_FUNID"
+                           : strcmp(a, "@fieldid") == 0 ? "LEX_FIELDID"
+                           : strcmp(a, "@skip") == 0    ? "LEX_SKIP"
+                           : strcmp(a, "@exit") == 0    ? "LEX_EXIT"
+                                                        : "LEX_TOKEN";
+        fprintf(out, "    %s,\n", name);
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "/* Token produced by LEX_TOKEN states */\nstatic const unsigned char lexStateToken[LEX_NUM_STATES] = {\n");
+    for (int b = 0; b < nBlocks; b++)
+    {
+        const char *a = spec[rep[b]].action;
+        fprintf(out, "    %s,\n", strncmp(a, "TK_", 3) == 0 ? a : "TK_ERR");
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "/* LEX_FLAG_* bits */\nstatic const unsigned char lexStateFlags[LEX_NUM_STATES] = {\n");
+    for (int b = 0; b < nBlocks; b++)
+    {
+        int s = rep[b];
+        if (spec[s].newline && spec[s].noappend)
+            fprintf(out, "    LEX_FLAG_NEWLINE | LEX_FLAG_NOAPPEND,\n");
+        else if (spec[s].newline)
+            fprintf(out, "    LEX_FLAG_NEWLINE,\n");
+        else if (spec[s].noappend)
+            fprintf(out, "    LEX_FLAG_NOAPPEND,\n");
+        else
+            fprintf(out, "    0,\n");
+    }
+    fprintf(out, "};\n\n");
+
+    /*
+     * Self-loops: the bytes on which a state stays put, written as at most two
+     * byte ranges or as the complement of at most two ranges. Anything more
+     * ragged is left to the per-character loop.
+     */
+    fprintf(out, "/* Self-loop runs, see lexRunLength() in lexrun.c */\nstatic const LexRun lexStateRun[LEX_NUM_STATES] = {\n");
+    int nRuns = 0;
+    for (int b = 0; b < nBlocks; b++)
+    {
+        int loops[256], nLoops = 0;
+        for (int c = 0; c < 256; c++)
+        {
+            int t = specNext(rep[b], c);
+            loops[c] = t != NO_EDGE && block[t] == b;
+            nLoops += loops[c];
+        }
+
+        const char *kinds[] = {"LEX_RUN_IN", "LEX_RUN_OUT"};
+        int emitted = 0;
+        for (int k = 0; k < 2 && nLoops > 0 && !emitted; k++)
+        {
+            int lo[3], hi[3], n = 0;
+            for (int c = 0; c < 256 && n <= 2; c++)
+            {
+                if (loops[c] != (k == 0))
+                    continue;
+                if (n > 0 && hi[n - 1] == c - 1)
+                    hi[n - 1] = c;
+                else
+                {
+                    lo[n] = hi[n] = c;
+                    n++;
+                }
+            }
+            if (n == 0 || n > 2)
+                continue;
+            if (n == 1)
+            {
+                lo[1] = lo[0];
+                hi[1] = hi[0];
+            }
+            fprintf(out, "    {%s, %3d, %3d, %3d, %3d}, /* spec state %d */\n", kinds[k], lo[0], hi[0], lo[1], hi[1], rep[b]);
+            emitted = 1;
+            nRuns++;
+        }
+        if (!emitted)
+            fprintf(out, "    {LEX_RUN_NONE, 0, 0, 0, 0},\n");
+    }
+    fprintf(out, "};\n\n");
+
+    /* Keyword perfect hash */
+    unsigned asso[256];
+    unsigned hashSize = findKeywordHash(asso);
+    int slot[4096];
+    int maxLen = 0;
+    countCollisions(asso, hashSize, slot);
+    for (int k = 0; k < nKeywords; k++)
+    {
+        int len = (int)strlen(keywords[k].lexeme);
+        if (len > maxLen)
+            maxLen = len;
+    }
+
+    fprintf(out, "/* Keyword perfect hash, see keywordHash() in lexer.c */\n");
+    fprintf(out, "#define LEX_KEYWORD_COUNT %d\n", nKeywords);
+    fprintf(out, "#define LEX_KEYWORD_HASH_SIZE %u\n", hashSize);
+    fprintf(out, "#define LEX_KEYWORD_MAX_LEN %d\n\n", maxLen);
+    fprintf(out, "static const %s lexKeywordAsso[256] = {", hashSize <= 256 ? "unsigned char" : "unsigned short");
+    for (int c = 0; c < 256; c++)
+        fprintf(out, "%s%2u,", c % 16 == 0 ? "\n    " : " ", asso[c]);
+    fprintf(out, "\n};\n\n");
+
+    fprintf(out, "static const char *const lexKeywordText[LEX_KEYWORD_HASH_SIZE] = {\n");
+    for (unsigned h = 0; h < hashSize; h++)
+    {
+        if (slot[h] == -1)
+            fprintf(out, "    NULL,\n");
+        else
+            fprintf(out, "    \"%s\",\n", keywords[slot[h]].lexeme);
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "static const unsigned char lexKeywordLength[LEX_KEYWORD_HASH_SIZE] = {\n");
+    for (unsigned h = 0; h < hashSize; h++)
+        fprintf(out, "    %d,\n", slot[h] == -1 ? 0 : (int)strlen(keywords[slot[h]].lexeme));
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "static const unsigned char lexKeywordType[LEX_KEYWORD_HASH_SIZE] = {\n");
+    for (unsigned h = 0; h < hashSize; h++)
+        fprintf(out, "    %s,\n", slot[h] == -1 ? "TK_ID" : keywords[slot[h]].type);
+    fprintf(out, "};\n\n#endif /* LEXERDEF_H */\n");
+    fclose(out);
+
+    fprintf(stderr, "lexgen: %d spec states -> %d states, %d character classes, %d run states, %d keywords in %u slots\n",
+            nReach, nBlocks, nClasses, nRuns, nKeywords, hashSize);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,560 @@
+/**
+ * @file proggen.c
+ * @brief Generates random, syntactically correct programs of any size for benchmarks.
+ *
+ * Programs are derived from the productions of grammarDef.h (generated from
+ * grammer.txt). Starting from <program>, every non-terminal is expanded by
+ * one of its productions, chosen at random under the knobs below. Every
+ * terminal is written as its keyword or symbol, or as an identifier or number
+ * the lexer accepts. The same seed and knobs always give the same bytes.
+ *
+ *   ./tools/proggen --seed 7 --size 64M -o big.txt
+ *
+ * Knobs:
+ *   --seed N            random seed (1)
+ *   --size BYTES[K|M|G] emit functions until the output reaches about this size,
+ *                       then end every list and close the program in its shortest
+ *                       form; overrides --functions
+ *   --functions N       functions before _main (4)
+ *   --stmts N           mean statements in a function body (8)
+ *   --depth N           deepest nesting of while and if (3)
+ *   --expr N            most operators in an arithmetic expression (4)
+ *   --records N         mean record and union definitions per function (1)
+ *   --comments PCT      percentage of lines preceded by a comment line (5)
+ *   --vocab N           distinct variable identifiers (256)
+ *   --lex-errors R      lexical errors per 1000 tokens: overlong identifiers and unknown symbols (0)
+ *   --syntax-errors R   syntax errors per 1000 tokens: a token is left out (0)
+ *   -o FILE             output file (standard output)
+ *
+ * A summary goes to standard error.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../grammarDef.h"
+#include "../lexerDef.h"
+
+#define GEN_MARK_UNNEST -10     ///< Stack marker: the while or if being expanded is complete
+#define GEN_MARK_NEWLINE -11    ///< Stack marker: end the current line
+#define GEN_MIN_FUNCTION 64     ///< Bytes of about the smallest function, one parameter and a bare return
+#define GEN_MAX_NAME 32         ///< Longest generated lexeme, terminator included
+#define GEN_OUT_BUFFER (1 << 20)
+
+typedef struct
+{
+    uint64_t seed;
+    uint64_t size;
+    int functions;
+    int stmts;
+    int depth;
+    int expr;
+    int records;
+    int comments;
+    int vocab;
+    double lexErrors;
+    double syntaxErrors;
+} Knobs;
+
+typedef struct
+{
+    Knobs k;
+    uint64_t rng;
+    FILE *out;
+    uint64_t written;       // Bytes written
+    uint64_t tokens;        // Terminals written
+    uint64_t lexErrors;
+    uint64_t syntaxErrors;
+    int functions;          // Functions started
+    int nesting;            // while and if around the symbol being expanded
+    int exprBudget;         // Operators left in the current arithmetic expression
+    int boolBudget;         // Connectives left in the current boolean expression
+    bool lineStart;
+    bool glue;              // The last symbol written takes no space after it
+    const char *text[NONTERMINALS_START]; // Spelling of the fixed terminals
+    int firstRule[TERMS_SIZE];            // Productions of a non-terminal are contiguous
+    int ruleCount[TERMS_SIZE];
+} Generator;
+
+// splitmix64: small, fast and the same on every platform
+static uint64_t nextRandom(Generator *g)
+{
+    uint64_t z = (g->rng += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+static uint32_t randomBelow(Generator *g, uint32_t n)
+{
+    return (uint32_t)(((nextRandom(g) >> 32) * n) >> 32);
+}
+
+static bool chance(Generator *g, double p)
+{
+    return (nextRandom(g) >> 11) * (1.0 / 9007199254740992.0) < p;
+}
+
+// Keeps a list going with probability mean / (mean + 1): geometric, of the given mean
+static bool another(Generator *g, double mean)
+{
+    return chance(g, mean / (mean + 1.0));
+}
+
+static void put(Generator *g, const char *s, size_t length)
+{
+    fwrite(s, 1, length, g->out);
+    g->written += length;
+}
+
+// Bijective base-n digits of i, so that every i gets a different string
+static int encode(char *dst, uint64_t i, const char *digits, int n)
+{
+    char tmp[GEN_MAX_NAME];
+    int len = 0;
+    while (i > 0 && len < GEN_MAX_NAME - 8)
+    {
+        i--;
+        tmp[len++] = digits[i % n];
+        i /= n;
+    }
+    for (int j = 0; j < len; j++)
+        dst[j] = tmp[len - 1 - j];
+    return len;
+}
+
+// TK_ID: [b-d][2-7][b-d]*[2-7]*, at most 20 characters
+static void variableName(char *dst, uint32_t i)
+{
+    dst[0] = "bcd"[i % 3];
+    dst[1] = "234567"[(i / 3) % 6];
+    int len = 2 + encode(dst + 2, i / 18, "bcd", 3);
+    dst[len] = '\0';
+}
+
+// TK_FIELDID: [a-z]+ that is no keyword; no keyword starts with these letters
+static void fieldName(char *dst, uint32_t i)
+{
+    dst[0] = "fhjkmnqvxyz"[i % 11];
+    int len = 1 + encode(dst + 1, i / 11, "abcdefghijklmnopqrstuvwxyz", 26);
+    dst[len] = '\0';
+}
+
+// TK_FUNID: _[a-zA-Z]+[0-9]*; the capital keeps clear of _main
+static void functionName(char *dst, uint32_t i)
+{
+    dst[0] = '_';
+    dst[1] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ"[i % 26];
+    int len = 2 + encode(dst + 2, i / 26, "abcdefghijklmnopqrstuvwxyz", 26);
+    dst[len] = '\0';
+}
+
+// TK_RUID: #[a-z]+
+static void typeName(char *dst, uint32_t i)
+{
+    dst[0] = '#';
+    int len = 1 + encode(dst + 1, (uint64_t)i + 1, "abcdefghijklmnopqrstuvwxyz", 26);
+    dst[len] = '\0';
+}
+
+static void initGenerator(Generator *g, const Knobs *k, FILE *out)
+{
+    memset(g, 0, sizeof(*g));
+    g->k = *k;
+    g->rng = k->seed;
+    g->out = out;
+    g->lineStart = true;
+
+    // Keywords from the lexer's keyword table, symbols by hand
+    for (int h = 0; h < LEX_KEYWORD_HASH_SIZE; h++)
+    {
+        if (lexKeywordText[h] != NULL)
+            g->text[tokenTerminal[lexKeywordType[h]]] = lexKeywordText[h];
+    }
+    static const struct { int terminal; const char *text; } symbols[] = {
+        {SYM_TK_ASSIGNOP, "<---"}, {SYM_TK_LT, "<"}, {SYM_TK_LE, "<="}, {SYM_TK_EQ, "=="},
+        {SYM_TK_GT, ">"}, {SYM_TK_GE, ">="}, {SYM_TK_NE, "!="}, {SYM_TK_AND, "&&&"},
+        {SYM_TK_OR, "@@@"}, {SYM_TK_NOT, "~"}, {SYM_TK_PLUS, "+"}, {SYM_TK_MINUS, "-"},
+        {SYM_TK_MUL, "*"}, {SYM_TK_DIV, "/"}, {SYM_TK_SQL, "["}, {SYM_TK_SQR, "]"},
+        {SYM_TK_OP, "("}, {SYM_TK_CL, ")"}, {SYM_TK_COMMA, ","}, {SYM_TK_SEM, ";"},
+        {SYM_TK_COLON, ":"}, {SYM_TK_DOT, "."},
+    };
+    for (size_t i = 0; i < sizeof(symbols) / sizeof(symbols[0]); i++)
+        g->text[symbols[i].terminal] = symbols[i].text;
+
+    for (int r = GRAMMAR_SIZE - 1; r >= 0; r--)
+    {
+        g->firstRule[grammarRules[r][0]] = r;
+        g->ruleCount[grammarRules[r][0]]++;
+    }
+}
+
+static int ruleLength(int rule)
+{
+    int n = 0;
+    while (grammarRules[rule][1 + n] != -1)
+        n++;
+    return n;
+}
+
+// Past --size every list ends and every statement and expression takes its shortest form
+static bool budgetSpent(const Generator *g)
+{
+    return g->k.size && g->written >= g->k.size;
+}
+
+// The longer of a two-way choice keeps a list going, the shorter ends it
+static int listRule(Generator *g, int nt, bool more)
+{
+    more = more && !budgetSpent(g);
+    int a = g->firstRule[nt], b = a + 1;
+    bool aLonger = ruleLength(a) > ruleLength(b);
+    return more == aLonger ? a : b;
+}
+
+// The production of nt whose right-hand side starts with sym
+static int ruleStartingWith(Generator *g, int nt, int sym)
+{
+    for (int r = g->firstRule[nt]; r < g->firstRule[nt] + g->ruleCount[nt]; r++)
+    {
+        if (grammarRules[r][1] == sym)
+            return r;
+    }
+    fprintf(stderr, "proggen: <%s> has no production starting with %s\n", grammarTerms[nt], grammarTerms[sym]);
+    exit(EXIT_FAILURE);
+}
+
+static int chooseRule(Generator *g, int nt)
+{
+    const Knobs *k = &g->k;
+    switch (nt)
+    {
+    case SYM_otherFunctions:
+    {
+        // Another function while one of the smallest still fits in --size
+        bool more = k->size ? g->written + GEN_MIN_FUNCTION < k->size : g->functions < k->functions;
+        g->functions += more;
+        return listRule(g, nt, more);
+    }
+    case SYM_typeDefinitions:
+        return listRule(g, nt, another(g, k->records));
+    case SYM_declarations:
+        return listRule(g, nt, another(g, k->stmts / 2.0));
+    case SYM_otherStmts:
+        return listRule(g, nt, another(g, g->nesting == 0 ? k->stmts : 1.5));
+    case SYM_remaining_list:
+    case SYM_more_ids:
+        return listRule(g, nt, chance(g, 0.5));
+    case SYM_moreFields:
+        return listRule(g, nt, chance(g, 0.4));
+    case SYM_output_par:
+        return listRule(g, nt, chance(g, 0.7));
+    case SYM_optionalReturn:
+    case SYM_elsePart:
+        return listRule(g, nt, chance(g, 0.4));
+    case SYM_outputParameters:
+        return listRule(g, nt, chance(g, 0.3));
+    case SYM_option_single_constructed:
+    case SYM_moreExpansions:
+        return listRule(g, nt, chance(g, 0.15));
+    case SYM_global_or_not:
+        return listRule(g, nt, chance(g, 0.1));
+    case SYM_expPrime:
+    case SYM_termPrime:
+    {
+        bool more = g->exprBudget > 0 && chance(g, 0.6);
+        g->exprBudget -= more;
+        return listRule(g, nt, more);
+    }
+    case SYM_factor:
+        if (!budgetSpent(g) && g->exprBudget > 1 && chance(g, 0.15))
+        {
+            g->exprBudget--;
+            return ruleStartingWith(g, nt, SYM_TK_OP);
+        }
+        return ruleStartingWith(g, nt, SYM_var);
+    case SYM_var:
+    {
+        uint32_t p = randomBelow(g, 100);
+        return ruleStartingWith(g, nt, p < 60 ? SYM_SingleOrRecId : p < 85 ? SYM_TK_NUM : SYM_TK_RNUM);
+    }
+    case SYM_booleanExpression:
+        if (!budgetSpent(g) && g->boolBudget > 0 && chance(g, 0.4))
+        {
+            g->boolBudget--;
+            return ruleStartingWith(g, nt, chance(g, 0.8) ? SYM_TK_OP : SYM_TK_NOT);
+        }
+        return ruleStartingWith(g, nt, SYM_var);
+    case SYM_stmt:
+    {
+        bool nest = g->nesting < k->depth;
+        uint32_t p = budgetSpent(g) ? 0 : randomBelow(g, nest ? 100 : 75);
+        int first = p < 45 ? SYM_assignmentStmt : p < 60 ? SYM_ioStmt : p < 75 ? SYM_funCallStmt : p < 85 ? SYM_iterativeStmt : SYM_conditionalStmt;
+        return ruleStartingWith(g, nt, first);
+    }
+    case SYM_actualOrRedefined:
+        return ruleStartingWith(g, nt, chance(g, 0.2) ? SYM_definetypestmt : SYM_typeDefinition);
+    case SYM_dataType:
+    case SYM_fieldType:
+        return ruleStartingWith(g, nt, chance(g, 0.2) ? SYM_constructedDataType : SYM_primitiveDataType);
+    default:
+        return g->firstRule[nt] + (int)randomBelow(g, (uint32_t)g->ruleCount[nt]);
+    }
+}
+
+static void newline(Generator *g)
+{
+    if (!g->lineStart)
+        put(g, "\n", 1);
+    g->lineStart = true;
+    g->glue = false;
+}
+
+// Spelling of a terminal; identifiers and numbers are made up on the spot
+static const char *terminalText(Generator *g, int terminal, char *buf)
+{
+    uint32_t fields = (uint32_t)g->k.vocab / 4 + 8, names = (uint32_t)g->k.vocab / 8 + 4;
+    switch (terminal)
+    {
+    case SYM_TK_ID:
+        variableName(buf, randomBelow(g, (uint32_t)g->k.vocab));
+        return buf;
+    case SYM_TK_FIELDID:
+        fieldName(buf, randomBelow(g, fields));
+        return buf;
+    case SYM_TK_FUNID:
+        functionName(buf, randomBelow(g, names));
+        return buf;
+    case SYM_TK_RUID:
+        typeName(buf, randomBelow(g, names));
+        return buf;
+    case SYM_TK_NUM:
+        snprintf(buf, GEN_MAX_NAME, "%u", randomBelow(g, 100000));
+        return buf;
+    case SYM_TK_RNUM:
+        if (chance(g, 0.2))
+        {
+            static const char *const signs[] = {"", "+", "-"};
+            snprintf(buf, GEN_MAX_NAME, "%u.%02uE%s%02u", randomBelow(g, 1000), randomBelow(g, 100), signs[randomBelow(g, 3)], randomBelow(g, 100));
+        }
+        else
+            snprintf(buf, GEN_MAX_NAME, "%u.%02u", randomBelow(g, 1000), randomBelow(g, 100));
+        return buf;
+    default:
+        return g->text[terminal];
+    }
+}
+
+static const char *lexicalError(Generator *g)
+{
+    static const char *const errors[] = {"b2cccccccccccccccccccc", "_functionNameThatIsFarTooLongToBeValid", "$", "5000.7", "&&", "@", "!"};
+    return errors[randomBelow(g, sizeof(errors) / sizeof(errors[0]))];
+}
+
+static void emitTerminal(Generator *g, int terminal)
+{
+    char buf[GEN_MAX_NAME];
+    const char *text = terminalText(g, terminal, buf);
+    if (g->k.syntaxErrors > 0 && chance(g, g->k.syntaxErrors / 1000.0))
+    {
+        g->syntaxErrors++;
+        return;
+    }
+    if (g->k.lexErrors > 0 && chance(g, g->k.lexErrors / 1000.0))
+    {
+        text = lexicalError(g);
+        g->lexErrors++;
+    }
+
+    if (g->lineStart)
+    {
+        // Function headers and ends sit at the margin, while and if one level out from their bodies
+        int indent = 1 + g->nesting;
+        if (terminal == SYM_TK_FUNID || terminal == SYM_TK_MAIN || terminal == SYM_TK_END)
+            indent = 0;
+        else if (terminal == SYM_TK_WHILE || terminal == SYM_TK_IF || terminal == SYM_TK_ENDWHILE ||
+                 terminal == SYM_TK_ENDIF || terminal == SYM_TK_ELSE)
+            indent--;
+        if (g->k.comments > 0 && chance(g, g->k.comments / 100.0))
+        {
+            for (int i = 0; i < indent; i++)
+                put(g, "\t", 1);
+            char comment[64];
+            int n = snprintf(comment, sizeof(comment), "%% generated comment %u\n", randomBelow(g, 1000));
+            put(g, comment, (size_t)n);
+        }
+        for (int i = 0; i < indent; i++)
+            put(g, "\t", 1);
+    }
+    else if (!g->glue && terminal != SYM_TK_SEM && terminal != SYM_TK_COMMA && terminal != SYM_TK_DOT &&
+             terminal != SYM_TK_CL && terminal != SYM_TK_SQR)
+        put(g, " ", 1);
+    put(g, text, strlen(text));
+    g->tokens++;
+    g->lineStart = false;
+    g->glue = terminal == SYM_TK_DOT || terminal == SYM_TK_OP || terminal == SYM_TK_SQL;
+
+    if (terminal == SYM_TK_SEM || terminal == SYM_TK_MAIN || terminal == SYM_TK_THEN || terminal == SYM_TK_ELSE ||
+        terminal == SYM_TK_ENDIF || terminal == SYM_TK_ENDWHILE || terminal == SYM_TK_ENDRECORD ||
+        terminal == SYM_TK_ENDUNION)
+        newline(g);
+    else if (terminal == SYM_TK_END)
+    {
+        newline(g);
+        put(g, "\n", 1);
+    }
+}
+
+static void generate(Generator *g)
+{
+    int capacity = 256, depth = 0;
+    int *stack = (int *)malloc(capacity * sizeof(int));
+    if (!stack)
+    {
+        fprintf(stderr, "Memory allocation failed in generate\n");
+        exit(EXIT_FAILURE);
+    }
+    stack[depth++] = SYM_program;
+    while (depth > 0)
+    {
+        int sym = stack[--depth];
+        if (sym == GEN_MARK_UNNEST)
+        {
+            g->nesting--;
+            continue;
+        }
+        if (sym == GEN_MARK_NEWLINE)
+        {
+            newline(g);
+            continue;
+        }
+        if (sym == EPSILON)
+            continue;
+        if (sym < NONTERMINALS_START)
+        {
+            emitTerminal(g, sym);
+            continue;
+        }
+
+        if (sym == SYM_assignmentStmt)
+            g->exprBudget = (int)randomBelow(g, (uint32_t)g->k.expr + 1);
+        else if (sym == SYM_iterativeStmt || sym == SYM_conditionalStmt)
+            g->boolBudget = (int)randomBelow(g, 3);
+        int rule = chooseRule(g, sym);
+        const int *rhs = grammarRules[rule] + 1;
+        int n = ruleLength(rule);
+        if (depth + 2 * n + 2 > capacity)
+        {
+            capacity = 2 * capacity + 2 * n + 2;
+            stack = (int *)realloc(stack, capacity * sizeof(int));
+            if (!stack)
+            {
+                fprintf(stderr, "Memory allocation failed in generate\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        // Statements nested in a while or if are indented until its end
+        if (sym == SYM_iterativeStmt || sym == SYM_conditionalStmt)
+        {
+            stack[depth++] = GEN_MARK_UNNEST;
+            g->nesting++;
+        }
+        if (sym == SYM_definetypestmt)
+            stack[depth++] = GEN_MARK_NEWLINE;
+        for (int i = n - 1; i >= 0; i--)
+        {
+            // Field definitions and the body of a while, if or else start on a line of their own
+            if (i + 1 < n && (rhs[i + 1] == SYM_stmt || rhs[i + 1] == SYM_fieldDefinitions))
+                stack[depth++] = GEN_MARK_NEWLINE;
+            stack[depth++] = rhs[i];
+        }
+    }
+    free(stack);
+}
+
+static uint64_t parseSize(const char *s)
+{
+    char *end;
+    double v = strtod(s, &end);
+    switch (*end)
+    {
+    case 'k': case 'K': v *= 1024; break;
+    case 'm': case 'M': v *= 1024 * 1024; break;
+    case 'g': case 'G': v *= 1024.0 * 1024 * 1024; break;
+    default: break;
+    }
+    return (uint64_t)v;
+}
+
+int main(int argc, char **argv)
+{
+    Knobs k = {1, 0, 4, 8, 3, 4, 1, 5, 256, 0, 0};
+    const char *outPath = NULL;
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i], *value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (!value)
+        {
+            fprintf(stderr, "Usage: %s [--seed N] [--size BYTES[K|M|G]] [--functions N] [--stmts N] [--depth N] [--expr N] [--records N] [--comments PCT] [--vocab N] [--lex-errors R] [--syntax-errors R] [-o FILE]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+        i++;
+        if (strcmp(arg, "--seed") == 0)
+            k.seed = strtoull(value, NULL, 10);
+        else if (strcmp(arg, "--size") == 0)
+            k.size = parseSize(value);
+        else if (strcmp(arg, "--functions") == 0)
+            k.functions = atoi(value);
+        else if (strcmp(arg, "--stmts") == 0)
+            k.stmts = atoi(value);
+        else if (strcmp(arg, "--depth") == 0)
+            k.depth = atoi(value);
+        else if (strcmp(arg, "--expr") == 0)
+            k.expr = atoi(value);
+        else if (strcmp(arg, "--records") == 0)
+            k.records = atoi(value);
+        else if (strcmp(arg, "--comments") == 0)
+            k.comments = atoi(value);
+        else if (strcmp(arg, "--vocab") == 0)
+            k.vocab = atoi(value);
+        else if (strcmp(arg, "--lex-errors") == 0)
+            k.lexErrors = atof(value);
+        else if (strcmp(arg, "--syntax-errors") == 0)
+            k.syntaxErrors = atof(value);
+        else if (strcmp(arg, "-o") == 0)
+            outPath = value;
+        else
+        {
+            fprintf(stderr, "Unknown option %s\n", arg);
+            return EXIT_FAILURE;
+        }
+    }
+    if (k.vocab < 1)
+        k.vocab = 1;
+    if (k.expr < 0)
+        k.expr = 0;
+
+    FILE *out = outPath ? fopen(outPath, "w") : stdout;
+    if (!out)
+    {
+        perror(outPath);
+        return EXIT_FAILURE;
+    }
+    setvbuf(out, NULL, _IOFBF, GEN_OUT_BUFFER);
+
+    Generator g;
+    initGenerator(&g, &k, out);
+    generate(&g);
+    if (fflush(out) != 0 || (out != stdout && fclose(out) != 0))
+    {
+        perror(outPath ? outPath : "stdout");
+        return EXIT_FAILURE;
+    }
+    fprintf(stderr, "[INFO] %llu bytes, %llu tokens, %d functions and _main; %llu lexical and %llu syntax errors injected\n",
+            (unsigned long long)g.written, (unsigned long long)g.tokens, g.functions,
+            (unsigned long long)g.lexErrors, (unsigned long long)g.syntaxErrors);
+    return EXIT_SUCCESS;
+}
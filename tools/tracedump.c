@@ -0,0 +1,49 @@
+/**
+ * @file tracedump.c
+ * @brief Renders a binary parser trace as the parser_output.txt text log.
+ *
+ * The parser saves its trace when PARSER_TRACE_FILE is set:
+ *   PARSER_TRACE_FILE=run.trace ./stage1exe testcase1.txt out.txt
+ * and this tool turns it back into the text the parser used to write:
+ *   ./tools/tracedump run.trace parser_output.txt
+ *
+ * Usage: tracedump <trace file> [output file]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../trace.h"
+#include "../grammarDef.h"
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "Usage: %s <trace file> [output file]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    TraceBuffer B;
+    char **lexemes = NULL;
+    uint32_t lexemeCount = 0;
+    if (!loadTrace(&B, GRAMMAR_SIZE, &lexemes, &lexemeCount, argv[1]))
+        return EXIT_FAILURE;
+
+    FILE *out = stdout;
+    if (argc > 2 && (out = fopen(argv[2], "w")) == NULL)
+    {
+        perror(argv[2]);
+        return EXIT_FAILURE;
+    }
+
+    struct grammar rules = {grammarRules};
+    renderTrace(&B, &rules, (const char *const *)lexemes, out);
+    if (out != stdout)
+        fclose(out);
+
+    for (uint32_t id = 0; id < lexemeCount; id++)
+        free(lexemes[id]);
+    free(lexemes);
+    traceFree(&B);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,391 @@
+/**
+ * @file trace.c
+ * @brief Parser trace: binary event ring buffer and its text rendering.
+ *
+ * parseToken() records one 12-byte TraceEvent per line it used to fprintf
+ * to parser_output.txt. Nothing is formatted while the ring has room; the
+ * text log is rendered from the buffer once the parse is over, or offline
+ * from a saved trace with tools/tracedump. When the ring fills up, its
+ * events are rendered to the spill stream if one is set, and the ring
+ * doubles otherwise, so the log is never cut short on large inputs.
+ *
+ * The level comes from the PARSER_TRACE environment variable ("off",
+ * "errors", "actions" or "full", the default) and the ring size from
+ * PARSER_TRACE_EVENTS. PARSER_TRACE_FILE names a file to save the raw
+ * trace to.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "trace.h"
+
+#define TRACE_MAGIC "PTRC"
+#define TRACE_VERSION 1u
+
+/**
+ * @brief Sets the trace level from the environment and allocates the ring.
+ *
+ * @param B The buffer to initialize.
+ */
+void traceInit(TraceBuffer *B);
+
+/**
+ * @brief Discards the recorded events, keeping the level and the ring.
+ *
+ * @param B The buffer.
+ */
+void traceReset(TraceBuffer *B);
+
+/**
+ * @brief Frees the ring of a buffer.
+ *
+ * @param B The buffer.
+ */
+void traceFree(TraceBuffer *B);
+
+/**
+ * @brief Sets the stream a full ring is rendered to, instead of growing it.
+ *
+ * @param B The buffer.
+ * @param G The grammar the production indices refer to.
+ * @param P The pool the lexeme handles in the events come from.
+ * @param out The stream, or NULL to grow the ring when it is full.
+ */
+void traceSpillTo(TraceBuffer *B, grammar G, const InternPool *P, FILE *out);
+
+/**
+ * @brief Frees a slot in a full ring, by spilling its events or by doubling it.
+ *
+ * Only a ring of TRACE_MAX_EVENTS with no spill stream overwrites its
+ * oldest event, which is then counted as dropped.
+ *
+ * @param B The buffer, whose ring is full.
+ */
+void traceMakeRoom(TraceBuffer *B);
+
+/**
+ * @brief Writes the events of a buffer in the parser_output.txt text format.
+ *
+ * @param B The buffer.
+ * @param G The grammar the production indices refer to.
+ * @param lexemes Lexeme handle -> text.
+ * @param out Where to write the text.
+ */
+void renderTrace(const TraceBuffer *B, grammar G, const char *const *lexemes, FILE *out);
+
+/**
+ * @brief Saves the events and the lexeme table to a binary trace file.
+ *
+ * @param B The buffer.
+ * @param P The pool the lexeme handles in the events come from.
+ * @param path The file to write.
+ * @return int 1 on success, 0 if the file could not be written.
+ */
+int saveTrace(const TraceBuffer *B, const InternPool *P, const char *path);
+
+/**
+ * @brief Loads a trace written by saveTrace().
+ *
+ * Every event is checked against the file and the grammar before it is
+ * accepted, so renderTrace() can index its tables without bounds checks.
+ *
+ * @param B Filled with the events; release with traceFree().
+ * @param ruleCount Number of productions of the grammar the trace is rendered with.
+ * @param lexemes Set to a malloc'd handle -> text table.
+ * @param lexemeCount Set to the number of entries in the table.
+ * @param path The file to read.
+ * @return int 1 on success, 0 if the file is missing or malformed.
+ */
+int loadTrace(TraceBuffer *B, uint32_t ruleCount, char ***lexemes, uint32_t *lexemeCount, const char *path);
+
+static TraceLevel parseTraceLevel(const char *s)
+{
+    if (!s || strcmp(s, "full") == 0)
+        return TRACE_FULL;
+    if (strcmp(s, "off") == 0)
+        return TRACE_OFF;
+    if (strcmp(s, "errors") == 0)
+        return TRACE_ERRORS;
+    if (strcmp(s, "actions") == 0)
+        return TRACE_ACTIONS;
+    fprintf(stderr, "Unknown PARSER_TRACE level \"%s\", using full\n", s);
+    return TRACE_FULL;
+}
+
+static void allocateRing(TraceBuffer *B, uint64_t events)
+{
+    uint32_t capacity = 1;
+    while (capacity < events && capacity < TRACE_MAX_EVENTS)
+        capacity <<= 1;
+    B->events = (TraceEvent *)malloc((size_t)capacity * sizeof(TraceEvent));
+    if (!B->events)
+    {
+        fprintf(stderr, "Memory allocation failed in allocateRing\n");
+        exit(EXIT_FAILURE);
+    }
+    B->mask = capacity - 1;
+}
+
+void traceInit(TraceBuffer *B)
+{
+    B->events = NULL;
+    B->mask = 0;
+    traceReset(B);
+    traceSpillTo(B, NULL, NULL, NULL);
+    B->level = parseTraceLevel(getenv("PARSER_TRACE"));
+    if (B->level > PARSER_TRACE_MAX)
+        B->level = PARSER_TRACE_MAX;
+    if (B->level == TRACE_OFF)
+        return;
+
+    uint64_t events = TRACE_DEFAULT_EVENTS;
+    const char *size = getenv("PARSER_TRACE_EVENTS");
+    if (size && strtoull(size, NULL, 10) > 0)
+        events = strtoull(size, NULL, 10);
+    allocateRing(B, events);
+}
+
+void traceReset(TraceBuffer *B)
+{
+    B->first = 0;
+    B->total = 0;
+    B->spilled = 0;
+    B->dropped = 0;
+}
+
+void traceFree(TraceBuffer *B)
+{
+    free(B->events);
+    B->events = NULL;
+    traceReset(B);
+    traceSpillTo(B, NULL, NULL, NULL);
+    B->level = TRACE_OFF;
+}
+
+void traceSpillTo(TraceBuffer *B, grammar G, const InternPool *P, FILE *out)
+{
+    B->spill = out;
+    B->spillGrammar = G;
+    B->spillPool = P;
+}
+
+static void renderEvent(const TraceEvent *e, grammar G, const char *const *lexemes, FILE *out)
+{
+    const char *token = getTokenStr((TokenType)e->token);
+    const char *lexeme = lexemes[e->lexeme];
+    const char *symbol = e->symbol < TERMS_SIZE ? grammarTerms[e->symbol] : "?";
+
+    switch ((TraceEventKind)e->kind)
+    {
+    case TRACE_LEX_FUNID_LENGTH:
+        fprintf(out, "[Lexcial Error] Line no. %d Error: Function Identifier is longer than the prescribed length\n\n", e->lineNo);
+        break;
+    case TRACE_LEX_ID_LENGTH:
+        fprintf(out, "[Lexcial Error] Line no. %d Error: Variable Identifier is longer than the prescribed length \n\n", e->lineNo);
+        break;
+    case TRACE_LEX_UNKNOWN:
+        fprintf(out, "[Lexcial Error] Line no. %d Error: Unknown pattern <%s> \n\n", e->lineNo, lexeme);
+        break;
+    case TRACE_STACK_TOP:
+        fprintf(out, "Top of Stack --> %s  Current input pointer -->%s\n", symbol, token);
+        break;
+    case TRACE_MATCH:
+        fprintf(out, "Terminal at top of stack matched with Terminal at current input pointer\n\n");
+        break;
+    case TRACE_MISMATCH_ERROR:
+        fprintf(out, "[Parser Error] Line %d Error: The token %s for lexeme %s does not match with the expected token %s\n", e->lineNo, token, lexeme, symbol);
+        break;
+    case TRACE_POP_TERMINAL:
+        fprintf(out, "The terminal at top of stack doesnt match with terminal at current input pointer so the terminal at top of stack is popped out \n\n");
+        break;
+    case TRACE_NO_RULE:
+        fprintf(out, "no rule found\n");
+        break;
+    case TRACE_NO_RULE_ERROR:
+        fprintf(out, "[Parser Error] Line %d Error: Invalid token %s encountered with the value %s stack top %s\n\n", e->lineNo, token, lexeme, symbol);
+        break;
+    case TRACE_SYNC:
+        fprintf(out, "Syn rule found\n");
+        break;
+    case TRACE_SYNC_ERROR:
+        fprintf(out, "[Parser Error] Line %d Error: Invalid token %s encountered with the value %s stack top %s\n", e->lineNo, token, lexeme, symbol);
+        break;
+    case TRACE_POP_NONTERMINAL:
+        fprintf(out, "Non Terminal at the top of Stack is popped out\n\n");
+        break;
+    case TRACE_RULE:
+    {
+        const int *rule = G->rules[e->symbol];
+        fprintf(out, "%s==>", grammarTerms[rule[0]]);
+        for (int i = 1; i < PRODUCTION_WIDTH; i++)
+        {
+            if (rule[i] == -1)
+            {
+                fprintf(out, "\n");
+                break;
+            }
+            fprintf(out, "%s   ", grammarTerms[rule[i]]);
+        }
+        fprintf(out, "\n");
+        break;
+    }
+    }
+}
+
+void renderTrace(const TraceBuffer *B, grammar G, const char *const *lexemes, FILE *out)
+{
+    if (B->dropped > 0)
+        fprintf(out, "[Trace] %llu earlier events were dropped\n\n", (unsigned long long)B->dropped);
+
+    for (uint64_t i = B->first; i < B->total; i++)
+        renderEvent(&B->events[i & B->mask], G, lexemes, out);
+}
+
+void traceMakeRoom(TraceBuffer *B)
+{
+    if (B->spill)
+    {
+        for (uint64_t i = B->first; i < B->total; i++)
+            renderEvent(&B->events[i & B->mask], B->spillGrammar, B->spillPool->text, B->spill);
+        B->spilled += B->total - B->first;
+        B->first = B->total;
+        return;
+    }
+    if (B->mask < TRACE_MAX_EVENTS - 1)
+    {
+        // Events whose slot moves to the new upper half are copied there
+        uint32_t mask = B->mask * 2 + 1;
+        TraceEvent *events = (TraceEvent *)realloc(B->events, ((size_t)mask + 1) * sizeof(TraceEvent));
+        if (!events)
+        {
+            fprintf(stderr, "Memory allocation failed in traceMakeRoom\n");
+            exit(EXIT_FAILURE);
+        }
+        for (uint64_t i = B->first; i < B->total; i++)
+            if ((i & mask) != (i & B->mask))
+                events[i & mask] = events[i & B->mask];
+        B->events = events;
+        B->mask = mask;
+        return;
+    }
+    B->first++;
+    B->dropped++;
+}
+
+int saveTrace(const TraceBuffer *B, const InternPool *P, const char *path)
+{
+    FILE *fp = fopen(path, "wb");
+    if (!fp)
+    {
+        perror(path);
+        return 0;
+    }
+
+    uint64_t count = B->events ? B->total - B->first : 0;
+    uint64_t dropped = B->dropped + B->spilled;
+    uint32_t version = TRACE_VERSION;
+    uint32_t level = (uint32_t)B->level;
+    fwrite(TRACE_MAGIC, 1, 4, fp);
+    fwrite(&version, sizeof(version), 1, fp);
+    fwrite(&level, sizeof(level), 1, fp);
+    fwrite(&dropped, sizeof(dropped), 1, fp);
+    fwrite(&count, sizeof(count), 1, fp);
+    for (uint64_t i = B->total - count; i < B->total; i++)
+        fwrite(&B->events[i & B->mask], sizeof(TraceEvent), 1, fp);
+
+    fwrite(&P->count, sizeof(P->count), 1, fp);
+    for (uint32_t id = 0; id < P->count; id++)
+    {
+        fwrite(&P->length[id], sizeof(P->length[id]), 1, fp);
+        fwrite(P->text[id], 1, P->length[id], fp);
+    }
+    return fclose(fp) == 0;
+}
+
+int loadTrace(TraceBuffer *B, uint32_t ruleCount, char ***lexemes, uint32_t *lexemeCount, const char *path)
+{
+    FILE *fp = fopen(path, "rb");
+    if (!fp)
+    {
+        perror(path);
+        return 0;
+    }
+
+    char magic[4];
+    uint32_t version, level, nLexemes;
+    uint64_t dropped, count;
+    if (fread(magic, 1, 4, fp) != 4 || memcmp(magic, TRACE_MAGIC, 4) != 0 ||
+        fread(&version, sizeof(version), 1, fp) != 1 || version != TRACE_VERSION ||
+        fread(&level, sizeof(level), 1, fp) != 1 || fread(&dropped, sizeof(dropped), 1, fp) != 1 ||
+        fread(&count, sizeof(count), 1, fp) != 1)
+    {
+        fprintf(stderr, "%s: not a parser trace\n", path);
+        fclose(fp);
+        return 0;
+    }
+
+    // The events must fit in a ring and in what is left of the file
+    long start = ftell(fp);
+    if (start < 0 || fseek(fp, 0, SEEK_END) != 0)
+    {
+        perror(path);
+        fclose(fp);
+        return 0;
+    }
+    long end = ftell(fp);
+    fseek(fp, start, SEEK_SET);
+    if (count > TRACE_MAX_EVENTS || end < start || count > (uint64_t)(end - start) / sizeof(TraceEvent))
+    {
+        fprintf(stderr, "%s: trace claims %llu events, more than the file holds\n", path, (unsigned long long)count);
+        fclose(fp);
+        return 0;
+    }
+
+    allocateRing(B, count);
+    traceReset(B);
+    traceSpillTo(B, NULL, NULL, NULL);
+    B->level = (TraceLevel)level;
+    B->dropped = dropped;
+    B->total = count;
+    if (fread(B->events, sizeof(TraceEvent), count, fp) != count || fread(&nLexemes, sizeof(nLexemes), 1, fp) != 1)
+    {
+        fprintf(stderr, "%s: truncated trace\n", path);
+        fclose(fp);
+        return 0;
+    }
+
+    char **text = (char **)calloc(nLexemes ? nLexemes : 1, sizeof(char *));
+    if (!text)
+    {
+        fprintf(stderr, "Memory allocation failed in loadTrace\n");
+        exit(EXIT_FAILURE);
+    }
+    for (uint32_t id = 0; id < nLexemes; id++)
+    {
+        uint32_t len;
+        if (fread(&len, sizeof(len), 1, fp) != 1 || !(text[id] = (char *)malloc((size_t)len + 1)) ||
+            fread(text[id], 1, len, fp) != len)
+        {
+            fprintf(stderr, "%s: truncated trace\n", path);
+            fclose(fp);
+            return 0;
+        }
+        text[id][len] = '\0';
+    }
+    fclose(fp);
+
+    // Events must not refer to lexemes, tokens, symbols or productions that do not exist
+    for (uint64_t i = 0; i < count; i++)
+    {
+        const TraceEvent *e = &B->events[i];
+        uint32_t symbols = e->kind == TRACE_RULE ? ruleCount : TERMS_SIZE;
+        if (e->kind > TRACE_RULE || e->token > TK_ERR || e->symbol >= symbols || e->lexeme >= nLexemes)
+        {
+            fprintf(stderr, "%s: event %llu is malformed\n", path, (unsigned long long)i);
+            return 0;
+        }
+    }
+    *lexemes = text;
+    *lexemeCount = nLexemes;
+    return 1;
+}
@@ -0,0 +1,129 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include "lexer.h"
+#include "parserDef.h"
+
+/*-------------------
+   Trace Levels
+  -------------------*/
+typedef enum
+{
+  TRACE_OFF,     // record nothing, parser_output.txt is not written
+  TRACE_ERRORS,  // lexical and syntax errors
+  TRACE_ACTIONS, // + matches, pops and applied productions
+  TRACE_FULL     // + the stack top / input pair of every step
+} TraceLevel;
+
+/* Levels above this are compiled out, e.g. CFLAGS="-O2 -DPARSER_TRACE_MAX=0" */
+#ifndef PARSER_TRACE_MAX
+#define PARSER_TRACE_MAX TRACE_FULL
+#endif
+
+#define TRACE_DEFAULT_EVENTS (1u << 20) // Ring size unless PARSER_TRACE_EVENTS says otherwise
+#define TRACE_MAX_EVENTS (1u << 31)     // Largest ring, 24 GB of events
+
+/*-------------------
+   Trace Events
+  -------------------*/
+/* One kind per line format of parser_output.txt */
+typedef enum
+{
+  TRACE_LEX_FUNID_LENGTH,
+  TRACE_LEX_ID_LENGTH,
+  TRACE_LEX_UNKNOWN,
+  TRACE_STACK_TOP,
+  TRACE_MATCH,
+  TRACE_MISMATCH_ERROR,
+  TRACE_POP_TERMINAL,
+  TRACE_NO_RULE,
+  TRACE_NO_RULE_ERROR,
+  TRACE_SYNC,
+  TRACE_SYNC_ERROR,
+  TRACE_POP_NONTERMINAL,
+  TRACE_RULE
+} TraceEventKind;
+
+/* 12-byte record: the token being parsed plus a grammar symbol or production */
+typedef struct
+{
+  uint8_t kind;     // TraceEventKind
+  uint8_t token;    // TokenType of the current input token
+  uint16_t symbol;  // Stack top symbol, or production index for TRACE_RULE
+  LexemeId lexeme;  // Lexeme of the current input token
+  int32_t lineNo;   // Line of the current input token
+} TraceEvent;
+
+/*
+ * Ring buffer of events. Once full, the oldest events are rendered to the
+ * spill stream if one is set, otherwise the ring doubles, so no event is
+ * lost short of TRACE_MAX_EVENTS.
+ */
+typedef struct
+{
+  TraceEvent *events;
+  uint32_t mask;      // capacity - 1, capacity is a power of two
+  uint64_t first;     // Oldest event still in the ring
+  uint64_t total;     // Events recorded since the last reset
+  uint64_t spilled;   // Events already rendered to spill
+  uint64_t dropped;   // Events lost, neither in the ring nor spilled
+  TraceLevel level;
+  FILE *spill;             // Where full rings are rendered, or NULL
+  grammar spillGrammar;    // Grammar and lexemes spilled events are rendered with
+  const InternPool *spillPool;
+} TraceBuffer;
+
+/*-------------------
+   Function Prototypes
+  -------------------*/
+void traceInit(TraceBuffer *B);
+void traceReset(TraceBuffer *B);
+void traceFree(TraceBuffer *B);
+void traceSpillTo(TraceBuffer *B, grammar G, const InternPool *P, FILE *out);
+void traceMakeRoom(TraceBuffer *B);
+void renderTrace(const TraceBuffer *B, grammar G, const char *const *lexemes, FILE *out);
+int saveTrace(const TraceBuffer *B, const InternPool *P, const char *path);
+int loadTrace(TraceBuffer *B, uint32_t ruleCount, char ***lexemes, uint32_t *lexemeCount, const char *path);
+
+static inline TraceLevel traceKindLevel(TraceEventKind kind)
+{
+  switch (kind)
+  {
+  case TRACE_STACK_TOP:
+    return TRACE_FULL;
+  case TRACE_MATCH:
+  case TRACE_POP_TERMINAL:
+  case TRACE_NO_RULE:
+  case TRACE_SYNC:
+  case TRACE_POP_NONTERMINAL:
+  case TRACE_RULE:
+    return TRACE_ACTIONS;
+  default:
+    return TRACE_ERRORS;
+  }
+}
+
+static inline void traceRecord(TraceBuffer *B, TraceEventKind kind, const Token *ts, int symbol)
+{
+  if (B->total - B->first > B->mask)
+    traceMakeRoom(B);
+  TraceEvent *e = &B->events[B->total & B->mask];
+  e->kind = (uint8_t)kind;
+  e->token = (uint8_t)ts->type;
+  e->symbol = (uint16_t)symbol;
+  e->lexeme = ts->lexeme;
+  e->lineNo = ts->lineNo;
+  B->total++;
+}
+
+/* Records an event if its level is compiled in and enabled; I/O only when a spilling ring is full */
+#define TRACE(B, kind, ts, symbol)                                                      \
+  do                                                                                    \
+  {                                                                                     \
+    if (traceKindLevel(kind) <= PARSER_TRACE_MAX && traceKindLevel(kind) <= (B)->level) \
+      traceRecord((B), (kind), (ts), (symbol));                                         \
+  } while (0)
+
+#endif /* TRACE_H */
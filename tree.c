@@ -10,85 +10,238 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "tree.h"
 
+#define TREE_INITIAL_NODES 1024  ///< Initial node capacity of a tree
+#define TREE_INITIAL_TOKENS 256  ///< Initial token capacity of a tree
+
+/**
+ * @brief Creates an empty parse tree.
+ *
+ * A parse fills one tree; every node is carved from its node array and
+ * destroyParseTree() releases the whole tree at once.
+ *
+ * @return A pointer to the tree.
+ */
+ParseTree* createParseTree();
+
+/**
+ * @brief Destroys a parse tree with all of its nodes and tokens.
+ *
+ * @param tree The tree.
+ */
+void destroyParseTree(ParseTree* tree);
+
 /**
- * @brief Creates a new syntax tree node.
+ * @brief Appends a run of sibling nodes to a tree.
+ *
+ * The nodes are contiguous and zero-initialized apart from the links. Node
+ * pointers taken before the call may be invalidated; indices stay valid.
  *
- * This function allocates memory for a new TreeNode and initializes its fields.
+ * @param tree The tree.
+ * @param count Number of nodes.
+ * @param parent Index of their parent, TREE_NO_NODE for the root.
+ * @return uint32_t Index of the first new node.
+ */
+uint32_t addTreeNodes(ParseTree* tree, int count, uint32_t parent);
+
+/**
+ * @brief Records an input token matched by a terminal node.
  *
- * @return A pointer to the newly created TreeNode.
+ * @param tree The tree.
+ * @param lexeme The token's lexeme.
+ * @param lineNo The token's line number.
+ * @return uint32_t Index of the token, to be stored in TreeNode.token.
  */
-TreeNode* createNode();
+uint32_t addTreeToken(ParseTree* tree, LexemeId lexeme, int lineNo);
 
 /**
- * @brief Sets a child node for a given parent node at a specified index.
+ * @brief Drops the nodes that can no longer be reached from the root.
  *
- * This function assigns a child node to a parent node at the specified index.
- * It also sets the parent pointer of the child node to the parent node.
+ * Reparsing part of a tree leaves the replaced subtree behind in the node
+ * array. The reachable nodes are copied breadth first into a new array, so
+ * every run of children stays contiguous; node indices change, token indices
+ * do not.
  *
- * @param parent The parent TreeNode.
- * @param index The index at which to set the child node.
- * @param child The child TreeNode to be set.
+ * @param tree The tree.
+ * @return uint32_t The number of nodes left.
  */
-void setChild(TreeNode* parent, int index, TreeNode* child);
+uint32_t compactParseTree(ParseTree* tree);
 
 /**
- * @brief Frees the memory allocated for a syntax tree.
+ * @brief Keeps only the given nodes and their subtrees, renumbering them from 0.
  *
- * This function recursively frees the memory allocated for a syntax tree,
- * starting from the given root node.
+ * This lets a parse that prints its tree as it goes drop what it has printed.
+ * An entry of keep names a node, and its whole subtree is kept too unless the
+ * entry has TREE_KEEP_NODE set. Then the node keeps its numChildren but
+ * loses its children. Every run of children stays contiguous. keep and refs
+ * are rewritten with the new indices, and every node in refs must be kept.
+ * A kept node whose parent is dropped gets TREE_NO_NODE as its parent. Tokens
+ * of dropped nodes are dropped too, and the arrays shrink to fit what is left.
  *
- * @param root The root TreeNode of the syntax tree to be freed.
+ * @param tree The tree.
+ * @param keep Nodes to keep, each in at most one kept subtree.
+ * @param keepCount Number of entries in keep.
+ * @param refs Other node indices to rewrite.
+ * @param refCount Number of entries in refs.
+ * @return uint32_t The number of nodes left.
  */
-void freeSyntaxTree(TreeNode* root);
+uint32_t retainTreeNodes(ParseTree* tree, uint32_t* keep, uint32_t keepCount, uint32_t* refs, uint32_t refCount);
 
 
-TreeNode* createNode() {
-   TreeNode* node = (TreeNode*) malloc(sizeof(TreeNode));
-    if (!node) {
-        fprintf(stderr, "Error: Memory allocation failed for terminal node.\n");
+ParseTree* createParseTree() {
+    ParseTree* tree = (ParseTree*) malloc(sizeof(ParseTree));
+    if (!tree) {
+        fprintf(stderr, "Error: Memory allocation failed for parse tree.\n");
         exit(EXIT_FAILURE);
     }
-    node->children=NULL;
-    node->numChildren=0;
-    node->isNonTerminal=false;
-    node->isTerminal=false;
-    node->parent=NULL;
-    node->symbolID=-1;
-    strcpy(node->lexeme, "");
-    node->lineno=0;
-    return node;
+    tree->nodeCapacity = TREE_INITIAL_NODES;
+    tree->nodeCount = 0;
+    tree->nodes = (TreeNode*) malloc(tree->nodeCapacity * sizeof(TreeNode));
+    tree->tokenCapacity = TREE_INITIAL_TOKENS;
+    tree->tokenCount = 0;
+    tree->tokens = (TreeToken*) malloc(tree->tokenCapacity * sizeof(TreeToken));
+    if (!tree->nodes || !tree->tokens) {
+        fprintf(stderr, "Error: Memory allocation failed for parse tree.\n");
+        exit(EXIT_FAILURE);
+    }
+    return tree;
 }
 
-void setChild(TreeNode* parent, int index, TreeNode* child) {
-    if (!parent || parent->isTerminal==true) {
-        fprintf(stderr, "setChild Error: Provided parent is NULL or not a nonterminal.\n");
-        return;
-    }
-    if (index < 0 || index >= parent->numChildren) {
-        fprintf(stderr, "setChild Error: Index %d out of bounds (max %d).\n", index, parent->numChildren);
-        return;
+void destroyParseTree(ParseTree* tree) {
+    if (!tree) return;
+    free(tree->nodes);
+    free(tree->tokens);
+    free(tree);
+}
+
+uint32_t addTreeNodes(ParseTree* tree, int count, uint32_t parent) {
+    if (tree->nodeCapacity - tree->nodeCount < (uint32_t) count) {
+        uint32_t capacity = tree->nodeCapacity * 2;
+        TreeNode* nodes = (TreeNode*) realloc(tree->nodes, capacity * sizeof(TreeNode));
+        if (!nodes || capacity < tree->nodeCapacity) {
+            fprintf(stderr, "Error: Memory allocation failed for tree nodes.\n");
+            exit(EXIT_FAILURE);
+        }
+        tree->nodes = nodes;
+        tree->nodeCapacity = capacity;
     }
-    parent->children[index] = child;
-    if (child) {
-        child->parent = parent;
+    uint32_t first = tree->nodeCount;
+    for (int i = 0; i < count; i++) {
+        TreeNode* node = &tree->nodes[first + i];
+        node->symbolID = 0;
+        node->numChildren = 0;
+        node->isTerminal = false;
+        node->firstChild = TREE_NO_NODE;
+        node->parent = parent;
+        node->token = TREE_NO_TOKEN;
     }
+    tree->nodeCount += count;
+    return first;
 }
 
-void freeSyntaxTree(TreeNode* root) {
-    if (!root) return;
-    
-    if (root->isNonTerminal) {
-        
-        for (int i = 0; i < root->numChildren; i++) {
-            freeSyntaxTree(root->children[i]);
+uint32_t addTreeToken(ParseTree* tree, LexemeId lexeme, int lineNo) {
+    if (tree->tokenCount == tree->tokenCapacity) {
+        uint32_t capacity = tree->tokenCapacity * 2;
+        TreeToken* tokens = (TreeToken*) realloc(tree->tokens, capacity * sizeof(TreeToken));
+        if (!tokens) {
+            fprintf(stderr, "Error: Memory allocation failed for tree tokens.\n");
+            exit(EXIT_FAILURE);
         }
-        free(root->children);
+        tree->tokens = tokens;
+        tree->tokenCapacity = capacity;
     }
-    free(root);
+    tree->tokens[tree->tokenCount].lexeme = lexeme;
+    tree->tokens[tree->tokenCount].lineNo = lineNo;
+    return tree->tokenCount++;
 }
 
+uint32_t compactParseTree(ParseTree* tree) {
+    if (tree->nodeCount == 0) return 0;
+    TreeNode* nodes = (TreeNode*) malloc(tree->nodeCapacity * sizeof(TreeNode));
+    if (!nodes) {
+        fprintf(stderr, "Error: Memory allocation failed for tree nodes.\n");
+        exit(EXIT_FAILURE);
+    }
+    nodes[0] = tree->nodes[0];
+    uint32_t count = 1;
+    // Children are copied while their firstChild still refers to the old array
+    for (uint32_t i = 0; i < count; i++) {
+        TreeNode* node = &nodes[i];
+        if (node->numChildren == 0) continue;
+        memcpy(&nodes[count], &tree->nodes[node->firstChild], node->numChildren * sizeof(TreeNode));
+        for (int c = 0; c < node->numChildren; c++)
+            nodes[count + c].parent = i;
+        node->firstChild = count;
+        count += node->numChildren;
+    }
+    free(tree->nodes);
+    tree->nodes = nodes;
+    tree->nodeCount = count;
+    return count;
+}
+
+uint32_t retainTreeNodes(ParseTree* tree, uint32_t* keep, uint32_t keepCount, uint32_t* refs, uint32_t refCount) {
+    uint32_t* newIndex = (uint32_t*) malloc((tree->nodeCount + 1) * sizeof(uint32_t));
+    TreeNode* nodes = (TreeNode*) malloc((tree->nodeCount + 1) * sizeof(TreeNode));
+    TreeToken* tokens = (TreeToken*) malloc((tree->tokenCount + 1) * sizeof(TreeToken));
+    if (!newIndex || !nodes || !tokens) {
+        fprintf(stderr, "Error: Memory allocation failed for tree nodes.\n");
+        exit(EXIT_FAILURE);
+    }
+    memset(newIndex, 0xff, tree->nodeCount * sizeof(uint32_t));
 
+    uint32_t count = 0;
+    for (uint32_t k = 0; k < keepCount; k++) {
+        uint32_t old = keep[k] & ~TREE_KEEP_NODE;
+        nodes[count] = tree->nodes[old];
+        newIndex[old] = count;
+        keep[k] = count++ | (keep[k] & TREE_KEEP_NODE);
+    }
+    // Subtrees are copied breadth first while their firstChild still refers to the old array
+    for (uint32_t i = 0; i < count; i++) {
+        TreeNode* node = &nodes[i];
+        if (i < keepCount && (keep[i] & TREE_KEEP_NODE)) {
+            node->firstChild = TREE_NO_NODE;
+            continue;
+        }
+        if (node->numChildren == 0) continue;
+        uint32_t first = node->firstChild;
+        memcpy(&nodes[count], &tree->nodes[first], node->numChildren * sizeof(TreeNode));
+        for (int c = 0; c < node->numChildren; c++) {
+            newIndex[first + c] = count + c;
+            nodes[count + c].parent = i;
+        }
+        node->firstChild = count;
+        count += node->numChildren;
+    }
 
+    uint32_t tokenCount = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (i < keepCount && nodes[i].parent != TREE_NO_NODE)
+            nodes[i].parent = newIndex[nodes[i].parent];
+        if (nodes[i].token != TREE_NO_TOKEN) {
+            tokens[tokenCount] = tree->tokens[nodes[i].token];
+            nodes[i].token = tokenCount++;
+        }
+    }
+    for (uint32_t r = 0; r < refCount; r++)
+        refs[r] = newIndex[refs[r]];
+    free(newIndex);
+    free(tree->nodes);
+    free(tree->tokens);
 
+    // Room to grow, as after createParseTree()
+    tree->nodeCapacity = count * 2 > TREE_INITIAL_NODES ? count * 2 : TREE_INITIAL_NODES;
+    tree->tokenCapacity = tokenCount * 2 > TREE_INITIAL_TOKENS ? tokenCount * 2 : TREE_INITIAL_TOKENS;
+    tree->nodes = (TreeNode*) realloc(nodes, tree->nodeCapacity * sizeof(TreeNode));
+    tree->tokens = (TreeToken*) realloc(tokens, tree->tokenCapacity * sizeof(TreeToken));
+    if (!tree->nodes || !tree->tokens) {
+        fprintf(stderr, "Error: Memory allocation failed for tree nodes.\n");
+        exit(EXIT_FAILURE);
+    }
+    tree->nodeCount = count;
+    tree->tokenCount = tokenCount;
+    return count;
+}
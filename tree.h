@@ -1,32 +1,66 @@
-
-
-
 #ifndef COMPILER_TREE_H
 #define COMPILER_TREE_H
 
 #include <stdbool.h>
+#include <stdint.h>
 #include "lexer.h" 
 #include "parser.h"
 
+#define TREE_NO_NODE UINT32_MAX   // parent of the root, firstChild of a leaf
+#define TREE_NO_TOKEN UINT32_MAX  // token of a node that matched no input
+#define TREE_KEEP_NODE (1u << 31) // retainTreeNodes() entry: keep the node but not its subtree
+
 typedef struct TreeNode TreeNode;
 
+/*
+ * One parse-tree node, 16 bytes. Nodes live in ParseTree.nodes and refer to
+ * each other by index; the children of a node are stored contiguously,
+ * left to right, starting at firstChild.
+ */
 struct TreeNode {
 
+    uint16_t symbolID;     // Grammar symbol
+    uint8_t numChildren;   // 0 for leaves (at most 8 with PRODUCTION_WIDTH 10)
     bool isTerminal;
-    bool isNonTerminal;  
-    TreeNode* parent;
-    TreeNode** children;
-    int numChildren;
-    int symbolID;    
-    char lexeme[512]; 
-    int lineno;   
+    uint32_t firstChild;   // Index of the first child, TREE_NO_NODE for leaves
+    uint32_t parent;       // Index of the parent, TREE_NO_NODE for the root
+    uint32_t token;        // Index into ParseTree.tokens, TREE_NO_TOKEN if none
   
 };
 
-TreeNode* createNode();
+_Static_assert(sizeof(TreeNode) == 16, "TreeNode is expected to stay 16 bytes");
+
+/* Input token matched by a terminal node */
+typedef struct {
+    LexemeId lexeme;
+    int lineNo;
+} TreeToken;
+
+/*
+ * Storage of one parse tree. Nodes are handed out by bumping nodeCount, so
+ * a node's children are one contiguous run, and destroyParseTree() releases
+ * the whole tree at once. nodes[0] is the root.
+ *
+ * This takes the place of the block-chained TreeArena of pointer-linked
+ * nodes: one growable array keeps the single-call release, drops the
+ * per-node child pointer arrays, and its indices stay valid across realloc
+ * and compaction, which pointers into arena blocks could not.
+ */
+typedef struct ParseTree {
+    TreeNode *nodes;
+    uint32_t nodeCount;
+    uint32_t nodeCapacity;
+    TreeToken *tokens;
+    uint32_t tokenCount;
+    uint32_t tokenCapacity;
+} ParseTree;
 
-void setChild(TreeNode* parent, int index,TreeNode* child);
+ParseTree* createParseTree();
+void destroyParseTree(ParseTree* tree);
 
-void freeSyntaxTree(TreeNode* root);
+uint32_t addTreeNodes(ParseTree* tree, int count, uint32_t parent);
+uint32_t addTreeToken(ParseTree* tree, LexemeId lexeme, int lineNo);
+uint32_t compactParseTree(ParseTree* tree);
+uint32_t retainTreeNodes(ParseTree* tree, uint32_t* keep, uint32_t keepCount, uint32_t* refs, uint32_t refCount);
 
 #endif /* COMPILER_TREE_H */